@@ -0,0 +1,101 @@
+#include "alert_intake.h"
+#include <chrono>
+#include <stdexcept>
+
+// Upper bound on how long a submitted alert waits for the drainer when
+// its wake-up is missed
+const int INTAKE_DRAIN_INTERVAL_MS = 5;
+
+AlertIntake::AlertIntake(PriorityQueue& queue, bool background)
+    : head(new Node()), pending(0), queue(queue), stopDraining(false) {
+    tail.store(head);
+    if (background) {
+        drainThread = std::thread(&AlertIntake::drainLoop, this);
+    }
+}
+
+AlertIntake::~AlertIntake() {
+    {
+        std::lock_guard<std::mutex> lock(signalMutex);
+        stopDraining = true;
+    }
+    drainSignal.notify_all();
+    if (drainThread.joinable()) {
+        drainThread.join();
+    }
+    
+    drain();
+    delete head;
+}
+
+void AlertIntake::submit(const Alert& alert) {
+    Node* node = new Node();
+    node->alert = alert;
+    
+    Node* previous = tail.exchange(node, std::memory_order_acq_rel);
+    previous->next.store(node, std::memory_order_release);
+    
+    // Only the first alert into an empty intake wakes the drainer; the
+    // rest are picked up in the same batch
+    if (pending.fetch_add(1, std::memory_order_relaxed) == 0) {
+        drainSignal.notify_one();
+    }
+}
+
+// Called with consumerMutex held. Drains up to the tail as of entry, so
+// every submit() that returned before the call is included. A producer
+// that has swapped the tail but not yet linked its node is waited out:
+// it is between two adjacent instructions, and stopping there would hide
+// later nodes already linked behind it.
+int AlertIntake::drainLocked() {
+    std::vector<Alert> batch;
+    Node* last = tail.load(std::memory_order_acquire);
+    while (head != last) {
+        Node* next = head->next.load(std::memory_order_acquire);
+        if (!next) {
+            std::this_thread::yield();
+            continue;
+        }
+        batch.push_back(std::move(next->alert));
+        delete head;
+        head = next;
+    }
+    
+    if (!batch.empty()) {
+        pending.fetch_sub(batch.size(), std::memory_order_relaxed);
+        queue.insertBatch(batch);
+    }
+    return batch.size();
+}
+
+int AlertIntake::drain() {
+    std::lock_guard<std::mutex> lock(consumerMutex);
+    return drainLocked();
+}
+
+PriorityQueue& AlertIntake::settled() {
+    drain();
+    return queue;
+}
+
+bool AlertIntake::peekMin(Alert& alert) {
+    std::lock_guard<std::mutex> lock(consumerMutex);
+    drainLocked();
+    try {
+        alert = queue.peekMin();
+    } catch (const std::runtime_error&) {
+        return false;
+    }
+    return true;
+}
+
+void AlertIntake::drainLoop() {
+    std::unique_lock<std::mutex> lock(signalMutex);
+    while (!stopDraining) {
+        drainSignal.wait_for(lock, std::chrono::milliseconds(INTAKE_DRAIN_INTERVAL_MS));
+        
+        lock.unlock();
+        drain();
+        lock.lock();
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef ALERT_INTAKE_H
+#define ALERT_INTAKE_H
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <vector>
+#include "priority_queue.h"
+
+// Lock-free multi-producer intake in front of the alert PriorityQueue.
+// Producers link a node with one atomic exchange and never block; a single
+// consumer at a time (the background drainer or a reader that needs an
+// up-to-date queue) moves pending alerts into the queue in batches.
+class AlertIntake {
+private:
+    struct Node {
+        Alert alert;
+        std::atomic<Node*> next;
+        Node() : next(nullptr) {}
+    };
+    
+    // Intrusive MPSC list: producers swap `tail`, the consumer walks from
+    // `head`, which is always an already-consumed stub node
+    std::atomic<Node*> tail;
+    Node* head;
+    std::atomic<int> pending;
+    
+    PriorityQueue& queue;
+    std::mutex consumerMutex;    // Serialises consumers only
+    
+    std::thread drainThread;
+    std::mutex signalMutex;
+    std::condition_variable drainSignal;
+    bool stopDraining;
+    
+    void drainLoop();
+    int drainLocked();
+    
+    // Lets tests freeze a producer between its tail exchange and its link
+    friend struct AlertIntakeTestAccess;
+
+public:
+    // With background = false alerts reach the queue only via drain()
+    AlertIntake(PriorityQueue& queue, bool background = true);
+    ~AlertIntake();
+    
+    // Wait-free for producers: one allocation and one exchange. If the
+    // alert is coalesced its ID still addresses the alert it joined.
+    void submit(const Alert& alert);
+    
+    // Move every alert submitted before this call into the queue
+    int drain();
+    
+    // The queue with all completed submissions applied. Use for reads and
+    // updates by ID so a just-submitted alert is never missed.
+    PriorityQueue& settled();
+    
+    // Linearizable: reflects every submit() that returned before the call
+    bool peekMin(Alert& alert);
+    
+    int getPendingCount() const { return pending.load(std::memory_order_relaxed); }
+};
+
+#endif
@@ -0,0 +1,191 @@
+#include "alert_journal.h"
+#include <sstream>
+#include <iostream>
+#include <vector>
+
+// Entries larger than this are treated as corruption rather than allocated
+static const uint32_t JOURNAL_MAX_ENTRY = 1 << 20;
+
+AlertJournal::AlertJournal(const std::string& path)
+    : filePath(path), entryCount(0) {
+}
+
+AlertJournal::~AlertJournal() {
+    close();
+}
+
+void AlertJournal::open() {
+    if (file.is_open()) return;
+    file.open(filePath, std::ios::binary | std::ios::app);
+    if (!file.is_open()) {
+        std::cerr << "[JOURNAL] Error: Cannot open journal: " << filePath << std::endl;
+    }
+}
+
+void AlertJournal::close() {
+    if (file.is_open()) {
+        file.close();
+    }
+}
+
+// FNV-1a, enough to catch torn or partially flushed entries
+uint32_t AlertJournal::checksum(const std::string& data) {
+    uint32_t hash = 2166136261u;
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// One sequential write per entry, flushed before the caller returns
+void AlertJournal::append(const std::string& payload) {
+    if (!file.is_open()) return;
+    
+    uint32_t length = payload.size();
+    uint32_t sum = checksum(payload);
+    file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+    file.write(reinterpret_cast<const char*>(&sum), sizeof(sum));
+    file.write(payload.data(), payload.size());
+    file.flush();
+    entryCount++;
+}
+
+void AlertJournal::appendInsert(const Alert& alert) {
+    std::ostringstream out;
+    out.put(JOURNAL_INSERT);
+    alert.writeToDisk(out);
+    append(out.str());
+}
+
+void AlertJournal::appendRemove(int alertID) {
+    std::ostringstream out;
+    out.put(JOURNAL_REMOVE);
+    out.write(reinterpret_cast<const char*>(&alertID), sizeof(alertID));
+    append(out.str());
+}
+
+void AlertJournal::appendAck(int alertID, const std::string& acknowledgedBy, long acknowledgedTime) {
+    std::ostringstream out;
+    out.put(JOURNAL_ACK);
+    out.write(reinterpret_cast<const char*>(&alertID), sizeof(alertID));
+    out.write(reinterpret_cast<const char*>(&acknowledgedTime), sizeof(acknowledgedTime));
+    size_t len = acknowledgedBy.length();
+    out.write(reinterpret_cast<const char*>(&len), sizeof(len));
+    out.write(acknowledgedBy.c_str(), len);
+    append(out.str());
+}
+
+void AlertJournal::appendPriority(int alertID, AlertPriority priority) {
+    std::ostringstream out;
+    out.put(JOURNAL_PRIORITY);
+    out.write(reinterpret_cast<const char*>(&alertID), sizeof(alertID));
+    out.write(reinterpret_cast<const char*>(&priority), sizeof(priority));
+    append(out.str());
+}
+
+void AlertJournal::appendClear() {
+    std::string payload(1, static_cast<char>(JOURNAL_CLEAR));
+    append(payload);
+}
+
+void AlertJournal::appendCoalesce(int alertID, int occurrenceCount, long lastSeenTime, int repeatID) {
+    std::ostringstream out;
+    out.put(JOURNAL_COALESCE);
+    out.write(reinterpret_cast<const char*>(&alertID), sizeof(alertID));
+    out.write(reinterpret_cast<const char*>(&occurrenceCount), sizeof(occurrenceCount));
+    out.write(reinterpret_cast<const char*>(&lastSeenTime), sizeof(lastSeenTime));
+    out.write(reinterpret_cast<const char*>(&repeatID), sizeof(repeatID));
+    append(out.str());
+}
+
+void AlertJournal::truncate() {
+    close();
+    file.open(filePath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "[JOURNAL] Error: Cannot truncate journal: " << filePath << std::endl;
+    }
+    entryCount = 0;
+}
+
+// Stops at the first short or mismatched entry; anything after a torn
+// write was never acknowledged to the caller
+int AlertJournal::replay(const std::string& path, const std::function<void(const JournalEntry&)>& apply) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return 0;
+    
+    int replayed = 0;
+    uint32_t length, sum;
+    std::vector<char> buffer;
+    
+    while (file.read(reinterpret_cast<char*>(&length), sizeof(length)) &&
+           file.read(reinterpret_cast<char*>(&sum), sizeof(sum))) {
+        if (length == 0 || length > JOURNAL_MAX_ENTRY) break;
+        
+        buffer.resize(length);
+        if (!file.read(buffer.data(), length)) break;
+        
+        std::string payload(buffer.data(), length);
+        if (checksum(payload) != sum) break;
+        
+        std::istringstream in(payload);
+        JournalEntry entry;
+        entry.op = static_cast<JournalOp>(in.get());
+        
+        switch (entry.op) {
+            case JOURNAL_INSERT:
+                entry.alert.readFromDisk(in);
+                if (!in || in.peek() != EOF) {
+                    // Written before alerts carried coalescing fields
+                    in.clear();
+                    in.seekg(1);
+                    entry.alert.readFromDisk(in, 1);
+                }
+                break;
+            case JOURNAL_REMOVE:
+                in.read(reinterpret_cast<char*>(&entry.alertID), sizeof(entry.alertID));
+                break;
+            case JOURNAL_ACK: {
+                in.read(reinterpret_cast<char*>(&entry.alertID), sizeof(entry.alertID));
+                in.read(reinterpret_cast<char*>(&entry.acknowledgedTime), sizeof(entry.acknowledgedTime));
+                size_t len = 0;
+                in.read(reinterpret_cast<char*>(&len), sizeof(len));
+                if (len > length) {
+                    in.setstate(std::ios::failbit);
+                    break;
+                }
+                entry.acknowledgedBy.resize(len);
+                in.read(&entry.acknowledgedBy[0], len);
+                break;
+            }
+            case JOURNAL_PRIORITY:
+                in.read(reinterpret_cast<char*>(&entry.alertID), sizeof(entry.alertID));
+                in.read(reinterpret_cast<char*>(&entry.priority), sizeof(entry.priority));
+                break;
+            case JOURNAL_CLEAR:
+                break;
+            case JOURNAL_COALESCE:
+                in.read(reinterpret_cast<char*>(&entry.alertID), sizeof(entry.alertID));
+                in.read(reinterpret_cast<char*>(&entry.occurrenceCount), sizeof(entry.occurrenceCount));
+                in.read(reinterpret_cast<char*>(&entry.lastSeenTime), sizeof(entry.lastSeenTime));
+                if (in && in.peek() != EOF) {
+                    in.read(reinterpret_cast<char*>(&entry.repeatID), sizeof(entry.repeatID));
+                }
+                break;
+            default:
+                std::cerr << "[JOURNAL] Unknown entry type " << static_cast<int>(entry.op)
+                          << " in " << path << std::endl;
+                return replayed;
+        }
+        
+        if (!in) {
+            std::cerr << "[JOURNAL] Malformed entry in " << path << std::endl;
+            break;
+        }
+        
+        apply(entry);
+        replayed++;
+    }
+    
+    return replayed;
+}
@@ -0,0 +1,73 @@
+#ifndef ALERT_JOURNAL_H
+#define ALERT_JOURNAL_H
+
+#include <string>
+#include <fstream>
+#include <functional>
+#include <cstdint>
+#include "../models/alert.h"
+
+// Journal operation codes
+enum JournalOp : uint8_t {
+    JOURNAL_INSERT = 1,
+    JOURNAL_REMOVE = 2,
+    JOURNAL_ACK = 3,
+    JOURNAL_PRIORITY = 4,
+    JOURNAL_CLEAR = 5,
+    JOURNAL_COALESCE = 6
+};
+
+// One decoded journal entry. Only the fields used by `op` are set.
+struct JournalEntry {
+    JournalOp op;
+    Alert alert;                 // INSERT
+    int alertID;                 // REMOVE, ACK, PRIORITY, COALESCE
+    std::string acknowledgedBy;  // ACK
+    long acknowledgedTime;       // ACK
+    AlertPriority priority;      // PRIORITY
+    int occurrenceCount;         // COALESCE
+    long lastSeenTime;           // COALESCE
+    int repeatID;                // COALESCE: ID of the merged repeat (0 in older journals)
+    
+    JournalEntry() : op(JOURNAL_CLEAR), alertID(0), acknowledgedTime(0), priority(INFO),
+                     occurrenceCount(1), lastSeenTime(0), repeatID(0) {}
+};
+
+// Append-only log of alert queue mutations. Each entry is framed as
+// [length][checksum][op + payload] so a torn write at the tail is detected
+// and dropped on replay.
+class AlertJournal {
+private:
+    std::string filePath;
+    std::ofstream file;
+    int entryCount;
+    
+    void append(const std::string& payload);
+    
+public:
+    AlertJournal(const std::string& path);
+    ~AlertJournal();
+    
+    void open();
+    void close();
+    
+    void appendInsert(const Alert& alert);
+    void appendRemove(int alertID);
+    void appendAck(int alertID, const std::string& acknowledgedBy, long acknowledgedTime);
+    void appendPriority(int alertID, AlertPriority priority);
+    void appendClear();
+    void appendCoalesce(int alertID, int occurrenceCount, long lastSeenTime, int repeatID);
+    
+    // Discard all entries once a snapshot covers them
+    void truncate();
+    
+    int getEntryCount() const { return entryCount; }
+    const std::string& getFilePath() const { return filePath; }
+    
+    // Feed every intact entry to `apply`; returns the number replayed
+    static int replay(const std::string& path, const std::function<void(const JournalEntry&)>& apply);
+    
+    static uint32_t checksum(const std::string& data);
+};
+
+#endif
@@ -0,0 +1,82 @@
+#include "bloom_filter.h"
+#include <cmath>
+
+BloomFilter::BloomFilter(int expectedItems, double falsePositiveRate) {
+    if (expectedItems < 1) expectedItems = 1;
+    if (falsePositiveRate <= 0 || falsePositiveRate >= 1) falsePositiveRate = 0.01;
+    
+    // Optimal m = -n ln p / (ln 2)^2 and k = m/n ln 2
+    const double ln2 = std::log(2.0);
+    double m = -expectedItems * std::log(falsePositiveRate) / (ln2 * ln2);
+    
+    numBits = static_cast<int>(std::ceil(m / 64.0)) * 64;
+    if (numBits < 64) numBits = 64;
+    
+    numHashes = static_cast<int>(std::round(static_cast<double>(numBits) / expectedItems * ln2));
+    if (numHashes < 1) numHashes = 1;
+    if (numHashes > 16) numHashes = 16;
+    
+    bits.assign(numBits / 64, 0);
+}
+
+uint64_t BloomFilter::mix(uint64_t key) {
+    key += 0x9e3779b97f4a7c15ULL;
+    key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+    return key ^ (key >> 31);
+}
+
+// Double hashing: probe i is h1 + i * h2 (Kirsch-Mitzenmacher)
+void BloomFilter::addKey(uint64_t* words, int numBits, int numHashes, long key) {
+    uint64_t h = mix(static_cast<uint64_t>(key));
+    uint64_t h1 = h & 0xffffffffULL;
+    uint64_t h2 = (h >> 32) | 1;
+    
+    for (int i = 0; i < numHashes; i++) {
+        uint64_t bit = (h1 + i * h2) % numBits;
+        words[bit / 64] |= 1ULL << (bit % 64);
+    }
+}
+
+bool BloomFilter::testKey(const uint64_t* words, int numBits, int numHashes, long key) {
+    uint64_t h = mix(static_cast<uint64_t>(key));
+    uint64_t h1 = h & 0xffffffffULL;
+    uint64_t h2 = (h >> 32) | 1;
+    
+    for (int i = 0; i < numHashes; i++) {
+        uint64_t bit = (h1 + i * h2) % numBits;
+        if (!(words[bit / 64] & (1ULL << (bit % 64)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void BloomFilter::add(long key) {
+    addKey(bits.data(), numBits, numHashes, key);
+}
+
+bool BloomFilter::mightContain(long key) const {
+    return testKey(bits.data(), numBits, numHashes, key);
+}
+
+void BloomFilter::clear() {
+    bits.assign(bits.size(), 0);
+}
+
+void BloomFilter::writeToDisk(std::ofstream& file) const {
+    file.write(reinterpret_cast<const char*>(&numBits), sizeof(numBits));
+    file.write(reinterpret_cast<const char*>(&numHashes), sizeof(numHashes));
+    file.write(reinterpret_cast<const char*>(bits.data()), bits.size() * sizeof(uint64_t));
+}
+
+void BloomFilter::readFromDisk(std::ifstream& file) {
+    file.read(reinterpret_cast<char*>(&numBits), sizeof(numBits));
+    file.read(reinterpret_cast<char*>(&numHashes), sizeof(numHashes));
+    if (!file || numBits < 64) {
+        numBits = 64;
+        numHashes = 1;
+    }
+    bits.assign(numBits / 64, 0);
+    file.read(reinterpret_cast<char*>(bits.data()), bits.size() * sizeof(uint64_t));
+}
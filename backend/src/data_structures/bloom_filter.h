@@ -0,0 +1,40 @@
+#ifndef BLOOM_FILTER_H
+#define BLOOM_FILTER_H
+
+#include <vector>
+#include <fstream>
+#include <cstdint>
+
+// Bloom filter over integer keys (timestamps, patient IDs).
+// Answers "definitely absent" or "possibly present"; never a false negative.
+class BloomFilter {
+private:
+    std::vector<uint64_t> bits;
+    int numBits;
+    int numHashes;
+    
+    // 64-bit finaliser (splitmix64) used to derive the probe positions
+    static uint64_t mix(uint64_t key);
+
+public:
+    // Probe helpers over caller-owned bit arrays, for fixed-size filters
+    // embedded in other on-disk structures
+    static void addKey(uint64_t* words, int numBits, int numHashes, long key);
+    static bool testKey(const uint64_t* words, int numBits, int numHashes, long key);
+    
+    // Sized for `expectedItems` keys at roughly `falsePositiveRate`
+    BloomFilter(int expectedItems = 0, double falsePositiveRate = 0.01);
+    
+    void add(long key);
+    bool mightContain(long key) const;
+    
+    void clear();
+    int getBitCount() const { return numBits; }
+    int getHashCount() const { return numHashes; }
+    
+    // Disk persistence
+    void writeToDisk(std::ofstream& file) const;
+    void readFromDisk(std::ifstream& file);
+};
+
+#endif
@@ -1,6 +1,10 @@
 #include "btree.h"
 #include <iostream>
 #include <cstring>
+#include <cstdio>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
 
 // ==================== DiskBTreeNode ====================
 
@@ -45,7 +49,12 @@ DiskBTree::DiskBTree(int degree, const std::string& basePath)
       indexFilePath(basePath + "_index.dat"),
       dataFilePath(basePath + "_data.dat"),
       metaFilePath(basePath + "_meta.dat"),
-      nextNodePosition(0), nextDataPosition(0), totalRecords(0) {
+      hotFilePath(basePath + "_hot.dat"),
+      nextNodePosition(0), nextDataPosition(0), totalRecords(0),
+      nodeLoadsSinceRecord(0), hotPageSaveDue(false), hotPageStop(false), warmUpDone(false),
+      prefetchDepth(DEFAULT_PREFETCH_DEPTH), indexReadFd(-1), dataReadFd(-1),
+      zoneMap(basePath + "_zones.dat"),
+      patientIndex(basePath + "_pidx.dat") {
     
     // Check if files exist
     std::ifstream testMeta(metaFilePath);
@@ -54,7 +63,12 @@ DiskBTree::DiskBTree(int degree, const std::string& basePath)
     
     if (exists) {
         loadMeta();
+        zoneMap.catchUp(dataFilePath, totalRecords);
+        patientIndex.catchUp(dataFilePath, totalRecords);
         std::cout << "[DISK-BTREE] Loaded existing tree (" << totalRecords << " records)" << std::endl;
+        
+        // Prefetch hot pages in the background; isReady() flips when done
+        warmUpThread = std::thread(&DiskBTree::warmUp, this, rootPosition, nextNodePosition);
     } else {
         // Create new tree
         DiskBTreeNode* root = new DiskBTreeNode(minDegree, true);
@@ -63,12 +77,35 @@ DiskBTree::DiskBTree(int degree, const std::string& basePath)
         saveNode(root);
         deleteNode(root);
         saveMeta();
+        zoneMap.clear();
+        patientIndex.clear();
+        warmUpDone = true;
         std::cout << "[DISK-BTREE] Created new disk-based B-tree" << std::endl;
     }
+    
+    // Read-only descriptors used purely for read-ahead hints
+    indexReadFd = ::open(indexFilePath.c_str(), O_RDONLY);
+    dataReadFd = ::open(dataFilePath.c_str(), O_RDONLY | O_CREAT, 0644);
 }
 
 DiskBTree::~DiskBTree() {
+    if (warmUpThread.joinable()) {
+        warmUpThread.join();
+    }
+    {
+        std::lock_guard<std::mutex> lock(hotPageMutex);
+        hotPageStop = true;
+    }
+    hotPageCond.notify_one();
+    if (hotPageThread.joinable()) {
+        hotPageThread.join();
+    }
+    saveHotPages();
     saveMeta();
+    zoneMap.saveToDisk();
+    
+    if (indexReadFd >= 0) ::close(indexReadFd);
+    if (dataReadFd >= 0) ::close(dataReadFd);
     //Ensures that when the B-tree object is destroyed, 
     // the latest metadata (root position, next offsets, total records) is written to disk.
 }
@@ -93,6 +130,171 @@ void DiskBTree::loadMeta() {
     meta.close();
 }
 
+void DiskBTree::waitUntilReady() {
+    if (warmUpThread.joinable()) {
+        warmUpThread.join();
+    }
+}
+
+// Count node loads; every HOT_PAGE_RECORD_INTERVAL loads the writer
+// thread is woken to persist the hottest positions. The query that
+// crosses the interval only flips a flag.
+void DiskBTree::recordNodeAccess(long position) {
+    bool shouldRecord = false;
+    {
+        std::lock_guard<std::mutex> lock(hotPageMutex);
+        nodeAccessCounts[position]++;
+        if (++nodeLoadsSinceRecord >= HOT_PAGE_RECORD_INTERVAL) {
+            nodeLoadsSinceRecord = 0;
+            hotPageSaveDue = true;
+            shouldRecord = true;
+            if (!hotPageThread.joinable() && !hotPageStop) {
+                hotPageThread = std::thread(&DiskBTree::hotPageWriter, this);
+            }
+        }
+    }
+    
+    if (shouldRecord) {
+        hotPageCond.notify_one();
+    }
+}
+
+// Runs on hotPageThread, the only writer of the hot-page file until the
+// destructor's final save
+void DiskBTree::hotPageWriter() {
+    std::unique_lock<std::mutex> lock(hotPageMutex);
+    while (true) {
+        hotPageCond.wait(lock, [this]() { return hotPageSaveDue || hotPageStop; });
+        if (hotPageStop) return;
+        
+        hotPageSaveDue = false;
+        lock.unlock();
+        saveHotPages();
+        lock.lock();
+    }
+}
+
+// Written to a temporary file and renamed, so warm-up never reads a
+// partially written list
+void DiskBTree::saveHotPages() {
+    std::vector<std::pair<int, long>> ranked;
+    {
+        std::lock_guard<std::mutex> lock(hotPageMutex);
+        if (nodeAccessCounts.empty()) return;
+        
+        for (auto it = nodeAccessCounts.begin(); it != nodeAccessCounts.end(); ) {
+            ranked.push_back({it->second, it->first});
+            
+            // Halve counts so the list follows the current workload
+            it->second /= 2;
+            if (it->second == 0) {
+                it = nodeAccessCounts.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    
+    size_t limit = std::min(ranked.size(), static_cast<size_t>(HOT_PAGE_LIMIT));
+    std::partial_sort(ranked.begin(), ranked.begin() + limit, ranked.end(),
+                      [](const std::pair<int, long>& a, const std::pair<int, long>& b) {
+                          return a.first > b.first;
+                      });
+    
+    std::string tempPath = hotFilePath + ".tmp";
+    std::ofstream file(tempPath, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "[DISK-BTREE] Error: Cannot write hot-page list" << std::endl;
+        return;
+    }
+    
+    int count = limit;
+    file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    for (size_t i = 0; i < limit; i++) {
+        file.write(reinterpret_cast<const char*>(&ranked[i].second), sizeof(long));
+    }
+    file.close();
+    if (!file || std::rename(tempPath.c_str(), hotFilePath.c_str()) != 0) {
+        std::cerr << "[DISK-BTREE] Error: Cannot replace hot-page list" << std::endl;
+    }
+}
+
+std::vector<long> DiskBTree::loadHotPages() {
+    std::vector<long> positions;
+    std::ifstream file(hotFilePath, std::ios::binary);
+    if (!file.is_open()) {
+        return positions;
+    }
+    
+    int count = 0;
+    file.read(reinterpret_cast<char*>(&count), sizeof(count));
+    for (int i = 0; i < count && i < HOT_PAGE_LIMIT; i++) {
+        long position;
+        if (!file.read(reinterpret_cast<char*>(&position), sizeof(position))) break;
+        positions.push_back(position);
+    }
+    file.close();
+    return positions;
+}
+
+// Runs on warmUpThread. Reads the top tree levels and the persisted hot
+// pages so they are resident in the OS page cache before the first query.
+// Uses its own stream and never touches the access counters.
+void DiskBTree::warmUp(long root, long nodeLimit) {
+    std::ifstream file(indexFilePath, std::ios::binary);
+    if (!file.is_open()) {
+        warmUpDone = true;
+        return;
+    }
+    
+    const long nodeSize = DiskBTreeNode::getDiskSize();
+    auto isValidPosition = [&](long position) {
+        return position >= 0 && position < nodeLimit && position % nodeSize == 0;
+    };
+    
+    int pagesRead = 0;
+    DiskBTreeNode node(minDegree, true);
+    
+    // Top levels, breadth-first from the root
+    std::vector<long> level(1, root);
+    for (int depth = 0; depth < WARMUP_TREE_LEVELS && !level.empty(); depth++) {
+        std::vector<long> nextLevel;
+        for (long position : level) {
+            if (!isValidPosition(position)) continue;
+            file.seekg(position);
+            node.readFromDisk(file);
+            if (!file) {
+                file.clear();
+                continue;
+            }
+            pagesRead++;
+            
+            if (!node.isLeaf && node.numKeys >= 0 && node.numKeys <= MAX_KEYS) {
+                for (int i = 0; i <= node.numKeys; i++) {
+                    nextLevel.push_back(node.childPositions[i]);
+                }
+            }
+        }
+        level.swap(nextLevel);
+    }
+    
+    // Pages that were hot before the last shutdown
+    std::vector<char> buffer(nodeSize);
+    for (long position : loadHotPages()) {
+        if (!isValidPosition(position)) continue;
+        file.seekg(position);
+        if (!file.read(buffer.data(), nodeSize)) {
+            file.clear();
+            continue;
+        }
+        pagesRead++;
+    }
+    
+    file.close();
+    warmUpDone = true;
+    std::cout << "[DISK-BTREE] Warm-up complete (" << pagesRead << " pages prefetched)" << std::endl;
+}
+
 long DiskBTree::allocateNodePosition() {
     long pos = nextNodePosition;
     nextNodePosition += DiskBTreeNode::getDiskSize();
@@ -117,6 +319,7 @@ DiskBTreeNode* DiskBTree::loadNode(long position) {
     node->readFromDisk(file);
     file.close();
     
+    recordNodeAccess(position);
     return node;
 }
 
@@ -160,6 +363,105 @@ VitalRecord DiskBTree::loadRecord(long position) {
     return record;
 }
 
+// Reads the raw record once, checks the predicates against the encoded
+// fields and decodes only what the query projects. Records in blocks whose
+// zone rules the query out (e.g. patient not in the block's bloom filter)
+// are rejected without touching the data file.
+bool DiskBTree::loadRecordPushdown(long position, const VitalQuery& query, VitalRecord& record) {
+    if (!zoneMap.blockMayMatch(position, query.predicates)) {
+        return false;
+    }
+    
+    std::ifstream file(dataFilePath, std::ios::binary);
+    file.seekg(position);
+    
+    char buffer[64];
+    file.read(buffer, VitalRecord::getDiskSize());
+    file.close();
+    
+    if (!query.matchesEncoded(buffer)) {
+        return false;
+    }
+    
+    record = VitalRecord();
+    record.decodeFields(buffer, query.fieldMask);
+    record.diskPosition = position;
+    return true;
+}
+
+// Loads the records at `positions` (in order) through one file handle.
+// Runs of adjacent positions, the common case for time-ordered ingest,
+// are fetched with a single read and decoded as a batch.
+void DiskBTree::loadRecordRuns(const std::vector<long>& positions, const VitalQuery* query,
+                               std::vector<VitalRecord>& results) {
+    std::ifstream file(dataFilePath, std::ios::binary);
+    if (!file.is_open()) return;
+    
+    const long recordSize = VitalRecord::getDiskSize();
+    std::vector<char> buffer;
+    
+    size_t i = 0;
+    while (i < positions.size()) {
+        if (query && !zoneMap.blockMayMatch(positions[i], query->predicates)) {
+            i++;
+            continue;
+        }
+        
+        size_t runEnd = i + 1;
+        while (runEnd < positions.size() && positions[runEnd] == positions[runEnd - 1] + recordSize) {
+            runEnd++;
+        }
+        
+        size_t count = runEnd - i;
+        buffer.resize(count * recordSize);
+        file.clear();
+        file.seekg(positions[i]);
+        file.read(buffer.data(), buffer.size());
+        
+        if (file) {
+            if (!query) {
+                VitalRecord::decodeBatch(buffer.data(), count, results, positions[i]);
+            } else {
+                for (size_t r = 0; r < count; r++) {
+                    const char* raw = buffer.data() + r * recordSize;
+                    if (!query->matchesEncoded(raw)) continue;
+                    
+                    VitalRecord record;
+                    record.decodeFields(raw, query->fieldMask);
+                    record.diskPosition = positions[i] + r * recordSize;
+                    results.push_back(record);
+                }
+            }
+        }
+        i = runEnd;
+    }
+}
+
+void DiskBTree::loadBatchRuns(const std::vector<long>& positions, VitalBatch& batch) {
+    std::ifstream file(dataFilePath, std::ios::binary);
+    if (!file.is_open()) return;
+    
+    const long recordSize = VitalRecord::getDiskSize();
+    std::vector<char> buffer;
+    batch.reserve(batch.size() + positions.size());
+    
+    size_t i = 0;
+    while (i < positions.size()) {
+        size_t runEnd = i + 1;
+        while (runEnd < positions.size() && positions[runEnd] == positions[runEnd - 1] + recordSize) {
+            runEnd++;
+        }
+        
+        buffer.resize((runEnd - i) * recordSize);
+        file.clear();
+        file.seekg(positions[i]);
+        if (file.read(buffer.data(), buffer.size())) {
+            batch.appendEncoded(buffer.data(), runEnd - i);
+        }
+        i = runEnd;
+    }
+}
+
 long DiskBTree::saveRecord(const VitalRecord& record) {
     long position = allocateDataPosition();
     
@@ -178,6 +480,7 @@ long DiskBTree::saveRecord(const VitalRecord& record) {
     record.writeToDisk(file);
     file.close();
     
+    zoneMap.recordInserted(position, record);
     return position;
 }
 
@@ -210,6 +513,10 @@ void DiskBTree::insert(long timestamp, const VitalRecord& record) {
     totalRecords++;
     saveMeta();
     
+    // Logged only once the record is committed: after a crash the index
+    // may lag the data file (catchUp() fills it in) but never lead it
+    patientIndex.add(record.patientID, timestamp, dataPos);
+    
     std::cout << "[DISK-BTREE] Inserted record (total: " << totalRecords << ")" << std::endl;
 }
 
@@ -354,6 +661,95 @@ DiskBTreeNode* DiskBTree::searchNode(DiskBTreeNode* node, long key) {
     return result;
 }
 
+// Ask the kernel to start reading a node page we are about to visit
+void DiskBTree::prefetchNode(long position) {
+    if (indexReadFd < 0) return;
+    posix_fadvise(indexReadFd, position, DiskBTreeNode::getDiskSize(), POSIX_FADV_WILLNEED);
+}
+
+// Hint the data records of keys[from..] that fall inside the range,
+// merging adjacent records into a single request
+void DiskBTree::prefetchRecords(DiskBTreeNode* node, int from, long endKey) {
+    if (dataReadFd < 0) return;
+    
+    const long recordSize = VitalRecord::getDiskSize();
+    long runStart = -1;
+    long runEnd = -1;
+    
+    for (int i = from; i < node->numKeys && node->keys[i] <= endKey; i++) {
+        long position = node->dataPositions[i];
+        if (position == runEnd) {
+            runEnd += recordSize;
+            continue;
+        }
+        if (runStart >= 0) {
+            posix_fadvise(dataReadFd, runStart, runEnd - runStart, POSIX_FADV_WILLNEED);
+        }
+        runStart = position;
+        runEnd = position + recordSize;
+    }
+    
+    if (runStart >= 0) {
+        posix_fadvise(dataReadFd, runStart, runEnd - runStart, POSIX_FADV_WILLNEED);
+    }
+}
+
+std::vector<VitalRecord> DiskBTree::scanWhere(long startTime, long endTime,
+                                              const std::vector<VitalPredicate>& predicates,
+                                              ZoneScanStats* stats) {
+    std::vector<VitalRecord> results;
+    std::vector<int> blocks = zoneMap.findCandidateBlocks(startTime, endTime, predicates);
+    
+    if (stats) {
+        stats->blocksTotal = zoneMap.getBlockCount();
+        stats->blocksScanned = blocks.size();
+    }
+    
+    std::ifstream file(dataFilePath, std::ios::binary);
+    if (!file.is_open()) return results;
+    
+    const long recordSize = VitalRecord::getDiskSize();
+    std::vector<char> buffer;
+    std::vector<VitalRecord> batch;
+    for (int block : blocks) {
+        long position = block * ZoneMapIndex::getBlockBytes();
+        int count = zoneMap.getZone(block).recordCount;
+        
+        // Blocks are contiguous: one read, one batch decode per block
+        buffer.resize(count * recordSize);
+        file.clear();
+        file.seekg(position);
+        if (!file.read(buffer.data(), buffer.size())) continue;
+        
+        batch.clear();
+        VitalRecord::decodeBatch(buffer.data(), count, batch, position);
+        
+        for (const auto& record : batch) {
+            if (record.timestamp < startTime || record.timestamp > endTime) continue;
+            
+            bool matches = true;
+            for (const auto& predicate : predicates) {
+                if (!predicate.matches(record)) {
+                    matches = false;
+                    break;
+                }
+            }
+            
+            if (matches) {
+                results.push_back(record);
+            }
+        }
+    }
+    file.close();
+    
+    // Blocks follow insertion order; return readings in time order
+    std::stable_sort(results.begin(), results.end(),
+                     [](const VitalRecord& a, const VitalRecord& b) {
+                         return a.timestamp < b.timestamp;
+                     });
+    return results;
+}
+
 std::vector<VitalRecord> DiskBTree::rangeQuery(long startTime, long endTime) {
     std::vector<VitalRecord> results;
     DiskBTreeNode* root = loadNode(rootPosition);
@@ -362,34 +758,240 @@ std::vector<VitalRecord> DiskBTree::rangeQuery(long startTime, long endTime) {
     return results;
 }
 
+std::vector<VitalRecord> DiskBTree::rangeQuery(long startTime, long endTime, const VitalQuery& query) {
+    std::vector<VitalRecord> results;
+    DiskBTreeNode* root = loadNode(rootPosition);
+    rangeQueryHelper(root, startTime, endTime, results, &query);
+    deleteNode(root);
+    return results;
+}
+
 
 void DiskBTree::rangeQueryHelper(DiskBTreeNode* node, long startKey, long endKey, 
-                                  std::vector<VitalRecord>& results) {
+                                  std::vector<VitalRecord>& results,
+                                  const VitalQuery* query) {
     int i = 0;
     
     while (i < node->numKeys && node->keys[i] < startKey) {
         i++;
     }
     
+    if (prefetchDepth > 0) {
+        prefetchRecords(node, i, endKey);
+    }
+    
+    // Children up to this index have already been hinted
+    int prefetchedUpTo = i;
+    
+    // Leaf records are collected and read in coalesced runs
+    std::vector<long> leafPositions;
+    
     for (; i < node->numKeys; i++) {
         if (!node->isLeaf) {
+            // Child j is visited only if keys[j - 1] is still inside the range
+            while (prefetchedUpTo < i + prefetchDepth && prefetchedUpTo < node->numKeys &&
+                   node->keys[prefetchedUpTo] <= endKey) {
+                prefetchedUpTo++;
+                prefetchNode(node->childPositions[prefetchedUpTo]);
+            }
+            
             DiskBTreeNode* child = loadNode(node->childPositions[i]);
-            rangeQueryHelper(child, startKey, endKey, results);
+            rangeQueryHelper(child, startKey, endKey, results, query);
             deleteNode(child);
         }
         
         if (node->keys[i] > endKey) {
-            return;
+            break;
         }
         
         if (node->keys[i] >= startKey && node->keys[i] <= endKey) {
-            results.push_back(loadRecord(node->dataPositions[i]));
+            if (node->isLeaf) {
+                leafPositions.push_back(node->dataPositions[i]);
+            } else if (query) {
+                VitalRecord record;
+                if (loadRecordPushdown(node->dataPositions[i], *query, record)) {
+                    results.push_back(record);
+                }
+            } else {
+                results.push_back(loadRecord(node->dataPositions[i]));
+            }
         }
     }
     
+    if (node->isLeaf) {
+        loadRecordRuns(leafPositions, query, results);
+    } else if (i == node->numKeys) {
+        DiskBTreeNode* child = loadNode(node->childPositions[i]);
+        rangeQueryHelper(child, startKey, endKey, results, query);
+        deleteNode(child);
+    }
+}
+
+std::vector<VitalRecord> DiskBTree::patientRangeQuery(int patientID, long startTime, long endTime,
+                                                      const VitalQuery& query) {
+    std::vector<VitalRecord> results;
+    std::vector<PatientIndexEntry> entries = patientIndex.lookup(patientID, startTime, endTime);
+    
+    for (const auto& entry : entries) {
+        VitalRecord record;
+        if (loadRecordPushdown(entry.dataPosition, query, record)) {
+            results.push_back(record);
+        }
+    }
+    
+    return results;
+}
+
+std::vector<VitalRecord> DiskBTree::patientLatestRecords(int patientID, long startTime, long endTime,
+                                                         int count, const VitalQuery& query) {
+    std::vector<VitalRecord> results;
+    std::vector<PatientIndexEntry> entries = patientIndex.lookup(patientID, startTime, endTime);
+    
+    for (auto it = entries.rbegin(); it != entries.rend() && static_cast<int>(results.size()) < count; ++it) {
+        VitalRecord record;
+        if (loadRecordPushdown(it->dataPosition, query, record)) {
+            results.push_back(record);
+        }
+    }
+    
+    std::reverse(results.begin(), results.end());
+    return results;
+}
+
+// In-order walk that only gathers data positions; the records are read
+// afterwards in coalesced runs
+void DiskBTree::collectRangePositions(DiskBTreeNode* node, long startKey, long endKey,
+                                      std::vector<long>& positions) {
+    int i = 0;
+    while (i < node->numKeys && node->keys[i] < startKey) {
+        i++;
+    }
+    
+    for (; i < node->numKeys; i++) {
+        if (!node->isLeaf) {
+            DiskBTreeNode* child = loadNode(node->childPositions[i]);
+            collectRangePositions(child, startKey, endKey, positions);
+            deleteNode(child);
+        }
+        
+        if (node->keys[i] > endKey) {
+            return;
+        }
+        positions.push_back(node->dataPositions[i]);
+    }
+    
     if (!node->isLeaf) {
         DiskBTreeNode* child = loadNode(node->childPositions[i]);
-        rangeQueryHelper(child, startKey, endKey, results);
+        collectRangePositions(child, startKey, endKey, positions);
         deleteNode(child);
     }
+}
+
+void DiskBTree::rangeQueryBatch(long startTime, long endTime, VitalBatch& batch) {
+    batch.clear();
+    
+    std::vector<long> positions;
+    DiskBTreeNode* root = loadNode(rootPosition);
+    collectRangePositions(root, startTime, endTime, positions);
+    deleteNode(root);
+    
+    loadBatchRuns(positions, batch);
+}
+
+void DiskBTree::patientRangeQueryBatch(int patientID, long startTime, long endTime, VitalBatch& batch) {
+    batch.clear();
+    
+    std::vector<PatientIndexEntry> entries = patientIndex.lookup(patientID, startTime, endTime);
+    std::vector<long> positions;
+    positions.reserve(entries.size());
+    for (const auto& entry : entries) {
+        positions.push_back(entry.dataPosition);
+    }
+    
+    loadBatchRuns(positions, batch);
+}
+
+// ==================== DiskBTreeReverseCursor ====================
+
+DiskBTreeReverseCursor::DiskBTreeReverseCursor(DiskBTree& tree, long endKey)
+    : tree(tree) {
+    // Seek: at every level, skip the keys greater than endKey and
+    // continue into the child just left of them
+    DiskBTreeNode* node = tree.loadNode(tree.rootPosition);
+    while (node) {
+        int i = 0;
+        while (i < node->numKeys && node->keys[i] <= endKey) {
+            i++;
+        }
+        
+        Frame frame = {node, i - 1};
+        stack.push_back(frame);
+        
+        if (node->isLeaf) break;
+        node = tree.loadNode(node->childPositions[i]);
+    }
+}
+
+DiskBTreeReverseCursor::~DiskBTreeReverseCursor() {
+    for (auto& frame : stack) {
+        tree.deleteNode(frame.node);
+    }
+}
+
+void DiskBTreeReverseCursor::descendRightmost(long position) {
+    while (true) {
+        DiskBTreeNode* node = tree.loadNode(position);
+        if (!node) return;
+        
+        Frame frame = {node, node->numKeys - 1};
+        stack.push_back(frame);
+        
+        if (node->isLeaf) return;
+        position = node->childPositions[node->numKeys];
+    }
+}
+
+bool DiskBTreeReverseCursor::prev(long& key, long& dataPosition) {
+    while (!stack.empty()) {
+        Frame& top = stack.back();
+        
+        if (top.index < 0) {
+            tree.deleteNode(top.node);
+            stack.pop_back();
+            continue;
+        }
+        
+        int emitted = top.index--;
+        DiskBTreeNode* node = top.node;
+        key = node->keys[emitted];
+        dataPosition = node->dataPositions[emitted];
+        
+        // Keys just below this one live in the child on its left
+        if (!node->isLeaf) {
+            descendRightmost(node->childPositions[emitted]);
+        }
+        return true;
+    }
+    return false;
+}
+
+std::vector<VitalRecord> DiskBTree::latestRecords(long startTime, long endTime, int count,
+                                                  const VitalQuery& query) {
+    std::vector<VitalRecord> results;
+    if (count <= 0) return results;
+    
+    DiskBTreeReverseCursor cursor(*this, endTime);
+    long key, dataPos;
+    
+    while (static_cast<int>(results.size()) < count && cursor.prev(key, dataPos)) {
+        if (key < startTime) break;
+        
+        VitalRecord record;
+        if (loadRecordPushdown(dataPos, query, record)) {
+            results.push_back(record);
+        }
+    }
+    
+    std::reverse(results.begin(), results.end());
+    return results;
 }
\ No newline at end of file
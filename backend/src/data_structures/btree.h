@@ -5,11 +5,30 @@
 #include <string>
 #include <fstream>
 #include <map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
 #include "../models/vital_record.h"
+#include "zone_map.h"
+#include "patient_index.h"
+#include "storage_engine.h"
 
 // Maximum keys per node (for fixed-size disk allocation)
 const int MAX_KEYS = 99;  // For degree 50
 
+// Hot-page tracking: the most frequently loaded node positions are
+// persisted every HOT_PAGE_RECORD_INTERVAL node loads (by a background
+// writer, off the query path) and prefetched on the next startup,
+// together with the top WARMUP_TREE_LEVELS levels.
+const int HOT_PAGE_LIMIT = 256;
+const int HOT_PAGE_RECORD_INTERVAL = 1000;
+const int WARMUP_TREE_LEVELS = 2;
+
+// Range scans hint this many upcoming sibling children to the kernel
+// before descending into the current one (0 disables read-ahead).
+const int DEFAULT_PREFETCH_DEPTH = 4;
+
 struct DiskBTreeNode {
     bool isLeaf;
     int minDegree;
@@ -26,19 +45,73 @@ struct DiskBTreeNode {
     void readFromDisk(std::ifstream& file);
 };
 
-class DiskBTree {
+class DiskBTree;
+
+// Walks index entries in descending key order, starting from the largest
+// key <= endKey. Holds one node per level, so positioning costs O(log n)
+// and every further step is amortised O(1).
+class DiskBTreeReverseCursor {
+private:
+    struct Frame {
+        DiskBTreeNode* node;
+        int index;  // next key to emit in this node, -1 when exhausted
+    };
+    
+    DiskBTree& tree;
+    std::vector<Frame> stack;
+    
+    void descendRightmost(long position);
+    
+public:
+    DiskBTreeReverseCursor(DiskBTree& tree, long endKey);
+    ~DiskBTreeReverseCursor();
+    
+    // Next (key, data position) pair; false once the index is exhausted
+    bool prev(long& key, long& dataPosition);
+    
+private:
+    DiskBTreeReverseCursor(const DiskBTreeReverseCursor&);
+    DiskBTreeReverseCursor& operator=(const DiskBTreeReverseCursor&);
+};
+
+class DiskBTree : public VitalStorageEngine {
+    friend class DiskBTreeReverseCursor;
+    
 private:
     int minDegree;
     long rootPosition;
     std::string indexFilePath;
     std::string dataFilePath;
     std::string metaFilePath;
+    std::string hotFilePath;
     
     // Metadata
     long nextNodePosition;
     long nextDataPosition;
     int totalRecords;
     
+    // Hot-page statistics and startup warm-up
+    std::map<long, int> nodeAccessCounts;
+    int nodeLoadsSinceRecord;
+    std::mutex hotPageMutex;
+    std::condition_variable hotPageCond;
+    bool hotPageSaveDue;
+    bool hotPageStop;
+    std::thread hotPageThread;    // Started on the first due save
+    std::thread warmUpThread;
+    std::atomic<bool> warmUpDone;
+    
+    // Read-ahead for range scans
+    int prefetchDepth;
+    int indexReadFd;
+    int dataReadFd;
+    
+    // Min/max summaries over blocks of the data file
+    ZoneMapIndex zoneMap;
+    
+    // patientID -> that patient's data positions, in time order
+    PatientIndex patientIndex;
+    
     // Helper functions
     DiskBTreeNode* loadNode(long position);
     void saveNode(DiskBTreeNode* node);
@@ -52,12 +125,27 @@ private:
     
     DiskBTreeNode* searchNode(DiskBTreeNode* node, long key);
     void rangeQueryHelper(DiskBTreeNode* node, long startKey, long endKey, 
-                         std::vector<VitalRecord>& results);
+                         std::vector<VitalRecord>& results,
+                         const VitalQuery* query = nullptr);
+    void prefetchNode(long position);
+    void prefetchRecords(DiskBTreeNode* node, int from, long endKey);
     
     void saveMeta();
     void loadMeta();
     
+    void recordNodeAccess(long position);
+    void hotPageWriter();
+    void saveHotPages();
+    std::vector<long> loadHotPages();
+    void warmUp(long root, long nodeLimit);
+    
     VitalRecord loadRecord(long position);
+    bool loadRecordPushdown(long position, const VitalQuery& query, VitalRecord& record);
+    void loadRecordRuns(const std::vector<long>& positions, const VitalQuery* query,
+                        std::vector<VitalRecord>& results);
+    void loadBatchRuns(const std::vector<long>& positions, VitalBatch& batch);
+    void collectRangePositions(DiskBTreeNode* node, long startKey, long endKey,
+                               std::vector<long>& positions);
     long saveRecord(const VitalRecord& record);
     long searchHelper(DiskBTreeNode* node, long key);
     
@@ -65,11 +153,51 @@ public:
     DiskBTree(int degree, const std::string& basePath);
     ~DiskBTree();
     
-    void insert(long timestamp, const VitalRecord& record);
-    VitalRecord* search(long timestamp);
-    std::vector<VitalRecord> rangeQuery(long startTime, long endTime);
+    void insert(long timestamp, const VitalRecord& record) override;
+    VitalRecord* search(long timestamp) override;
+    std::vector<VitalRecord> rangeQuery(long startTime, long endTime) override;
+    
+    // Range scan with predicates evaluated on raw records and only the
+    // projected fields decoded
+    std::vector<VitalRecord> rangeQuery(long startTime, long endTime,
+                                        const VitalQuery& query) override;
+    
+    // Up to `count` most recent records in [startTime, endTime] that pass
+    // the query, returned oldest first. Walks the index backwards from
+    // endTime and stops as soon as enough records were found.
+    std::vector<VitalRecord> latestRecords(long startTime, long endTime, int count,
+                                           const VitalQuery& query) override;
+    
+    // Records in [startTime, endTime] satisfying every predicate, found by
+    // reading only the data blocks whose zone maps can match
+    std::vector<VitalRecord> scanWhere(long startTime, long endTime,
+                                       const std::vector<VitalPredicate>& predicates,
+                                       ZoneScanStats* stats = nullptr) override;
+    
+    // Per-patient lookups through the secondary index; cost is
+    // proportional to that patient's readings, not the whole window
+    std::vector<VitalRecord> patientRangeQuery(int patientID, long startTime, long endTime,
+                                               const VitalQuery& query) override;
+    std::vector<VitalRecord> patientLatestRecords(int patientID, long startTime, long endTime,
+                                                  int count, const VitalQuery& query) override;
+    
+    // Decode straight into columns, in key order
+    void rangeQueryBatch(long startTime, long endTime, VitalBatch& batch) override;
+    void patientRangeQueryBatch(int patientID, long startTime, long endTime, VitalBatch& batch) override;
+    
+    int getRecordCount() const override { return totalRecords; }
+    std::string getEngineName() const override { return "btree"; }
+    
+    // Number of sibling children prefetched ahead during range scans
+    void setPrefetchDepth(int depth) { prefetchDepth = depth < 0 ? 0 : depth; }
+    int getPrefetchDepth() const { return prefetchDepth; }
+    
+    const ZoneMapIndex& getZoneMap() const { return zoneMap; }
+    const PatientIndex& getPatientIndex() const { return patientIndex; }
     
-    int getRecordCount() const { return totalRecords; }
+    // True once the startup prefetch of hot pages has finished
+    bool isReady() const override { return warmUpDone.load(); }
+    void waitUntilReady();
 };
 
 #endif
\ No newline at end of file
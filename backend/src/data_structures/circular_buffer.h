@@ -0,0 +1,83 @@
+#ifndef CIRCULAR_BUFFER_H
+#define CIRCULAR_BUFFER_H
+
+#include <vector>
+#include <stdexcept>
+
+// Fixed-capacity ring buffer. Pushing onto a full buffer overwrites the
+// oldest element, so memory stays bounded for unbounded streams.
+// Index 0 is the oldest element, size() - 1 the newest.
+template<typename T>
+class CircularBuffer {
+private:
+    std::vector<T> buffer;
+    int head;       // Slot the next push writes to
+    int count;
+    
+    int physicalIndex(int index) const;
+
+public:
+    CircularBuffer(int capacity = 64);
+    
+    void push(const T& value);
+    void clear();
+    
+    const T& operator[](int index) const;
+    const T& front() const { return (*this)[0]; }
+    const T& back() const { return (*this)[count - 1]; }
+    
+    int size() const { return count; }
+    int capacity() const { return buffer.size(); }
+    bool empty() const { return count == 0; }
+    bool full() const { return count == capacity(); }
+    
+    // Oldest-to-newest copy of the last n elements (all when n < 0)
+    std::vector<T> toVector(int n = -1) const;
+};
+
+// ==================== IMPLEMENTATION ====================
+
+template<typename T>
+CircularBuffer<T>::CircularBuffer(int capacity)
+    : buffer(capacity > 0 ? capacity : 1), head(0), count(0) {}
+
+template<typename T>
+int CircularBuffer<T>::physicalIndex(int index) const {
+    int start = head - count;
+    if (start < 0) start += capacity();
+    return (start + index) % capacity();
+}
+
+template<typename T>
+void CircularBuffer<T>::push(const T& value) {
+    buffer[head] = value;
+    head = (head + 1) % capacity();
+    if (count < capacity()) count++;
+}
+
+template<typename T>
+void CircularBuffer<T>::clear() {
+    head = 0;
+    count = 0;
+}
+
+template<typename T>
+const T& CircularBuffer<T>::operator[](int index) const {
+    if (index < 0 || index >= count) {
+        throw std::out_of_range("CircularBuffer index out of range");
+    }
+    return buffer[physicalIndex(index)];
+}
+
+template<typename T>
+std::vector<T> CircularBuffer<T>::toVector(int n) const {
+    if (n < 0 || n > count) n = count;
+    std::vector<T> result;
+    result.reserve(n);
+    for (int i = count - n; i < count; i++) {
+        result.push_back(buffer[physicalIndex(i)]);
+    }
+    return result;
+}
+
+#endif
@@ -0,0 +1,762 @@
+#include "lsm_tree.h"
+#include <iostream>
+#include <algorithm>
+#include <queue>
+#include <cstdio>
+
+static const int LSM_RUN_MAGIC = 0x4c534d32;  // "LSM2"
+
+static size_t trailerSize() {
+    return sizeof(int) * 3 + sizeof(long) * 3;
+}
+
+static long rawKey(const char* raw) {
+    return static_cast<long>(VitalRecord::decodeField(raw, FIELD_TIMESTAMP));
+}
+
+static void sortByTimestamp(std::vector<VitalRecord>& records) {
+    std::stable_sort(records.begin(), records.end(),
+                     [](const VitalRecord& a, const VitalRecord& b) {
+                         return a.timestamp < b.timestamp;
+                     });
+}
+
+// ==================== LSMRun ====================
+
+LSMRun::LSMRun(int id, int lvl, const std::string& path)
+    : runID(id), level(lvl), filePath(path), recordCount(0),
+      minKey(0), maxKey(-1), obsolete(false) {}
+
+LSMRun::~LSMRun() {
+    if (obsolete) {
+        std::remove(filePath.c_str());
+    }
+}
+
+int LSMRun::getBlockRecords(int block) const {
+    return std::min(LSM_BLOCK_RECORDS, recordCount - block * LSM_BLOCK_RECORDS);
+}
+
+bool LSMRun::overlaps(long startTime, long endTime) const {
+    return recordCount > 0 && minKey <= endTime && maxKey >= startTime;
+}
+
+bool LSMRun::mayContainPatients(const std::vector<VitalPredicate>& predicates) const {
+    for (const auto& predicate : predicates) {
+        if (predicate.field == FIELD_PATIENT_ID && predicate.op == OP_EQUAL &&
+            !patientFilter.mightContain(static_cast<long>(predicate.value))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int LSMRun::findBlock(long key) const {
+    // Equal keys may spill over from the previous block, so start one
+    // block before the first fence key >= key
+    auto it = std::lower_bound(blockFirstKeys.begin(), blockFirstKeys.end(), key);
+    int block = it - blockFirstKeys.begin();
+    return block > 0 ? block - 1 : 0;
+}
+
+bool LSMRun::readBlock(std::ifstream& file, int block, std::vector<char>& buffer) const {
+    const long recordSize = VitalRecord::getDiskSize();
+    buffer.resize(getBlockRecords(block) * recordSize);
+    
+    file.clear();
+    file.seekg(static_cast<long>(block) * LSM_BLOCK_RECORDS * recordSize);
+    file.read(buffer.data(), buffer.size());
+    return static_cast<bool>(file);
+}
+
+bool LSMRun::loadFooter() {
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open()) return false;
+    
+    file.seekg(0, std::ios::end);
+    long fileSize = file.tellg();
+    if (fileSize < static_cast<long>(trailerSize())) return false;
+    
+    int magic, blockCount;
+    long footerOffset;
+    file.seekg(fileSize - trailerSize());
+    file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    file.read(reinterpret_cast<char*>(&recordCount), sizeof(recordCount));
+    file.read(reinterpret_cast<char*>(&blockCount), sizeof(blockCount));
+    file.read(reinterpret_cast<char*>(&minKey), sizeof(minKey));
+    file.read(reinterpret_cast<char*>(&maxKey), sizeof(maxKey));
+    file.read(reinterpret_cast<char*>(&footerOffset), sizeof(footerOffset));
+    if (!file || magic != LSM_RUN_MAGIC) return false;
+    
+    file.seekg(footerOffset);
+    blockFirstKeys.resize(blockCount);
+    file.read(reinterpret_cast<char*>(blockFirstKeys.data()), sizeof(long) * blockCount);
+    
+    blockZones.resize(blockCount);
+    for (int b = 0; b < blockCount; b++) {
+        blockZones[b].readFromDisk(file);
+    }
+    keyFilter.readFromDisk(file);
+    patientFilter.readFromDisk(file);
+    
+    return static_cast<bool>(file);
+}
+
+// ==================== LSMRunWriter ====================
+
+LSMRunWriter::LSMRunWriter(int runID, int level, const std::string& path, int expectedRecords)
+    : run(new LSMRun(runID, level, path)),
+      file(path, std::ios::binary | std::ios::trunc) {
+    run->keyFilter = BloomFilter(expectedRecords, 0.01);
+    run->patientFilter = BloomFilter(std::min(expectedRecords, LSM_PATIENT_FILTER_ITEMS), 0.01);
+}
+
+void LSMRunWriter::append(const VitalRecord& record) {
+    if (run->recordCount % LSM_BLOCK_RECORDS == 0) {
+        if (run->recordCount > 0) {
+            run->blockZones.push_back(currentZone);
+        }
+        currentZone.reset();
+        run->blockFirstKeys.push_back(record.timestamp);
+    }
+    
+    record.encode(buffer);
+    file.write(buffer, VitalRecord::getDiskSize());
+    
+    currentZone.update(record);
+    run->keyFilter.add(record.timestamp);
+    run->patientFilter.add(record.patientID);
+    
+    if (run->recordCount == 0) run->minKey = record.timestamp;
+    run->maxKey = record.timestamp;
+    run->recordCount++;
+}
+
+std::shared_ptr<LSMRun> LSMRunWriter::finish() {
+    // Close the last (possibly partial) block
+    if (run->blockZones.size() < run->blockFirstKeys.size()) {
+        run->blockZones.push_back(currentZone);
+    }
+    
+    long footerOffset = file.tellp();
+    int blockCount = run->blockFirstKeys.size();
+    
+    file.write(reinterpret_cast<const char*>(run->blockFirstKeys.data()), sizeof(long) * blockCount);
+    for (const auto& zone : run->blockZones) {
+        zone.writeToDisk(file);
+    }
+    run->keyFilter.writeToDisk(file);
+    run->patientFilter.writeToDisk(file);
+    
+    file.write(reinterpret_cast<const char*>(&LSM_RUN_MAGIC), sizeof(LSM_RUN_MAGIC));
+    file.write(reinterpret_cast<const char*>(&run->recordCount), sizeof(run->recordCount));
+    file.write(reinterpret_cast<const char*>(&blockCount), sizeof(blockCount));
+    file.write(reinterpret_cast<const char*>(&run->minKey), sizeof(run->minKey));
+    file.write(reinterpret_cast<const char*>(&run->maxKey), sizeof(run->maxKey));
+    file.write(reinterpret_cast<const char*>(&footerOffset), sizeof(footerOffset));
+    file.close();
+    
+    return run;
+}
+
+// ==================== Run scanners ====================
+
+// Forward reader over a run, one block in memory at a time. With a
+// predicate list, blocks whose zone rules them out are never read.
+struct LSMRunScanner {
+    std::shared_ptr<LSMRun> run;
+    std::ifstream file;
+    std::vector<char> block;
+    const std::vector<VitalPredicate>* skipFilter;
+    int blockIndex;
+    int position;
+    bool ok;
+    
+    LSMRunScanner(const std::shared_ptr<LSMRun>& r, int startBlock,
+                  const std::vector<VitalPredicate>* filter = nullptr)
+        : run(r), file(r->filePath, std::ios::binary), skipFilter(filter),
+          blockIndex(startBlock - 1), position(0), ok(true) {
+        nextBlock();
+    }
+    
+    void nextBlock() {
+        blockIndex++;
+        while (skipFilter && blockIndex < run->getBlockCount() &&
+               !run->blockZones[blockIndex].mayMatchAll(*skipFilter)) {
+            blockIndex++;
+        }
+        position = 0;
+        ok = file.is_open() && blockIndex < run->getBlockCount() &&
+             run->readBlock(file, blockIndex, block);
+    }
+    
+    bool valid() const { return ok; }
+    const char* current() const { return block.data() + position * VitalRecord::getDiskSize(); }
+    long currentKey() const { return rawKey(current()); }
+    
+    void next() {
+        if (++position >= run->getBlockRecords(blockIndex)) {
+            nextBlock();
+        }
+    }
+};
+
+// Backward reader over a run, starting at the last key <= endKey.
+// Skips blocks the same way LSMRunScanner does.
+struct LSMRunReverseScanner {
+    std::shared_ptr<LSMRun> run;
+    std::ifstream file;
+    std::vector<char> block;
+    const std::vector<VitalPredicate>* skipFilter;
+    int blockIndex;
+    int position;
+    bool ok;
+    
+    LSMRunReverseScanner(const std::shared_ptr<LSMRun>& r, long endKey,
+                         const std::vector<VitalPredicate>* filter = nullptr)
+        : run(r), file(r->filePath, std::ios::binary), skipFilter(filter),
+          position(-1), ok(true) {
+        auto it = std::upper_bound(run->blockFirstKeys.begin(), run->blockFirstKeys.end(), endKey);
+        blockIndex = (it - run->blockFirstKeys.begin());
+        prevBlock();
+        
+        while (ok && currentKey() > endKey) {
+            prev();
+        }
+    }
+    
+    void prevBlock() {
+        blockIndex--;
+        while (skipFilter && blockIndex >= 0 &&
+               !run->blockZones[blockIndex].mayMatchAll(*skipFilter)) {
+            blockIndex--;
+        }
+        ok = file.is_open() && blockIndex >= 0 && run->readBlock(file, blockIndex, block);
+        position = ok ? run->getBlockRecords(blockIndex) - 1 : -1;
+    }
+    
+    bool valid() const { return ok; }
+    const char* current() const { return block.data() + position * VitalRecord::getDiskSize(); }
+    long currentKey() const { return rawKey(current()); }
+    
+    void prev() {
+        if (--position < 0) {
+            prevBlock();
+        }
+    }
+};
+
+// ==================== LSMTree ====================
+
+LSMTree::LSMTree(const std::string& basePath)
+    : basePath(basePath),
+      walFilePath(basePath + "_lsm_wal.dat"),
+      manifestFilePath(basePath + "_lsm_manifest.dat"),
+      nextRunID(1), totalRecords(0), flushedRecords(0),
+      stopCompaction(false), compacting(false) {
+    
+    loadManifest();
+    replayWal();
+    walFile.open(walFilePath, std::ios::binary | std::ios::app);
+    
+    compactionThread = std::thread(&LSMTree::compactionLoop, this);
+    
+    std::cout << "[LSM] Opened tree (" << totalRecords << " records, "
+              << runs.size() << " runs)" << std::endl;
+}
+
+LSMTree::~LSMTree() {
+    {
+        std::lock_guard<std::mutex> lock(treeMutex);
+        stopCompaction = true;
+    }
+    compactionSignal.notify_all();
+    if (compactionThread.joinable()) {
+        compactionThread.join();
+    }
+    
+    std::lock_guard<std::mutex> lock(treeMutex);
+    if (!memtable.empty()) {
+        flushMemtable();
+    }
+    walFile.close();
+    saveManifest();
+}
+
+std::string LSMTree::runFilePath(int runID) const {
+    return basePath + "_lsm_run_" + std::to_string(runID) + ".dat";
+}
+
+long LSMTree::levelCapacity(int level) {
+    long capacity = static_cast<long>(LSM_MEMTABLE_LIMIT) * LSM_L0_RUN_LIMIT;
+    for (int l = 0; l < level; l++) {
+        capacity *= LSM_LEVEL_RATIO;
+    }
+    return capacity;
+}
+
+// Records are keyed by their own timestamp field
+void LSMTree::insert(long timestamp, const VitalRecord& record) {
+    std::lock_guard<std::mutex> lock(treeMutex);
+    
+    char buffer[64];
+    record.encode(buffer);
+    walFile.write(buffer, VitalRecord::getDiskSize());
+    walFile.flush();
+    
+    memtable.insert(std::make_pair(record.timestamp, record));
+    totalRecords++;
+    
+    if (static_cast<int>(memtable.size()) >= LSM_MEMTABLE_LIMIT) {
+        flushMemtable();
+    }
+}
+
+// Called with treeMutex held
+void LSMTree::flushMemtable() {
+    int runID = nextRunID++;
+    LSMRunWriter writer(runID, 0, runFilePath(runID), memtable.size());
+    for (const auto& entry : memtable) {
+        writer.append(entry.second);
+    }
+    
+    runs.insert(runs.begin(), writer.finish());
+    flushedRecords += memtable.size();
+    memtable.clear();
+    saveManifest();
+    
+    // Everything in the WAL is now covered by the new run
+    walFile.close();
+    walFile.open(walFilePath, std::ios::binary | std::ios::trunc);
+    
+    compactionSignal.notify_one();
+}
+
+void LSMTree::replayWal() {
+    std::ifstream file(walFilePath, std::ios::binary);
+    if (!file.is_open()) return;
+    
+    const long recordSize = VitalRecord::getDiskSize();
+    char buffer[64];
+    int replayed = 0;
+    
+    while (file.read(buffer, recordSize)) {
+        VitalRecord record;
+        record.decode(buffer);
+        memtable.insert(std::make_pair(record.timestamp, record));
+        replayed++;
+    }
+    file.close();
+    
+    totalRecords += replayed;
+    if (replayed > 0) {
+        std::cout << "[LSM] Replayed " << replayed << " records from WAL" << std::endl;
+    }
+}
+
+void LSMTree::saveManifest() {
+    std::string tempPath = manifestFilePath + ".tmp";
+    std::ofstream file(tempPath, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "[LSM] Error: Cannot write manifest" << std::endl;
+        return;
+    }
+    
+    int runCount = runs.size();
+    file.write(reinterpret_cast<const char*>(&nextRunID), sizeof(nextRunID));
+    file.write(reinterpret_cast<const char*>(&flushedRecords), sizeof(flushedRecords));
+    file.write(reinterpret_cast<const char*>(&runCount), sizeof(runCount));
+    for (const auto& run : runs) {
+        file.write(reinterpret_cast<const char*>(&run->runID), sizeof(run->runID));
+        file.write(reinterpret_cast<const char*>(&run->level), sizeof(run->level));
+    }
+    file.close();
+    
+    // Replace atomically so a crash never leaves a half-written manifest
+    std::rename(tempPath.c_str(), manifestFilePath.c_str());
+}
+
+void LSMTree::loadManifest() {
+    std::ifstream file(manifestFilePath, std::ios::binary);
+    if (!file.is_open()) return;
+    
+    int runCount = 0;
+    file.read(reinterpret_cast<char*>(&nextRunID), sizeof(nextRunID));
+    file.read(reinterpret_cast<char*>(&flushedRecords), sizeof(flushedRecords));
+    file.read(reinterpret_cast<char*>(&runCount), sizeof(runCount));
+    
+    for (int i = 0; i < runCount; i++) {
+        int runID, level;
+        file.read(reinterpret_cast<char*>(&runID), sizeof(runID));
+        file.read(reinterpret_cast<char*>(&level), sizeof(level));
+        if (!file) break;
+        
+        std::shared_ptr<LSMRun> run(new LSMRun(runID, level, runFilePath(runID)));
+        if (run->loadFooter()) {
+            runs.push_back(run);
+        } else {
+            std::cerr << "[LSM] Warning: Skipping unreadable run " << run->filePath << std::endl;
+        }
+    }
+    file.close();
+    
+    totalRecords = flushedRecords;
+}
+
+// ==================== Compaction ====================
+
+void LSMTree::compactionLoop() {
+    std::unique_lock<std::mutex> lock(treeMutex);
+    
+    while (true) {
+        std::vector<std::shared_ptr<LSMRun>> inputs;
+        int outputLevel = 0;
+        
+        while (!stopCompaction && !pickCompaction(inputs, outputLevel)) {
+            compactionSignal.wait(lock);
+        }
+        if (stopCompaction) break;
+        
+        compacting = true;
+        int runID = nextRunID++;
+        
+        // Merge without holding the lock; inputs are immutable
+        lock.unlock();
+        std::shared_ptr<LSMRun> output = mergeRuns(inputs, outputLevel, runID);
+        lock.lock();
+        
+        for (const auto& input : inputs) {
+            runs.erase(std::remove(runs.begin(), runs.end(), input), runs.end());
+            input->obsolete = true;
+        }
+        if (output) {
+            runs.push_back(output);
+        }
+        
+        // Keep runs ordered by level, newest first within a level
+        std::stable_sort(runs.begin(), runs.end(),
+                         [](const std::shared_ptr<LSMRun>& a, const std::shared_ptr<LSMRun>& b) {
+                             if (a->level != b->level) return a->level < b->level;
+                             return a->runID > b->runID;
+                         });
+        saveManifest();
+        
+        compacting = false;
+        compactionIdle.notify_all();
+    }
+    
+    compacting = false;
+    compactionIdle.notify_all();
+}
+
+// Called with treeMutex held. Level 0 is merged into level 1 once it has
+// LSM_L0_RUN_LIMIT runs; any deeper level over capacity is merged into
+// the next one.
+bool LSMTree::pickCompaction(std::vector<std::shared_ptr<LSMRun>>& inputs, int& outputLevel) {
+    std::vector<std::vector<std::shared_ptr<LSMRun>>> levels(LSM_MAX_LEVELS);
+    for (const auto& run : runs) {
+        levels[std::min(run->level, LSM_MAX_LEVELS - 1)].push_back(run);
+    }
+    
+    inputs.clear();
+    
+    if (static_cast<int>(levels[0].size()) >= LSM_L0_RUN_LIMIT) {
+        inputs = levels[0];
+        inputs.insert(inputs.end(), levels[1].begin(), levels[1].end());
+        outputLevel = 1;
+        return true;
+    }
+    
+    for (int level = 1; level < LSM_MAX_LEVELS - 1; level++) {
+        long size = 0;
+        for (const auto& run : levels[level]) {
+            size += run->recordCount;
+        }
+        
+        if (size > levelCapacity(level)) {
+            inputs = levels[level];
+            inputs.insert(inputs.end(), levels[level + 1].begin(), levels[level + 1].end());
+            outputLevel = level + 1;
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+// K-way merge of sorted runs into one new run
+std::shared_ptr<LSMRun> LSMTree::mergeRuns(const std::vector<std::shared_ptr<LSMRun>>& inputs,
+                                           int outputLevel, int runID) {
+    int expected = 0;
+    std::vector<std::unique_ptr<LSMRunScanner>> scanners;
+    for (const auto& input : inputs) {
+        expected += input->recordCount;
+        scanners.push_back(std::unique_ptr<LSMRunScanner>(new LSMRunScanner(input, 0)));
+    }
+    
+    typedef std::pair<long, int> HeapEntry;
+    std::priority_queue<HeapEntry, std::vector<HeapEntry>, std::greater<HeapEntry>> heap;
+    for (size_t i = 0; i < scanners.size(); i++) {
+        if (scanners[i]->valid()) {
+            heap.push(HeapEntry(scanners[i]->currentKey(), i));
+        }
+    }
+    
+    LSMRunWriter writer(runID, outputLevel, runFilePath(runID), expected);
+    while (!heap.empty()) {
+        int source = heap.top().second;
+        heap.pop();
+        
+        VitalRecord record;
+        record.decodeFields(scanners[source]->current(), VitalQuery::allFields());
+        writer.append(record);
+        
+        scanners[source]->next();
+        if (scanners[source]->valid()) {
+            heap.push(HeapEntry(scanners[source]->currentKey(), source));
+        }
+    }
+    
+    std::shared_ptr<LSMRun> output = writer.finish();
+    std::cout << "[LSM] Compacted " << inputs.size() << " runs into level "
+              << outputLevel << " (" << output->recordCount << " records)" << std::endl;
+    return output;
+}
+
+void LSMTree::flush() {
+    std::lock_guard<std::mutex> lock(treeMutex);
+    if (!memtable.empty()) {
+        flushMemtable();
+    }
+}
+
+void LSMTree::waitForCompaction() {
+    std::unique_lock<std::mutex> lock(treeMutex);
+    compactionIdle.wait(lock, [this]() {
+        std::vector<std::shared_ptr<LSMRun>> inputs;
+        int outputLevel;
+        return stopCompaction || (!compacting && !pickCompaction(inputs, outputLevel));
+    });
+}
+
+// ==================== Queries ====================
+
+// Called with treeMutex held
+void LSMTree::collectMemtable(long startTime, long endTime, std::vector<VitalRecord>& out) const {
+    auto it = memtable.lower_bound(startTime);
+    auto end = memtable.upper_bound(endTime);
+    for (; it != end; ++it) {
+        out.push_back(it->second);
+    }
+}
+
+VitalRecord* LSMTree::search(long timestamp) {
+    std::vector<std::shared_ptr<LSMRun>> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(treeMutex);
+        auto it = memtable.find(timestamp);
+        if (it != memtable.end()) {
+            return new VitalRecord(it->second);
+        }
+        snapshot = runs;
+    }
+    
+    for (const auto& run : snapshot) {
+        if (!run->overlaps(timestamp, timestamp) || !run->keyFilter.mightContain(timestamp)) {
+            continue;
+        }
+        
+        LSMRunScanner scanner(run, run->findBlock(timestamp));
+        while (scanner.valid() && scanner.currentKey() <= timestamp) {
+            if (scanner.currentKey() == timestamp) {
+                VitalRecord* record = new VitalRecord();
+                record->decodeFields(scanner.current(), VitalQuery::allFields());
+                return record;
+            }
+            scanner.next();
+        }
+    }
+    
+    return nullptr;
+}
+
+std::vector<VitalRecord> LSMTree::rangeQuery(long startTime, long endTime) {
+    return rangeQuery(startTime, endTime, VitalQuery());
+}
+
+std::vector<VitalRecord> LSMTree::rangeQuery(long startTime, long endTime, const VitalQuery& query) {
+    std::vector<VitalRecord> results;
+    std::vector<VitalRecord> buffered;
+    std::vector<std::shared_ptr<LSMRun>> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(treeMutex);
+        collectMemtable(startTime, endTime, buffered);
+        snapshot = runs;
+    }
+    
+    char raw[64];
+    for (const auto& record : buffered) {
+        record.encode(raw);
+        if (query.matchesEncoded(raw)) {
+            VitalRecord projected;
+            projected.decodeFields(raw, query.fieldMask);
+            results.push_back(projected);
+        }
+    }
+    
+    for (const auto& run : snapshot) {
+        if (!run->overlaps(startTime, endTime) || !run->mayContainPatients(query.predicates)) continue;
+        
+        LSMRunScanner scanner(run, run->findBlock(startTime), &query.predicates);
+        for (; scanner.valid(); scanner.next()) {
+            long key = scanner.currentKey();
+            if (key > endTime) break;
+            if (key < startTime || !query.matchesEncoded(scanner.current())) continue;
+            
+            VitalRecord record;
+            record.decodeFields(scanner.current(), query.fieldMask);
+            results.push_back(record);
+        }
+    }
+    
+    sortByTimestamp(results);
+    return results;
+}
+
+// Merges the memtable and every run backwards from endTime, newest key
+// first, until `count` matches were found
+std::vector<VitalRecord> LSMTree::latestRecords(long startTime, long endTime, int count,
+                                                const VitalQuery& query) {
+    std::vector<VitalRecord> results;
+    if (count <= 0) return results;
+    
+    std::vector<VitalRecord> buffered;
+    std::vector<std::shared_ptr<LSMRun>> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(treeMutex);
+        collectMemtable(startTime, endTime, buffered);
+        snapshot = runs;
+    }
+    
+    std::vector<std::unique_ptr<LSMRunReverseScanner>> scanners;
+    for (const auto& run : snapshot) {
+        if (run->overlaps(startTime, endTime) && run->mayContainPatients(query.predicates)) {
+            scanners.push_back(std::unique_ptr<LSMRunReverseScanner>(
+                new LSMRunReverseScanner(run, endTime, &query.predicates)));
+        }
+    }
+    
+    // Source index scanners.size() stands for the memtable
+    const int memSource = scanners.size();
+    int memPosition = buffered.size() - 1;
+    
+    typedef std::pair<long, int> HeapEntry;
+    std::priority_queue<HeapEntry> heap;
+    for (size_t i = 0; i < scanners.size(); i++) {
+        if (scanners[i]->valid()) heap.push(HeapEntry(scanners[i]->currentKey(), i));
+    }
+    if (memPosition >= 0) heap.push(HeapEntry(buffered[memPosition].timestamp, memSource));
+    
+    char raw[64];
+    while (!heap.empty() && static_cast<int>(results.size()) < count) {
+        long key = heap.top().first;
+        int source = heap.top().second;
+        heap.pop();
+        if (key < startTime) break;
+        
+        const char* current;
+        if (source == memSource) {
+            buffered[memPosition].encode(raw);
+            current = raw;
+        } else {
+            current = scanners[source]->current();
+        }
+        
+        if (query.matchesEncoded(current)) {
+            VitalRecord record;
+            record.decodeFields(current, query.fieldMask);
+            results.push_back(record);
+        }
+        
+        if (source == memSource) {
+            if (--memPosition >= 0) heap.push(HeapEntry(buffered[memPosition].timestamp, memSource));
+        } else {
+            scanners[source]->prev();
+            if (scanners[source]->valid()) heap.push(HeapEntry(scanners[source]->currentKey(), source));
+        }
+    }
+    
+    std::reverse(results.begin(), results.end());
+    return results;
+}
+
+// Uses the per-block zone maps stored in each run footer
+std::vector<VitalRecord> LSMTree::scanWhere(long startTime, long endTime,
+                                           const std::vector<VitalPredicate>& predicates,
+                                           ZoneScanStats* stats) {
+    std::vector<VitalRecord> results;
+    std::vector<VitalRecord> buffered;
+    std::vector<std::shared_ptr<LSMRun>> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(treeMutex);
+        collectMemtable(startTime, endTime, buffered);
+        snapshot = runs;
+    }
+    
+    VitalQuery query;
+    query.predicates = predicates;
+    
+    for (const auto& record : buffered) {
+        if (query.matches(record)) {
+            results.push_back(record);
+        }
+    }
+    
+    ZoneScanStats local;
+    std::vector<char> block;
+    for (const auto& run : snapshot) {
+        local.blocksTotal += run->getBlockCount();
+        if (!run->overlaps(startTime, endTime) || !run->mayContainPatients(predicates)) continue;
+        
+        std::ifstream file(run->filePath, std::ios::binary);
+        for (int b = 0; b < run->getBlockCount(); b++) {
+            const VitalZone& zone = run->blockZones[b];
+            if (!zone.overlapsTime(startTime, endTime) || !zone.mayMatchAll(predicates)) continue;
+            if (!run->readBlock(file, b, block)) continue;
+            local.blocksScanned++;
+            
+            for (int i = 0; i < run->getBlockRecords(b); i++) {
+                const char* raw = block.data() + i * VitalRecord::getDiskSize();
+                long key = rawKey(raw);
+                if (key < startTime || key > endTime || !query.matchesEncoded(raw)) continue;
+                
+                VitalRecord record;
+                record.decodeFields(raw, VitalQuery::allFields());
+                results.push_back(record);
+            }
+        }
+    }
+    
+    if (stats) *stats = local;
+    sortByTimestamp(results);
+    return results;
+}
+
+int LSMTree::getRecordCount() const {
+    std::lock_guard<std::mutex> lock(treeMutex);
+    return totalRecords;
+}
+
+int LSMTree::getRunCount() const {
+    std::lock_guard<std::mutex> lock(treeMutex);
+    return runs.size();
+}
+
+int LSMTree::getRunCount(int level) const {
+    std::lock_guard<std::mutex> lock(treeMutex);
+    int count = 0;
+    for (const auto& run : runs) {
+        if (run->level == level) count++;
+    }
+    return count;
+}
@@ -0,0 +1,149 @@
+#ifndef LSM_TREE_H
+#define LSM_TREE_H
+
+#include <vector>
+#include <string>
+#include <map>
+#include <memory>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "../models/vital_record.h"
+#include "storage_engine.h"
+#include "bloom_filter.h"
+#include "zone_map.h"
+
+// Records buffered in the memtable before it is flushed to a level-0 run
+const int LSM_MEMTABLE_LIMIT = 4096;
+// Records per block inside a run (unit of fence keys and zone maps)
+const int LSM_BLOCK_RECORDS = 128;
+// Level-0 runs allowed before they are merged into level 1
+const int LSM_L0_RUN_LIMIT = 4;
+// Capacity ratio between adjacent levels (L1 holds one run)
+const int LSM_LEVEL_RATIO = 10;
+const int LSM_MAX_LEVELS = 8;
+// Distinct patients a run's patient filter is sized for
+const int LSM_PATIENT_FILTER_ITEMS = 1024;
+
+// Immutable sorted run file:
+//   [records][block first keys][block zone maps][key bloom filter]
+//   [patient bloom filter][trailer]
+struct LSMRun {
+    int runID;
+    int level;
+    std::string filePath;
+    int recordCount;
+    long minKey;
+    long maxKey;
+    std::vector<long> blockFirstKeys;
+    std::vector<VitalZone> blockZones;
+    BloomFilter keyFilter;
+    BloomFilter patientFilter;
+    
+    // Set once compaction replaced this run; the file is removed when the
+    // last reader drops its reference
+    bool obsolete;
+    
+    LSMRun(int id, int lvl, const std::string& path);
+    ~LSMRun();
+    
+    int getBlockCount() const { return blockFirstKeys.size(); }
+    int getBlockRecords(int block) const;
+    bool overlaps(long startTime, long endTime) const;
+    
+    // False if a patientID equality predicate names a patient the run's
+    // filter has never seen
+    bool mayContainPatients(const std::vector<VitalPredicate>& predicates) const;
+    
+    // First block that can hold keys >= key
+    int findBlock(long key) const;
+    bool readBlock(std::ifstream& file, int block, std::vector<char>& buffer) const;
+    
+    bool loadFooter();
+};
+
+// Streams sorted records into a new run file
+class LSMRunWriter {
+private:
+    std::shared_ptr<LSMRun> run;
+    std::ofstream file;
+    VitalZone currentZone;
+    std::vector<long> keys;
+    char buffer[64];
+
+public:
+    LSMRunWriter(int runID, int level, const std::string& path, int expectedRecords);
+    
+    void append(const VitalRecord& record);
+    std::shared_ptr<LSMRun> finish();
+};
+
+// Log-structured merge tree keyed by timestamp. Inserts go to a WAL and an
+// in-memory memtable; full memtables become sorted level-0 runs, and a
+// background thread merges runs level by level.
+class LSMTree : public VitalStorageEngine {
+private:
+    std::string basePath;
+    std::string walFilePath;
+    std::string manifestFilePath;
+    
+    std::multimap<long, VitalRecord> memtable;
+    std::ofstream walFile;
+    
+    std::vector<std::shared_ptr<LSMRun>> runs;  // all levels, newest first
+    int nextRunID;
+    int totalRecords;
+    int flushedRecords;
+    
+    mutable std::mutex treeMutex;
+    std::condition_variable compactionSignal;
+    std::thread compactionThread;
+    bool stopCompaction;
+    bool compacting;
+    std::condition_variable compactionIdle;
+    
+    std::string runFilePath(int runID) const;
+    
+    void flushMemtable();
+    void replayWal();
+    void saveManifest();
+    void loadManifest();
+    
+    // Compaction
+    void compactionLoop();
+    bool pickCompaction(std::vector<std::shared_ptr<LSMRun>>& inputs, int& outputLevel);
+    std::shared_ptr<LSMRun> mergeRuns(const std::vector<std::shared_ptr<LSMRun>>& inputs,
+                                      int outputLevel, int runID);
+    static long levelCapacity(int level);
+    
+    // Snapshot helpers (called with treeMutex held)
+    void collectMemtable(long startTime, long endTime, std::vector<VitalRecord>& out) const;
+
+public:
+    LSMTree(const std::string& basePath);
+    ~LSMTree();
+    
+    void insert(long timestamp, const VitalRecord& record) override;
+    VitalRecord* search(long timestamp) override;
+    std::vector<VitalRecord> rangeQuery(long startTime, long endTime) override;
+    std::vector<VitalRecord> rangeQuery(long startTime, long endTime,
+                                        const VitalQuery& query) override;
+    std::vector<VitalRecord> latestRecords(long startTime, long endTime, int count,
+                                           const VitalQuery& query) override;
+    std::vector<VitalRecord> scanWhere(long startTime, long endTime,
+                                       const std::vector<VitalPredicate>& predicates,
+                                       ZoneScanStats* stats = nullptr) override;
+    
+    int getRecordCount() const override;
+    std::string getEngineName() const override { return "lsm"; }
+    
+    // Flush the memtable and block until no compaction is pending
+    void flush();
+    void waitForCompaction();
+    
+    int getRunCount() const;
+    int getRunCount(int level) const;
+};
+
+#endif
@@ -0,0 +1,184 @@
+#include "patient_index.h"
+#include "../models/vital_record.h"
+#include <iostream>
+#include <algorithm>
+
+PatientIndex::PatientIndex(const std::string& filePath)
+    : filePath(filePath), entryCount(0) {
+    loadFromDisk();
+}
+
+size_t PatientIndex::getEntrySize() {
+    return sizeof(int) + sizeof(long) * 2;
+}
+
+void PatientIndex::addToMemory(int patientID, const PatientIndexEntry& entry) {
+    std::vector<PatientIndexEntry>& list = entries[patientID];
+    
+    // Readings normally arrive in time order; late ones are slotted in
+    // after any entries with the same timestamp
+    if (list.empty() || list.back().timestamp <= entry.timestamp) {
+        list.push_back(entry);
+    } else {
+        auto it = std::upper_bound(list.begin(), list.end(), entry.timestamp,
+                                   [](long ts, const PatientIndexEntry& e) {
+                                       return ts < e.timestamp;
+                                   });
+        list.insert(it, entry);
+    }
+    entryCount++;
+}
+
+void PatientIndex::appendToLog(int patientID, const PatientIndexEntry& entry) {
+    std::ofstream file(filePath, std::ios::binary | std::ios::app);
+    if (!file.is_open()) {
+        std::cerr << "[PATIENT-INDEX] Error: Cannot open file for writing: " << filePath << std::endl;
+        return;
+    }
+    
+    file.write(reinterpret_cast<const char*>(&patientID), sizeof(patientID));
+    file.write(reinterpret_cast<const char*>(&entry.timestamp), sizeof(entry.timestamp));
+    file.write(reinterpret_cast<const char*>(&entry.dataPosition), sizeof(entry.dataPosition));
+    file.close();
+}
+
+void PatientIndex::add(int patientID, long timestamp, long dataPosition) {
+    PatientIndexEntry entry = {timestamp, dataPosition};
+    addToMemory(patientID, entry);
+    appendToLog(patientID, entry);
+}
+
+std::vector<PatientIndexEntry> PatientIndex::lookup(int patientID, long startTime, long endTime) const {
+    std::vector<PatientIndexEntry> results;
+    
+    auto found = entries.find(patientID);
+    if (found == entries.end()) return results;
+    
+    const std::vector<PatientIndexEntry>& list = found->second;
+    auto first = std::lower_bound(list.begin(), list.end(), startTime,
+                                  [](const PatientIndexEntry& e, long ts) {
+                                      return e.timestamp < ts;
+                                  });
+    auto last = std::upper_bound(first, list.end(), endTime,
+                                 [](long ts, const PatientIndexEntry& e) {
+                                     return ts < e.timestamp;
+                                 });
+    
+    results.assign(first, last);
+    return results;
+}
+
+// Forget entries at or beyond a data position and rewrite the log
+void PatientIndex::dropFrom(long dataPosition) {
+    int dropped = 0;
+    for (auto it = entries.begin(); it != entries.end();) {
+        std::vector<PatientIndexEntry>& list = it->second;
+        size_t before = list.size();
+        list.erase(std::remove_if(list.begin(), list.end(),
+                                  [dataPosition](const PatientIndexEntry& e) {
+                                      return e.dataPosition >= dataPosition;
+                                  }),
+                   list.end());
+        dropped += before - list.size();
+        it = list.empty() ? entries.erase(it) : std::next(it);
+    }
+    entryCount -= dropped;
+    saveToDisk();
+    
+    std::cout << "[PATIENT-INDEX] Dropped " << dropped
+              << " entries for uncommitted records" << std::endl;
+}
+
+void PatientIndex::catchUp(const std::string& dataFilePath, int totalRecords) {
+    long recordSize = VitalRecord::getDiskSize();
+    if (entryCount > totalRecords) {
+        dropFrom(static_cast<long>(totalRecords) * recordSize);
+    }
+    if (entryCount >= totalRecords) return;
+    
+    std::ifstream file(dataFilePath, std::ios::binary);
+    if (!file.is_open()) return;
+    
+    int firstRecord = entryCount;
+    file.seekg(static_cast<long>(firstRecord) * recordSize);
+    
+    for (long i = firstRecord; i < totalRecords; i++) {
+        VitalRecord record;
+        record.readFromDisk(file);
+        if (!file) break;
+        add(record.patientID, record.timestamp, i * recordSize);
+    }
+    
+    file.close();
+    std::cout << "[PATIENT-INDEX] Indexed " << (entryCount - firstRecord)
+              << " records missing from the log" << std::endl;
+}
+
+void PatientIndex::clear() {
+    entries.clear();
+    entryCount = 0;
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    file.close();
+}
+
+// Rewrites the log in data-file order
+void PatientIndex::saveToDisk() {
+    struct LogEntry {
+        int patientID;
+        PatientIndexEntry entry;
+    };
+    
+    std::vector<LogEntry> log;
+    log.reserve(entryCount);
+    for (const auto& patient : entries) {
+        for (const auto& entry : patient.second) {
+            LogEntry item = {patient.first, entry};
+            log.push_back(item);
+        }
+    }
+    std::sort(log.begin(), log.end(), [](const LogEntry& a, const LogEntry& b) {
+        return a.entry.dataPosition < b.entry.dataPosition;
+    });
+    
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "[PATIENT-INDEX] Error: Cannot open file for writing: " << filePath << std::endl;
+        return;
+    }
+    
+    for (const auto& item : log) {
+        file.write(reinterpret_cast<const char*>(&item.patientID), sizeof(item.patientID));
+        file.write(reinterpret_cast<const char*>(&item.entry.timestamp), sizeof(item.entry.timestamp));
+        file.write(reinterpret_cast<const char*>(&item.entry.dataPosition), sizeof(item.entry.dataPosition));
+    }
+    file.close();
+}
+
+void PatientIndex::loadFromDisk() {
+    entries.clear();
+    entryCount = 0;
+    
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open()) return;
+    
+    file.seekg(0, std::ios::end);
+    long fileSize = file.tellg();
+    file.seekg(0);
+    
+    long complete = fileSize / getEntrySize();
+    for (long i = 0; i < complete; i++) {
+        int patientID;
+        PatientIndexEntry entry;
+        file.read(reinterpret_cast<char*>(&patientID), sizeof(patientID));
+        file.read(reinterpret_cast<char*>(&entry.timestamp), sizeof(entry.timestamp));
+        file.read(reinterpret_cast<char*>(&entry.dataPosition), sizeof(entry.dataPosition));
+        if (!file) break;
+        addToMemory(patientID, entry);
+    }
+    file.close();
+    
+    // Drop an entry torn by a crash mid-append so new entries stay aligned
+    if (fileSize % static_cast<long>(getEntrySize()) != 0) {
+        saveToDisk();
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef PATIENT_INDEX_H
+#define PATIENT_INDEX_H
+
+#include <vector>
+#include <string>
+#include <map>
+#include <fstream>
+
+// One reading of a patient: where its record lives in the vitals data file
+struct PatientIndexEntry {
+    long timestamp;
+    long dataPosition;
+};
+
+// Secondary index patientID -> that patient's readings ordered by
+// timestamp. Persisted as an append-only log of (patientID, timestamp,
+// dataPosition) entries in data-file order, one entry per insert.
+class PatientIndex {
+private:
+    std::map<int, std::vector<PatientIndexEntry>> entries;
+    std::string filePath;
+    int entryCount;
+    
+    static size_t getEntrySize();
+    void addToMemory(int patientID, const PatientIndexEntry& entry);
+    void appendToLog(int patientID, const PatientIndexEntry& entry);
+    void dropFrom(long dataPosition);
+
+public:
+    PatientIndex(const std::string& filePath);
+    
+    void add(int patientID, long timestamp, long dataPosition);
+    
+    // The patient's entries with timestamp in [startTime, endTime], oldest first
+    std::vector<PatientIndexEntry> lookup(int patientID, long startTime, long endTime) const;
+    
+    int getPatientCount() const { return entries.size(); }
+    int getEntryCount() const { return entryCount; }
+    
+    // Reconcile the log with the data file's committed records: drop
+    // entries past the last one (their positions will be reused) and index
+    // records appended after the last logged entry
+    void catchUp(const std::string& dataFilePath, int totalRecords);
+    void clear();
+    
+    // Disk persistence
+    void saveToDisk();
+    void loadFromDisk();
+};
+
+#endif
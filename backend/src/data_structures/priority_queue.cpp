@@ -1,86 +1,610 @@
 #include "priority_queue.h"
 #include <algorithm>
 #include <iomanip>
+#include <cstdio>
 
-PriorityQueue::PriorityQueue(const std::string& filePath) 
-    : dataFilePath(filePath) {
+// Stale handles tolerated in a level before it is rebuilt without them
+const size_t PQ_STALE_SLACK = 64;
+
+PriorityQueue::PriorityQueue(const std::string& filePath)
+    : nextStamp(1), nonEmpty(0), count(0), maxIssuedID(0), dataFilePath(filePath), coalesceWindow(0) {
     if (!dataFilePath.empty()) {
         loadFromDisk();
+        
+        // Snapshot plus journal is the state at the last acknowledged
+        // mutation; fold them together so the journal starts empty
+        journal.reset(new AlertJournal(dataFilePath + ".journal"));
+        std::lock_guard<std::mutex> lock(queueMutex);
+        int replayed = AlertJournal::replay(journal->getFilePath(), [this](const JournalEntry& entry) {
+            applyEntry(entry);
+        });
+        if (replayed > 0) {
+            std::cout << "[PQ] Replayed " << replayed << " journal entries ("
+                      << count << " alerts)" << std::endl;
+        }
+        std::ifstream existing(journal->getFilePath(), std::ios::binary | std::ios::ate);
+        if (existing.is_open() && existing.tellg() > 0) {
+            existing.close();
+            if (writeSnapshot()) {
+                journal->truncate();
+            }
+        }
+        journal->open();
     }
 }
 
+// Every mutation is already journaled, so shutdown only closes the file
 PriorityQueue::~PriorityQueue() {
-    if (!dataFilePath.empty()) {
-        saveToDisk();
+    if (journal) {
+        journal->close();
+    }
+}
+
+std::string AlertCursor::toString() const {
+    if (!valid) return "";
+    return std::to_string(level) + "." + std::to_string(timestamp) + "." + std::to_string(stamp);
+}
+
+bool AlertCursor::parse(const std::string& text, AlertCursor& cursor) {
+    int level;
+    long timestamp;
+    unsigned int stamp;
+    char trailing;
+    if (std::sscanf(text.c_str(), "%d.%ld.%u%c", &level, &timestamp, &stamp, &trailing) != 3 ||
+        level < 0 || level >= PQ_LEVELS) {
+        return false;
+    }
+    cursor.valid = true;
+    cursor.level = level;
+    cursor.timestamp = timestamp;
+    cursor.stamp = stamp;
+    return true;
+}
+
+// Out-of-range priorities are clamped into the nearest level
+int PriorityQueue::levelOf(AlertPriority priority) {
+    int level = static_cast<int>(priority) - 1;
+    return std::min(std::max(level, 0), PQ_LEVELS - 1);
+}
+
+// Order within a level: older first, then arrival order
+bool PriorityQueue::before(const AlertHandle& a, const AlertHandle& b) {
+    if (a.timestamp != b.timestamp) {
+        return a.timestamp < b.timestamp;
+    }
+    return a.stamp < b.stamp;
+}
+
+void PriorityQueue::siftUp(std::vector<AlertHandle>& heap, size_t index) {
+    AlertHandle moving = heap[index];
+    while (index > 0) {
+        size_t parent = (index - 1) / 4;
+        if (!before(moving, heap[parent])) break;
+        heap[index] = heap[parent];
+        index = parent;
+    }
+    heap[index] = moving;
+}
+
+void PriorityQueue::siftDown(std::vector<AlertHandle>& heap, size_t index) {
+    AlertHandle moving = heap[index];
+    size_t n = heap.size();
+    while (true) {
+        size_t first = 4 * index + 1;
+        if (first >= n) break;
+        
+        size_t best = first;
+        size_t last = std::min(first + 4, n);
+        for (size_t child = first + 1; child < last; child++) {
+            if (before(heap[child], heap[best])) best = child;
+        }
+        if (!before(heap[best], moving)) break;
+        
+        heap[index] = heap[best];
+        index = best;
+    }
+    heap[index] = moving;
+}
+
+void PriorityQueue::popHeap(std::vector<AlertHandle>& heap) {
+    heap.front() = heap.back();
+    heap.pop_back();
+    if (!heap.empty()) {
+        siftDown(heap, 0);
+    }
+}
+
+// Earliest live handle of a level; call settle() first so both heads
+// are live
+bool PriorityQueue::head(int level, AlertHandle& handle, bool& fromLate) const {
+    const Level& lv = levels[level];
+    if (lv.live == 0) return false;
+    
+    fromLate = lv.fifo.empty() || (!lv.late.empty() && before(lv.late.front(), lv.fifo.front()));
+    handle = fromLate ? lv.late.front() : lv.fifo.front();
+    return true;
+}
+
+// Live handles of one level in extraction order
+std::vector<AlertHandle> PriorityQueue::orderedHandles(int level) const {
+    const Level& lv = levels[level];
+    std::vector<AlertHandle> inOrder, late;
+    for (const auto& handle : lv.fifo) {
+        if (isLive(handle)) inOrder.push_back(handle);
+    }
+    for (const auto& handle : lv.late) {
+        if (isLive(handle)) late.push_back(handle);
+    }
+    std::sort(late.begin(), late.end(), before);
+    
+    std::vector<AlertHandle> merged(inOrder.size() + late.size());
+    std::merge(inOrder.begin(), inOrder.end(), late.begin(), late.end(), merged.begin(), before);
+    return merged;
+}
+
+// Visit a level's live handles in extraction order, starting after
+// `after` if given, until `visit` returns false (then returns false).
+// The FIFO is sorted, so the start is a binary search; the late heap is
+// read lazily through a frontier of its smallest unvisited nodes, so
+// stopping after k handles costs O(k log k) rather than sorting the level.
+bool PriorityQueue::walkLevel(int level, const AlertHandle* after,
+                              const std::function<bool(const AlertHandle&)>& visit) const {
+    const Level& lv = levels[level];
+    if (lv.live == 0) return true;
+    
+    size_t next = 0;
+    if (after) {
+        next = std::upper_bound(lv.fifo.begin(), lv.fifo.end(), *after, before) - lv.fifo.begin();
+    }
+    
+    const std::vector<AlertHandle>& late = lv.late;
+    auto later = [&late](size_t a, size_t b) { return before(late[b], late[a]); };
+    std::vector<size_t> frontier;
+    if (!late.empty()) frontier.push_back(0);
+    
+    // Next live late handle past `after`; skipped nodes still open their
+    // children, which may sort after it
+    AlertHandle lateHead;
+    auto advanceLate = [&]() -> bool {
+        while (!frontier.empty()) {
+            std::pop_heap(frontier.begin(), frontier.end(), later);
+            size_t index = frontier.back();
+            frontier.pop_back();
+            for (size_t child = 4 * index + 1; child <= 4 * index + 4 && child < late.size(); child++) {
+                frontier.push_back(child);
+                std::push_heap(frontier.begin(), frontier.end(), later);
+            }
+            
+            const AlertHandle& handle = late[index];
+            if (!isLive(handle) || (after && !before(*after, handle))) continue;
+            lateHead = handle;
+            return true;
+        }
+        return false;
+    };
+    bool haveLate = advanceLate();
+    
+    while (true) {
+        while (next < lv.fifo.size() && !isLive(lv.fifo[next])) next++;
+        bool haveFifo = next < lv.fifo.size();
+        if (!haveFifo && !haveLate) return true;
+        
+        AlertHandle handle;
+        if (haveLate && (!haveFifo || before(lateHead, lv.fifo[next]))) {
+            handle = lateHead;
+            haveLate = advanceLate();
+        } else {
+            handle = lv.fifo[next++];
+        }
+        if (!visit(handle)) return false;
+    }
+}
+
+// Give the slot a fresh stamp and queue a handle for it on its level.
+// Any earlier handle for the slot goes stale.
+void PriorityQueue::place(int slot) {
+    SlabEntry& entry = slab[slot];
+    if (nextStamp == 0) nextStamp = 1;
+    entry.stamp = nextStamp++;
+    entry.level = levelOf(entry.alert.priority);
+    
+    AlertHandle handle = {entry.alert.timestamp, slot, entry.stamp};
+    Level& lv = levels[entry.level];
+    if (lv.fifo.empty() || !before(handle, lv.fifo.back())) {
+        lv.fifo.push_back(handle);
+    } else {
+        lv.late.push_back(handle);
+        siftUp(lv.late, lv.late.size() - 1);
+    }
+    
+    lv.live++;
+    nonEmpty |= 1u << entry.level;
+    count++;
+}
+
+void PriorityQueue::push(const Alert& alert) {
+    int slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+        slab[slot].alert = alert;
+    } else {
+        slot = slab.size();
+        SlabEntry entry = {alert, 0, 0};
+        slab.push_back(entry);
+    }
+    positions[alert.alertID] = slot;
+    place(slot);
+    indexSlot(slot);
+    
+    // Keep the most recently seen alert of each kind as the merge target
+    if (alert.type != CUSTOM) {
+        long long key = coalesceKey(alert);
+        auto indexed = coalesceIndex.find(key);
+        if (indexed == coalesceIndex.end() || !positions.count(indexed->second) ||
+            slab[positions[indexed->second]].alert.getLastSeenTime() <= alert.getLastSeenTime()) {
+            coalesceIndex[key] = alert.alertID;
+        }
+    }
+}
+
+// Drop the slot's alert from the ID and secondary indexes and, if it is
+// the merge target for its kind, from the coalescing index
+void PriorityQueue::forget(int slot) {
+    const Alert& alert = slab[slot].alert;
+    unindexSlot(slot);
+    positions.erase(alert.alertID);
+    auto indexed = coalesceIndex.find(coalesceKey(alert));
+    if (indexed != coalesceIndex.end() && indexed->second == alert.alertID) {
+        coalesceIndex.erase(indexed);
+    }
+    
+    auto merged = aliasesOf.find(alert.alertID);
+    if (merged != aliasesOf.end()) {
+        for (int repeatID : merged->second) {
+            aliases.erase(repeatID);
+        }
+        aliasesOf.erase(merged);
+    }
+}
+
+// Called with queueMutex held
+void PriorityQueue::addAlias(int repeatID, int survivorID) {
+    if (repeatID <= 0 || repeatID == survivorID || !positions.count(survivorID)) return;
+    if (aliases.insert(std::make_pair(repeatID, survivorID)).second) {
+        aliasesOf[survivorID].push_back(repeatID);
     }
 }
 
-// Swap two elements in heap
-void PriorityQueue::swap(int i, int j) {
-    Alert temp = heap[i];
-    heap[i] = heap[j];
-    heap[j] = temp;
+// Called with queueMutex held. Survivors are never merged themselves, so
+// one hop is enough.
+int PriorityQueue::resolve(int alertID) const {
+    if (positions.count(alertID)) return alertID;
+    auto alias = aliases.find(alertID);
+    return alias != aliases.end() ? alias->second : alertID;
+}
+
+int PriorityQueue::resolveAlertID(int alertID) const {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return resolve(alertID);
+}
+
+void PriorityQueue::indexSlot(int slot) {
+    SlabEntry& entry = slab[slot];
+    const Alert& alert = entry.alert;
+    entry.ward = wardResolver ? wardResolver(alert.patientID) : "";
+    
+    byPatient[alert.patientID].insert(alert.alertID);
+    byWard[entry.ward].insert(alert.alertID);
+    byType[alert.type].insert(alert.alertID);
+    if (!alert.acknowledged) unacknowledged.insert(alert.alertID);
+}
+
+// Empty buckets are dropped so the maps stay as small as the queue
+template <typename Key>
+static void eraseFromIndex(std::unordered_map<Key, std::unordered_set<int>>& index,
+                           const Key& key, int alertID) {
+    auto bucket = index.find(key);
+    if (bucket == index.end()) return;
+    bucket->second.erase(alertID);
+    if (bucket->second.empty()) index.erase(bucket);
 }
 
-// Move element up to maintain heap property
-void PriorityQueue::heapifyUp(int index) {
-    // If not root and parent is greater, swap
-    while (index > 0 && heap[parent(index)] > heap[index]) {
-        swap(index, parent(index));
-        index = parent(index);
+void PriorityQueue::unindexSlot(int slot) {
+    const SlabEntry& entry = slab[slot];
+    const Alert& alert = entry.alert;
+    
+    eraseFromIndex(byPatient, alert.patientID, alert.alertID);
+    eraseFromIndex(byWard, entry.ward, alert.alertID);
+    eraseFromIndex(byType, static_cast<int>(alert.type), alert.alertID);
+    unacknowledged.erase(alert.alertID);
+}
+
+long long PriorityQueue::coalesceKey(const Alert& alert) {
+    return (static_cast<long long>(alert.patientID) << 32) | static_cast<unsigned int>(alert.type);
+}
+
+// Called with queueMutex held, before the alert is inserted. Merges and
+// journals the repeat and sets `survivorID` to the alert it joined;
+// returns false if the alert should be queued normally.
+bool PriorityQueue::tryCoalesce(const Alert& alert, int& survivorID) {
+    if (coalesceWindow <= 0 || alert.type == CUSTOM || positions.count(alert.alertID)) {
+        return false;
+    }
+    
+    auto indexed = coalesceIndex.find(coalesceKey(alert));
+    if (indexed == coalesceIndex.end()) return false;
+    auto position = positions.find(indexed->second);
+    if (position == positions.end()) return false;
+    
+    const Alert& existing = slab[position->second].alert;
+    if (existing.patientID != alert.patientID || existing.type != alert.type) return false;
+    if (existing.acknowledged || alert.timestamp - existing.getLastSeenTime() > coalesceWindow) {
+        return false;
     }
+    
+    int alertID = existing.alertID;
+    int occurrences = existing.occurrenceCount + alert.occurrenceCount;
+    long lastSeen = std::max(existing.getLastSeenTime(), alert.getLastSeenTime());
+    bool escalate = alert.priority < existing.priority;
+    
+    applyCoalesce(alertID, occurrences, lastSeen);
+    addAlias(alert.alertID, alertID);
+    maxIssuedID = std::max(maxIssuedID, alert.alertID);
+    survivorID = alertID;
+    if (escalate) {
+        applyPriority(alertID, alert.priority);
+    }
+    if (journal) {
+        journal->appendCoalesce(alertID, occurrences, lastSeen, alert.alertID);
+        if (escalate) {
+            journal->appendPriority(alertID, alert.priority);
+        }
+        compactJournalIfNeeded();
+    }
+    if (escalate) {
+        notifyListener(alertID);
+    }
+    return true;
 }
 
-// Move element down to maintain heap property
-void PriorityQueue::heapifyDown(int index) {
-    int minIndex = index;
-    int left = leftChild(index);
-    int right = rightChild(index);
+// Take the slot off its level; its handle goes stale but stays queued
+// until settle() reaches it
+void PriorityQueue::unlink(int slot) {
+    SlabEntry& entry = slab[slot];
+    entry.stamp = 0;
+    levels[entry.level].live--;
+    count--;
+    settle(entry.level);
+}
+
+// Drop stale handles from both heads; rebuild the level once stale
+// handles outnumber live ones
+void PriorityQueue::settle(int level) {
+    Level& lv = levels[level];
+    if (lv.live == 0) {
+        lv.fifo.clear();
+        lv.late.clear();
+        nonEmpty &= ~(1u << level);
+        return;
+    }
+    
+    while (!lv.fifo.empty() && !isLive(lv.fifo.front())) {
+        lv.fifo.pop_front();
+    }
+    while (!lv.late.empty() && !isLive(lv.late.front())) {
+        popHeap(lv.late);
+    }
     
-    // Find smallest among node, left child, right child
-    if (left < heap.size() && heap[left] < heap[minIndex]) {
-        minIndex = left;
+    if (lv.fifo.size() + lv.late.size() > 2 * static_cast<size_t>(lv.live) + PQ_STALE_SLACK) {
+        std::vector<AlertHandle> live = orderedHandles(level);
+        lv.fifo.assign(live.begin(), live.end());
+        lv.late.clear();
     }
+}
+
+bool PriorityQueue::isEmpty() const {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return count == 0;
+}
+
+int PriorityQueue::size() const {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return count;
+}
+
+// Unlocked mutations shared by the public methods and journal replay
+void PriorityQueue::applyInsert(const Alert& alert) {
+    maxIssuedID = std::max(maxIssuedID, alert.alertID);
+    auto existing = positions.find(alert.alertID);
+    if (existing != positions.end()) {
+        int slot = existing->second;
+        unindexSlot(slot);
+        unlink(slot);
+        slab[slot].alert = alert;
+        place(slot);
+        indexSlot(slot);
+    } else {
+        push(alert);
+    }
+    invalidateSnapshot();
+}
+
+bool PriorityQueue::applyRemove(int alertID) {
+    auto it = positions.find(alertID);
+    if (it == positions.end()) return false;
     
-    if (right < heap.size() && heap[right] < heap[minIndex]) {
-        minIndex = right;
+    int slot = it->second;
+    forget(slot);
+    unlink(slot);
+    freeSlots.push_back(slot);
+    invalidateSnapshot();
+    return true;
+}
+
+bool PriorityQueue::applyAck(int alertID, const std::string& acknowledgedBy, long acknowledgedTime) {
+    auto it = positions.find(alertID);
+    if (it == positions.end()) return false;
+    
+    Alert& alert = slab[it->second].alert;
+    alert.acknowledged = true;
+    alert.acknowledgedBy = acknowledgedBy;
+    alert.acknowledgedTime = acknowledgedTime;
+    unacknowledged.erase(alertID);
+    invalidateSnapshot();
+    return true;
+}
+
+// Re-queues the handle on its new level; the alert itself does not move
+// and keeps its original timestamp
+bool PriorityQueue::applyPriority(int alertID, AlertPriority priority) {
+    auto it = positions.find(alertID);
+    if (it == positions.end()) return false;
+    
+    int slot = it->second;
+    unlink(slot);
+    slab[slot].alert.priority = priority;
+    place(slot);
+    invalidateSnapshot();
+    return true;
+}
+
+void PriorityQueue::applyClear() {
+    for (int level = 0; level < PQ_LEVELS; level++) {
+        levels[level].fifo.clear();
+        levels[level].late.clear();
+        levels[level].live = 0;
+    }
+    slab.clear();
+    freeSlots.clear();
+    nonEmpty = 0;
+    count = 0;
+    positions.clear();
+    coalesceIndex.clear();
+    byPatient.clear();
+    byWard.clear();
+    byType.clear();
+    unacknowledged.clear();
+    aliases.clear();
+    aliasesOf.clear();
+    invalidateSnapshot();
+}
+
+bool PriorityQueue::applyCoalesce(int alertID, int occurrenceCount, long lastSeenTime) {
+    auto it = positions.find(alertID);
+    if (it == positions.end()) return false;
+    
+    Alert& alert = slab[it->second].alert;
+    alert.occurrenceCount = occurrenceCount;
+    alert.lastSeenTime = lastSeenTime;
+    invalidateSnapshot();
+    return true;
+}
+
+void PriorityQueue::applyEntry(const JournalEntry& entry) {
+    switch (entry.op) {
+        case JOURNAL_INSERT:   applyInsert(entry.alert); break;
+        case JOURNAL_REMOVE:   applyRemove(entry.alertID); break;
+        case JOURNAL_ACK:      applyAck(entry.alertID, entry.acknowledgedBy, entry.acknowledgedTime); break;
+        case JOURNAL_PRIORITY: applyPriority(entry.alertID, entry.priority); break;
+        case JOURNAL_CLEAR:    applyClear(); break;
+        case JOURNAL_COALESCE:
+            applyCoalesce(entry.alertID, entry.occurrenceCount, entry.lastSeenTime);
+            addAlias(entry.repeatID, entry.alertID);
+            maxIssuedID = std::max(maxIssuedID, entry.repeatID);
+            break;
     }
+}
+
+// Fold the journal into a fresh snapshot once replaying it would cost
+// more than reading the snapshot itself
+void PriorityQueue::compactJournalIfNeeded() {
+    int limit = std::max(PQ_JOURNAL_COMPACT_MIN, 2 * count);
+    if (journal->getEntryCount() < limit) return;
     
-    // If smallest is not current node, swap and continue
-    if (minIndex != index) {
-        swap(index, minIndex);
-        heapifyDown(minIndex);
+    if (writeSnapshot()) {
+        journal->truncate();
     }
 }
 
 // Insert new alert into priority queue
-void PriorityQueue::insert(const Alert& alert) {
-    heap.push_back(alert);
-    heapifyUp(heap.size() - 1);
+int PriorityQueue::insert(const Alert& alert) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    int survivorID;
+    if (tryCoalesce(alert, survivorID)) {
+        std::cout << "[PQ] Coalesced alert ID " << alert.alertID << " into alert " << survivorID
+                  << " (" << alert.getTypeString() << ", patient " << alert.patientID << ")" << std::endl;
+        return survivorID;
+    }
+    applyInsert(alert);
+    if (journal) {
+        journal->appendInsert(alert);
+        compactJournalIfNeeded();
+    }
+    notifyListener(alert.alertID);
     
-    std::cout << "[PQ] Inserted alert ID " << alert.alertID 
+    std::cout << "[PQ] Inserted alert ID " << alert.alertID
               << " (Priority: " << alert.getPriorityString() << ")" << std::endl;
+    return alert.alertID;
+}
+
+void PriorityQueue::insertBatch(const std::vector<Alert>& alerts) {
+    if (alerts.empty()) return;
+    
+    std::lock_guard<std::mutex> lock(queueMutex);
+    int merged = 0;
+    for (const auto& alert : alerts) {
+        int survivorID;
+        if (tryCoalesce(alert, survivorID)) {
+            merged++;
+            continue;
+        }
+        applyInsert(alert);
+        if (journal) {
+            journal->appendInsert(alert);
+        }
+        notifyListener(alert.alertID);
+    }
+    if (journal) {
+        compactJournalIfNeeded();
+    }
+    
+    std::cout << "[PQ] Inserted " << alerts.size() - merged << " alerts";
+    if (merged > 0) {
+        std::cout << " (" << merged << " coalesced)";
+    }
+    std::cout << std::endl;
 }
 
 // Extract and return highest priority alert (minimum)
 Alert PriorityQueue::extractMin() {
-    if (isEmpty()) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    if (count == 0) {
         throw std::runtime_error("Priority queue is empty!");
     }
     
-    // Root is the minimum element
-    Alert minAlert = heap[0];
-    
-    // Move last element to root
-    heap[0] = heap.back();
-    heap.pop_back();
+    // Head of the most urgent non-empty level
+    int level = __builtin_ctz(nonEmpty);
+    AlertHandle handle;
+    bool fromLate;
+    head(level, handle, fromLate);
+    if (fromLate) {
+        popHeap(levels[level].late);
+    } else {
+        levels[level].fifo.pop_front();
+    }
     
-    // Restore heap property
-    if (!isEmpty()) {
-        heapifyDown(0);
+    forget(handle.slot);
+    Alert minAlert = std::move(slab[handle.slot].alert);
+    unlink(handle.slot);
+    freeSlots.push_back(handle.slot);
+    invalidateSnapshot();
+    if (journal) {
+        journal->appendRemove(minAlert.alertID);
+        compactJournalIfNeeded();
     }
     
-    std::cout << "[PQ] Extracted alert ID " << minAlert.alertID 
+    std::cout << "[PQ] Extracted alert ID " << minAlert.alertID
               << " (Priority: " << minAlert.getPriorityString() << ")" << std::endl;
     
     return minAlert;
@@ -88,10 +612,13 @@ Alert PriorityQueue::extractMin() {
 
 // Peek at highest priority alert without removing
 Alert PriorityQueue::peekMin() const {
-    if (isEmpty()) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    AlertHandle handle;
+    bool fromLate;
+    if (count == 0 || !head(__builtin_ctz(nonEmpty), handle, fromLate)) {
         throw std::runtime_error("Priority queue is empty!");
     }
-    return heap[0];
+    return slab[handle.slot].alert;
 }
 
 // Display all alerts in priority order
@@ -100,62 +627,127 @@ void PriorityQueue::display() const {
     std::cout << "║          PRIORITY QUEUE - ALL ALERTS              ║" << std::endl;
     std::cout << "╚════════════════════════════════════════════════════╝" << std::endl;
     
-    if (isEmpty()) {
+    std::shared_ptr<const std::vector<Alert>> sortedAlerts = getSortedSnapshot();
+    if (sortedAlerts->empty()) {
         std::cout << "\n  No alerts in queue.\n" << std::endl;
         return;
     }
     
-    // Create copy and extract in order to display
-    std::vector<Alert> sortedAlerts = heap;
-    std::make_heap(sortedAlerts.begin(), sortedAlerts.end(), std::greater<Alert>());
-    
     int count = 1;
-    while (!sortedAlerts.empty()) {
-        std::pop_heap(sortedAlerts.begin(), sortedAlerts.end(), std::greater<Alert>());
-        Alert alert = sortedAlerts.back();
-        sortedAlerts.pop_back();
-        
+    for (const auto& alert : *sortedAlerts) {
         std::cout << "\n[" << count++ << "] ";
         alert.display();
     }
     
-    std::cout << "\nTotal alerts: " << heap.size() << std::endl;
+    std::cout << "\nTotal alerts: " << sortedAlerts->size() << std::endl;
 }
 
-// Display heap structure (for debugging)
+// Display each priority level's live alerts in order (for debugging)
 void PriorityQueue::displayTree() const {
+    std::lock_guard<std::mutex> lock(queueMutex);
     
-    if (isEmpty()) {
-        std::cout << "Empty heap" << std::endl;
+    if (count == 0) {
+        std::cout << "Empty queue" << std::endl;
         return;
     }
     
-    int level = 0;
-    int nodesInLevel = 1;
-    int nodesPrinted = 0;
-    
-    for (int i = 0; i < heap.size(); i++) {
-        if (nodesPrinted == 0) {
-            std::cout << "Level " << level << ": ";
+    for (int level = 0; level < PQ_LEVELS; level++) {
+        const Level& lv = levels[level];
+        std::cout << "Level " << level + 1
+                  << (nonEmpty & (1u << level) ? " *" : "  ") << ": ";
+        for (const auto& handle : orderedHandles(level)) {
+            std::cout << "[" << slab[handle.slot].alert.alertID << ":" << handle.timestamp << "] ";
         }
-        
-        std::cout << "[" << heap[i].alertID << ":" << heap[i].priority << "] ";
-        nodesPrinted++;
-        
-        if (nodesPrinted == nodesInLevel || i == heap.size() - 1) {
-            std::cout << std::endl;
-            level++;
-            nodesInLevel *= 2;
-            nodesPrinted = 0;
+        if (!lv.late.empty()) {
+            std::cout << "(" << lv.late.size() << " late)";
         }
+        std::cout << std::endl;
     }
+}
+
+bool PriorityQueue::contains(int alertID) const {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return positions.count(resolve(alertID)) > 0;
+}
+
+bool PriorityQueue::getAlert(int alertID, Alert& alert) const {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    auto it = positions.find(resolve(alertID));
+    if (it == positions.end()) return false;
     
+    alert = slab[it->second].alert;
+    return true;
+}
+
+// Acknowledgement does not affect ordering, so the alert stays in place
+bool PriorityQueue::acknowledge(int alertID, const std::string& acknowledgedBy, long acknowledgedTime) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    alertID = resolve(alertID);
+    if (!applyAck(alertID, acknowledgedBy, acknowledgedTime)) return false;
+    if (journal) {
+        journal->appendAck(alertID, acknowledgedBy, acknowledgedTime);
+        compactJournalIfNeeded();
+    }
+    
+    std::cout << "[PQ] Acknowledged alert ID " << alertID << " by " << acknowledgedBy << std::endl;
+    return true;
+}
+
+// Escalate or de-escalate: move the alert to its new level
+bool PriorityQueue::updatePriority(int alertID, AlertPriority priority) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    alertID = resolve(alertID);
+    if (!applyPriority(alertID, priority)) return false;
+    if (journal) {
+        journal->appendPriority(alertID, priority);
+        compactJournalIfNeeded();
+    }
+    
+    std::cout << "[PQ] Alert ID " << alertID << " priority set to "
+              << slab[positions[alertID]].alert.getPriorityString() << std::endl;
+    return true;
+}
+
+bool PriorityQueue::escalateIfUnacknowledged(int alertID, Alert& current, bool& escalated) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    alertID = resolve(alertID);
+    escalated = false;
+    auto it = positions.find(alertID);
+    if (it == positions.end()) return false;
+    
+    const Alert& alert = slab[it->second].alert;
+    if (!alert.acknowledged && (alert.priority == HIGH || alert.priority == MEDIUM)) {
+        AlertPriority raised = static_cast<AlertPriority>(alert.priority - 1);
+        applyPriority(alertID, raised);
+        if (journal) {
+            journal->appendPriority(alertID, raised);
+            compactJournalIfNeeded();
+        }
+        escalated = true;
+    }
+    current = slab[positions[alertID]].alert;
+    return true;
+}
+
+bool PriorityQueue::remove(int alertID) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    alertID = resolve(alertID);
+    if (!applyRemove(alertID)) return false;
+    if (journal) {
+        journal->appendRemove(alertID);
+        compactJournalIfNeeded();
+    }
+    
+    std::cout << "[PQ] Removed alert ID " << alertID << std::endl;
+    return true;
 }
 
 // Get all alerts of specific priority
 std::vector<Alert> PriorityQueue::getAlertsByPriority(AlertPriority prio) const {
+    std::lock_guard<std::mutex> lock(queueMutex);
     std::vector<Alert> result;
-    for (const auto& alert : heap) {
+    for (const auto& handle : orderedHandles(levelOf(prio))) {
+        const Alert& alert = slab[handle.slot].alert;
         if (alert.priority == prio) {
             result.push_back(alert);
         }
@@ -165,43 +757,270 @@ std::vector<Alert> PriorityQueue::getAlertsByPriority(AlertPriority prio) const
 
 // Get all unacknowledged alerts
 std::vector<Alert> PriorityQueue::getUnacknowledgedAlerts() const {
-    std::vector<Alert> result;
-    for (const auto& alert : heap) {
-        if (!alert.acknowledged) {
-            result.push_back(alert);
+    std::lock_guard<std::mutex> lock(queueMutex);
+    AlertQuery query;
+    query.unacknowledgedOnly = true;
+    return indexedQuery(query, unacknowledged).alerts;
+}
+
+AlertPage PriorityQueue::query(const AlertQuery& query) const {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    
+    // Read the smallest index that applies; the other filters are checked
+    // per candidate
+    static const std::unordered_set<int> none;
+    const std::unordered_set<int>* candidates = nullptr;
+    auto narrow = [&candidates](const std::unordered_set<int>* set) {
+        if (!candidates || set->size() < candidates->size()) candidates = set;
+    };
+    if (query.patientID >= 0) {
+        auto bucket = byPatient.find(query.patientID);
+        narrow(bucket == byPatient.end() ? &none : &bucket->second);
+    }
+    if (!query.ward.empty()) {
+        auto bucket = byWard.find(query.ward);
+        narrow(bucket == byWard.end() ? &none : &bucket->second);
+    }
+    if (query.type >= 0) {
+        auto bucket = byType.find(query.type);
+        narrow(bucket == byType.end() ? &none : &bucket->second);
+    }
+    if (candidates) {
+        if (query.unacknowledgedOnly) narrow(&unacknowledged);
+        return indexedQuery(query, *candidates);
+    }
+    
+    // Unacknowledged only: once acked alerts outnumber the rest, the walk
+    // would mostly skip them, so rank the unacknowledged index instead
+    if (query.unacknowledgedOnly && unacknowledged.size() * 2 < static_cast<size_t>(count)) {
+        return indexedQuery(query, unacknowledged);
+    }
+    
+    AlertPage page;
+    int skip = std::max(query.offset, 0);
+    int lastLevel = levelOf(query.minPriority);
+    int firstLevel = query.after.valid ? query.after.level : 0;
+    AlertHandle resume = {query.after.timestamp, 0, query.after.stamp};
+    
+    for (int level = firstLevel; level <= lastLevel; level++) {
+        if (!(nonEmpty & (1u << level))) continue;
+        
+        const AlertHandle* after = query.after.valid && level == query.after.level ? &resume : nullptr;
+        bool finished = walkLevel(level, after, [&](const AlertHandle& handle) {
+            const Alert& alert = slab[handle.slot].alert;
+            if (query.unacknowledgedOnly && alert.acknowledged) return true;
+            if (skip > 0) {
+                skip--;
+                return true;
+            }
+            if (query.limit > 0 && page.alerts.size() == static_cast<size_t>(query.limit)) {
+                page.hasMore = true;
+                return false;
+            }
+            
+            page.alerts.push_back(alert);
+            page.next.valid = true;
+            page.next.level = level;
+            page.next.timestamp = handle.timestamp;
+            page.next.stamp = handle.stamp;
+            return true;
+        });
+        if (!finished) break;
+    }
+    
+    return page;
+}
+
+// An indexed alert with its place in extraction order
+struct RankedHandle {
+    int level;
+    AlertHandle handle;
+};
+
+// Called with queueMutex held. Candidates that pass every filter are
+// ranked with a partial sort up to the end of the page, so the cost is
+// linear in the candidate set plus O(k log k) for the page.
+AlertPage PriorityQueue::indexedQuery(const AlertQuery& query, const std::unordered_set<int>& candidates) const {
+    int lastLevel = levelOf(query.minPriority);
+    AlertHandle resume = {query.after.timestamp, 0, query.after.stamp};
+    
+    std::vector<RankedHandle> matches;
+    for (int alertID : candidates) {
+        int slot = positions.at(alertID);
+        const SlabEntry& entry = slab[slot];
+        const Alert& alert = entry.alert;
+        
+        if (entry.level > lastLevel) continue;
+        if (query.unacknowledgedOnly && alert.acknowledged) continue;
+        if (query.patientID >= 0 && alert.patientID != query.patientID) continue;
+        if (!query.ward.empty() && entry.ward != query.ward) continue;
+        if (query.type >= 0 && alert.type != query.type) continue;
+        
+        RankedHandle ranked = {entry.level, {alert.timestamp, slot, entry.stamp}};
+        if (query.after.valid && (ranked.level < query.after.level ||
+            (ranked.level == query.after.level && !before(resume, ranked.handle)))) {
+            continue;
         }
+        matches.push_back(ranked);
+    }
+    
+    auto ranksBefore = [](const RankedHandle& a, const RankedHandle& b) {
+        return a.level != b.level ? a.level < b.level : before(a.handle, b.handle);
+    };
+    size_t begin = std::min(static_cast<size_t>(std::max(query.offset, 0)), matches.size());
+    size_t end = matches.size();
+    if (query.limit > 0) end = std::min(end, begin + query.limit);
+    std::partial_sort(matches.begin(), matches.begin() + end, matches.end(), ranksBefore);
+    
+    AlertPage page;
+    for (size_t i = begin; i < end; i++) {
+        page.alerts.push_back(slab[matches[i].handle.slot].alert);
+        page.next.valid = true;
+        page.next.level = matches[i].level;
+        page.next.timestamp = matches[i].handle.timestamp;
+        page.next.stamp = matches[i].handle.stamp;
+    }
+    page.hasMore = end < matches.size();
+    return page;
+}
+
+void PriorityQueue::setWardResolver(const std::function<std::string(int)>& resolver) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    wardResolver = resolver;
+    for (const auto& position : positions) {
+        unindexSlot(position.second);
+        indexSlot(position.second);
+    }
+}
+
+void PriorityQueue::setAlertListener(const std::function<void(const Alert&)>& listener) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    alertListener = listener;
+}
+
+// Called with queueMutex held
+void PriorityQueue::notifyListener(int alertID) const {
+    if (!alertListener) return;
+    auto it = positions.find(alertID);
+    if (it != positions.end()) {
+        alertListener(slab[it->second].alert);
+    }
+}
+
+void PriorityQueue::reindexPatient(int patientID) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    auto bucket = byPatient.find(patientID);
+    if (bucket == byPatient.end()) return;
+    
+    // Copied: re-indexing rebuilds this bucket
+    std::vector<int> alertIDs(bucket->second.begin(), bucket->second.end());
+    for (int alertID : alertIDs) {
+        int slot = positions.at(alertID);
+        unindexSlot(slot);
+        indexSlot(slot);
     }
-    return result;
+}
+
+// Levels are already ordered, so the snapshot is a concatenation built
+// once per mutation and shared by readers
+std::shared_ptr<const std::vector<Alert>> PriorityQueue::getSortedSnapshot() const {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    if (!sortedSnapshot) {
+        std::shared_ptr<std::vector<Alert>> sorted = std::make_shared<std::vector<Alert>>();
+        sorted->reserve(count);
+        for (int level = 0; level < PQ_LEVELS; level++) {
+            for (const auto& handle : orderedHandles(level)) {
+                sorted->push_back(slab[handle.slot].alert);
+            }
+        }
+        sortedSnapshot = sorted;
+    }
+    return sortedSnapshot;
+}
+
+void PriorityQueue::setCoalesceWindow(long seconds) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    coalesceWindow = std::max(0L, seconds);
+}
+
+long PriorityQueue::getCoalesceWindow() const {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return coalesceWindow;
+}
+
+int PriorityQueue::getMaxAlertID() const {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return maxIssuedID;
 }
 
 // Clear all alerts
 void PriorityQueue::clear() {
-    heap.clear();
+    std::lock_guard<std::mutex> lock(queueMutex);
+    applyClear();
+    if (journal) {
+        journal->appendClear();
+    }
     std::cout << "[PQ] All alerts cleared" << std::endl;
 }
 
-// Save to disk
-void PriorityQueue::saveToDisk() {
-    if (dataFilePath.empty()) return;
-    
-    std::ofstream file(dataFilePath, std::ios::binary);
+int PriorityQueue::getJournalEntryCount() const {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return journal ? journal->getEntryCount() : 0;
+}
+
+// Called with queueMutex held. Written beside the old snapshot and renamed
+// over it, so a crash mid-write leaves the previous snapshot intact.
+// Alerts are written in extraction order so reloading only appends.
+bool PriorityQueue::writeSnapshot() {
+    std::string tempPath = dataFilePath + ".tmp";
+    std::ofstream file(tempPath, std::ios::binary);
     if (!file.is_open()) {
-        std::cerr << "[PQ] Error: Cannot open file for writing: " 
-                  << dataFilePath << std::endl;
-        return;
+        std::cerr << "[PQ] Error: Cannot open file for writing: "
+                  << tempPath << std::endl;
+        return false;
     }
     
-    // Write number of alerts
-    int numAlerts = heap.size();
+    // Version marker, then number of alerts
+    int marker = -PQ_SNAPSHOT_VERSION;
+    int numAlerts = count;
+    file.write(reinterpret_cast<const char*>(&marker), sizeof(marker));
     file.write(reinterpret_cast<const char*>(&numAlerts), sizeof(numAlerts));
     
     // Write all alerts
-    for (const auto& alert : heap) {
-        alert.writeToDisk(file);
+    for (int level = 0; level < PQ_LEVELS; level++) {
+        for (const auto& handle : orderedHandles(level)) {
+            slab[handle.slot].alert.writeToDisk(file);
+        }
+    }
+    
+    // Trailing high-water mark and repeat aliases; older snapshots end
+    // after the alerts
+    file.write(reinterpret_cast<const char*>(&maxIssuedID), sizeof(maxIssuedID));
+    int numAliases = aliases.size();
+    file.write(reinterpret_cast<const char*>(&numAliases), sizeof(numAliases));
+    for (const auto& alias : aliases) {
+        file.write(reinterpret_cast<const char*>(&alias.first), sizeof(alias.first));
+        file.write(reinterpret_cast<const char*>(&alias.second), sizeof(alias.second));
     }
     
     file.close();
-    std::cout << "[PQ] Saved " << numAlerts << " alerts to " << dataFilePath << std::endl;
+    if (!file || std::rename(tempPath.c_str(), dataFilePath.c_str()) != 0) {
+        std::cerr << "[PQ] Error: Cannot replace " << dataFilePath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Save a full snapshot and truncate the journal it supersedes
+void PriorityQueue::saveToDisk() {
+    if (dataFilePath.empty()) return;
+    
+    std::lock_guard<std::mutex> lock(queueMutex);
+    if (!writeSnapshot()) return;
+    if (journal) {
+        journal->truncate();
+    }
+    std::cout << "[PQ] Saved " << count << " alerts to " << dataFilePath << std::endl;
 }
 
 // Load from disk
@@ -214,18 +1033,60 @@ void PriorityQueue::loadFromDisk() {
         return;
     }
     
-    // Read number of alerts
-    int numAlerts;
+    // Read version marker (absent in version 1 files) and number of alerts
+    int version = 1;
+    int numAlerts = 0;
     file.read(reinterpret_cast<char*>(&numAlerts), sizeof(numAlerts));
+    if (file && numAlerts < 0) {
+        version = -numAlerts;
+        file.read(reinterpret_cast<char*>(&numAlerts), sizeof(numAlerts));
+    }
+    bool readable = file && numAlerts >= 0 && version <= PQ_SNAPSHOT_VERSION;
+    if (!readable) {
+        std::cerr << "[PQ] Error: Unreadable snapshot " << dataFilePath << std::endl;
+        numAlerts = 0;
+    }
     
     // Read all alerts
-    heap.clear();
-    for (int i = 0; i < numAlerts; i++) {
+    std::vector<Alert> loaded;
+    int maxID = 0;
+    for (int i = 0; i < numAlerts && file; i++) {
         Alert alert;
-        alert.readFromDisk(file);
-        heap.push_back(alert);
+        alert.readFromDisk(file, version);
+        maxID = std::max(maxID, alert.alertID);
+        loaded.push_back(alert);
+    }
+    int highWater = 0;
+    std::vector<std::pair<int, int>> loadedAliases;
+    if (readable && file && file.read(reinterpret_cast<char*>(&highWater), sizeof(highWater))) {
+        maxID = std::max(maxID, highWater);
+        int numAliases = 0;
+        file.read(reinterpret_cast<char*>(&numAliases), sizeof(numAliases));
+        for (int i = 0; i < numAliases && file; i++) {
+            std::pair<int, int> alias;
+            file.read(reinterpret_cast<char*>(&alias.first), sizeof(alias.first));
+            file.read(reinterpret_cast<char*>(&alias.second), sizeof(alias.second));
+            if (file) loadedAliases.push_back(alias);
+        }
     }
-    
     file.close();
+    
+    std::lock_guard<std::mutex> lock(queueMutex);
+    applyClear();
+    for (auto& alert : loaded) {
+        // Older files may repeat alert IDs; duplicates get fresh IDs so
+        // every queued alert stays addressable
+        if (positions.count(alert.alertID)) {
+            std::cout << "[PQ] Duplicate alert ID " << alert.alertID
+                      << " renumbered to " << maxID + 1 << std::endl;
+            alert.alertID = ++maxID;
+        }
+        push(alert);
+    }
+    for (const auto& alias : loadedAliases) {
+        addAlias(alias.first, alias.second);
+    }
+    maxIssuedID = std::max(maxIssuedID, maxID);
+    
     std::cout << "[PQ] Loaded " << numAlerts << " alerts from " << dataFilePath << std::endl;
-}
\ No newline at end of file
+}
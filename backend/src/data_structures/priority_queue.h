@@ -2,49 +2,267 @@
 #define PRIORITY_QUEUE_H
 
 #include <vector>
+#include <deque>
 #include <string>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <functional>
 #include "../models/alert.h"
+#include "alert_journal.h"
 
+// Journal entries tolerated before it is folded into a new snapshot
+// (or twice the queue size, whichever is larger)
+const int PQ_JOURNAL_COMPACT_MIN = 1024;
+
+// Coalescing window used by the server; PriorityQueue itself defaults to off
+const long PQ_DEFAULT_COALESCE_WINDOW = 60;
+
+// Snapshots start with -PQ_SNAPSHOT_VERSION; older files start with the
+// alert count
+const int PQ_SNAPSHOT_VERSION = ALERT_DISK_VERSION;
+
+// One FIFO per AlertPriority level (CRITICAL = 1 .. INFO = 5)
+const int PQ_LEVELS = 5;
+
+// 16-byte reference to an alert held in the slab. Levels order handles,
+// never Alert objects. `stamp` is unique per placement and increases in
+// arrival order; a handle is stale once its slot's stamp differs.
+struct AlertHandle {
+    long timestamp;
+    int slot;
+    unsigned int stamp;
+};
+
+// Position of an alert in extraction order, handed out as the cursor
+// for the next page of a query. Stays meaningful while the queue changes:
+// the next page starts after this position, wherever the alert went.
+struct AlertCursor {
+    bool valid;
+    int level;
+    long timestamp;
+    unsigned int stamp;
+    
+    AlertCursor() : valid(false), level(0), timestamp(0), stamp(0) {}
+    
+    // "level.timestamp.stamp"; empty when invalid
+    std::string toString() const;
+    static bool parse(const std::string& text, AlertCursor& cursor);
+};
+
+// One page of alerts in extraction order. Matches are counted after
+// `after`; the first `offset` are skipped and at most `limit` returned.
+struct AlertQuery {
+    int limit;                   // 0 = no limit
+    int offset;
+    AlertPriority minPriority;   // Least urgent priority included
+    bool unacknowledgedOnly;
+    int patientID;               // -1 = any
+    std::string ward;            // Empty = any
+    int type;                    // AlertType, -1 = any
+    AlertCursor after;
+    
+    AlertQuery() : limit(0), offset(0), minPriority(INFO), unacknowledgedOnly(false),
+                   patientID(-1), type(-1) {}
+};
+
+struct AlertPage {
+    std::vector<Alert> alerts;
+    bool hasMore;
+    AlertCursor next;            // Resume point after the last alert returned
+    
+    AlertPage() : hasMore(false) {}
+};
+
+// Bucket queue: alerts are appended to their level's FIFO and the most
+// urgent non-empty level is found from a bitmask, so insert and
+// extractMin are O(1). Each level is ordered by (timestamp, arrival).
 class PriorityQueue {
 private:
-    std::vector<Alert> heap;
+    // Alerts stay in their slab slot from insert until removal; freed
+    // slots are reused, so steady-state churn does not allocate
+    struct SlabEntry {
+        Alert alert;
+        unsigned int stamp;    // 0 while the slot is free
+        int level;
+        std::string ward;      // Patient's ward when indexed
+    };
+    
+    // In-order arrivals go to the FIFO; an alert older than the FIFO's
+    // tail (replayed, reprioritized) goes to a small 4-ary heap instead.
+    // Removed alerts leave stale handles that are skipped at the head.
+    struct Level {
+        std::deque<AlertHandle> fifo;
+        std::vector<AlertHandle> late;
+        int live;
+        Level() : live(0) {}
+    };
+    
+    std::vector<SlabEntry> slab;
+    std::vector<int> freeSlots;
+    unsigned int nextStamp;
+    
+    Level levels[PQ_LEVELS];
+    unsigned int nonEmpty;    // Bit L set while levels[L] holds a live alert
+    int count;
+    int maxIssuedID;    // Highest alertID ever queued or merged, removed or not
     std::string dataFilePath;
     
-    // Helper functions for heap operations
-    int parent(int i) const { return (i - 1) / 2; }
-    int leftChild(int i) const { return 2 * i + 1; }
-    int rightChild(int i) const { return 2 * i + 2; }
+    // alertID -> slab slot
+    std::unordered_map<int, int> positions;
+    
+    // (patientID, type) -> newest queued alert of that kind. Entries may
+    // point at alerts since removed; they are checked against positions.
+    std::unordered_map<long long, int> coalesceIndex;
+    long coalesceWindow;    // Seconds; 0 disables coalescing
+    static long long coalesceKey(const Alert& alert);
+    bool tryCoalesce(const Alert& alert, int& survivorID);
+    void forget(int slot);
+    
+    // Merged repeat's alertID -> the queued alert it joined, plus the
+    // reverse so the aliases go when the survivor does. Lets clients
+    // address a repeat by the ID it was submitted under.
+    std::unordered_map<int, int> aliases;
+    std::unordered_map<int, std::vector<int>> aliasesOf;
+    void addAlias(int repeatID, int survivorID);
+    int resolve(int alertID) const;
+    
+    // Secondary indexes: alertIDs of queued alerts per patient, ward,
+    // type, and the unacknowledged ones. Updated on every insert, removal
+    // and ack so filtered queries only touch matching alerts.
+    std::unordered_map<int, std::unordered_set<int>> byPatient;
+    std::unordered_map<std::string, std::unordered_set<int>> byWard;
+    std::unordered_map<int, std::unordered_set<int>> byType;
+    std::unordered_set<int> unacknowledged;
+    std::function<std::string(int)> wardResolver;
+    
+    std::function<void(const Alert&)> alertListener;
+    void notifyListener(int alertID) const;
+    void indexSlot(int slot);
+    void unindexSlot(int slot);
+    AlertPage indexedQuery(const AlertQuery& query, const std::unordered_set<int>& candidates) const;
+    
+    // Guards the levels and the snapshot; every public method takes it
+    mutable std::mutex queueMutex;
+    
+    // Alerts in priority order, rebuilt lazily after any mutation. Readers
+    // share one immutable copy and never touch the live queue.
+    mutable std::shared_ptr<const std::vector<Alert>> sortedSnapshot;
+    void invalidateSnapshot() { sortedSnapshot.reset(); }
+    
+    // Bucket maintenance
+    static int levelOf(AlertPriority priority);
+    static bool before(const AlertHandle& a, const AlertHandle& b);
+    bool isLive(const AlertHandle& handle) const { return slab[handle.slot].stamp == handle.stamp; }
+    void push(const Alert& alert);
+    void place(int slot);
+    void unlink(int slot);
+    void settle(int level);
+    bool head(int level, AlertHandle& handle, bool& fromLate) const;
+    std::vector<AlertHandle> orderedHandles(int level) const;
+    bool walkLevel(int level, const AlertHandle* after,
+                   const std::function<bool(const AlertHandle&)>& visit) const;
+    
+    // Iterative 4-ary heap over a level's late arrivals
+    static void siftUp(std::vector<AlertHandle>& heap, size_t index);
+    static void siftDown(std::vector<AlertHandle>& heap, size_t index);
+    static void popHeap(std::vector<AlertHandle>& heap);
     
-    // Heap maintenance operations
-    void heapifyUp(int index);
-    void heapifyDown(int index);
-    void swap(int i, int j);
+    // Mutation bodies without locking or journaling; used for replay
+    void applyInsert(const Alert& alert);
+    bool applyRemove(int alertID);
+    bool applyAck(int alertID, const std::string& acknowledgedBy, long acknowledgedTime);
+    bool applyPriority(int alertID, AlertPriority priority);
+    void applyClear();
+    bool applyCoalesce(int alertID, int occurrenceCount, long lastSeenTime);
+    void applyEntry(const JournalEntry& entry);
+    
+    // Every mutation is appended here; null for in-memory queues
+    std::unique_ptr<AlertJournal> journal;
+    bool writeSnapshot();
+    void compactJournalIfNeeded();
     
 public:
     // Constructor & Destructor
     PriorityQueue(const std::string& filePath = "");
     ~PriorityQueue();
     
-    // Main operations
-    void insert(const Alert& alert);
+    // Main operations. Inserting an alertID already queued replaces that alert.
+    // With coalescing on, a repeat of a queued, unacknowledged alert for the
+    // same (patientID, type) within the window is merged into it instead.
+    // Returns the ID the alert is queued under: its own, or the merge target's.
+    int insert(const Alert& alert);
+    void insertBatch(const std::vector<Alert>& alerts);    // One lock and log line per batch
     Alert extractMin();
     Alert peekMin() const;
     
     // Utility
-    bool isEmpty() const { return heap.empty(); }
-    int size() const { return heap.size(); }
+    bool isEmpty() const;
+    int size() const;
     void display() const;
     void displayTree() const;
     
-    // Get alerts by priority
+    // Lookup and in-place updates by alertID, O(1) unless a priority change
+    // lands behind newer alerts. Each returns false if the alert is not queued.
+    // The ID of a repeat merged into a queued alert addresses that alert.
+    int resolveAlertID(int alertID) const;
+    bool contains(int alertID) const;
+    bool getAlert(int alertID, Alert& alert) const;
+    bool acknowledge(int alertID, const std::string& acknowledgedBy, long acknowledgedTime);
+    bool updatePriority(int alertID, AlertPriority priority);
+    bool remove(int alertID);
+    
+    // Raises an unacknowledged MEDIUM or HIGH alert one level, checking and
+    // updating under one lock so an acknowledge racing it always wins.
+    // current receives the alert as it stands afterwards; escalated says
+    // whether it was raised. Returns false if the alert is not queued.
+    bool escalateIfUnacknowledged(int alertID, Alert& current, bool& escalated);
+    
+    // Get alerts by priority (oldest first)
     std::vector<Alert> getAlertsByPriority(AlertPriority prio) const;
     std::vector<Alert> getUnacknowledgedAlerts() const;
     
-    // Disk persistence
+    // Without a patient, ward or type filter this walks the levels in
+    // order and stops one match past the page, so the top k cost
+    // O(k log k) plus skipped entries, independent of the backlog below
+    // them. With one, only the smallest matching index is read; so is the
+    // unacknowledged index when most queued alerts are acknowledged.
+    AlertPage query(const AlertQuery& query) const;
+    
+    // Maps patientID -> ward for the ward index. Setting it re-resolves
+    // every queued alert; call reindexPatient after a patient moves ward.
+    void setWardResolver(const std::function<std::string(int)>& resolver);
+    void reindexPatient(int patientID);
+    
+    // Called, under the queue lock, with the stored alert whenever an
+    // insert queues or replaces an alert, or a coalesced repeat raises a
+    // queued alert's priority. Merged repeats are not reported themselves.
+    // The listener must not call back into the queue.
+    void setAlertListener(const std::function<void(const Alert&)>& listener);
+    
+    // Read-only view of all alerts in extraction order (priority, then
+    // age, then ID). Cached until the next mutation; safe to hold while
+    // other threads insert.
+    std::shared_ptr<const std::vector<Alert>> getSortedSnapshot() const;
+    
+    // Repeats seen within `seconds` of an alert's last occurrence are merged
+    // into it; 0 (the default) turns coalescing off. CUSTOM alerts never merge.
+    void setCoalesceWindow(long seconds);
+    long getCoalesceWindow() const;
+    
+    // Highest alertID ever inserted, including merged repeats and alerts
+    // since extracted or removed (0 if none). Kept in the snapshot and
+    // journal; seeds new alert IDs after a restart so none is reissued.
+    int getMaxAlertID() const;
+    
+    // Disk persistence. Mutations are journaled as they happen; saveToDisk
+    // writes a full snapshot and truncates the journal.
     void saveToDisk();
     void loadFromDisk();
+    int getJournalEntryCount() const;
     
     // Clear all alerts
     void clear();
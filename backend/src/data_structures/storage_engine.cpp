@@ -0,0 +1,13 @@
+#include "storage_engine.h"
+#include "btree.h"
+#include "lsm_tree.h"
+
+VitalStorageEngine* createStorageEngine(const std::string& engine, const std::string& basePath) {
+    if (engine == "btree") {
+        return new DiskBTree(50, basePath);
+    }
+    if (engine == "lsm") {
+        return new LSMTree(basePath);
+    }
+    return nullptr;
+}
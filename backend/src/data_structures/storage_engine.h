@@ -0,0 +1,62 @@
+#ifndef STORAGE_ENGINE_H
+#define STORAGE_ENGINE_H
+
+#include <vector>
+#include <string>
+#include "../models/vital_record.h"
+#include "../models/vital_batch.h"
+#include "zone_map.h"
+
+// Storage interface the server uses for vital-sign history.
+// DiskBTree (in-place B-tree) and LSMTree (log-structured) implement it.
+class VitalStorageEngine {
+public:
+    virtual ~VitalStorageEngine() {}
+    
+    virtual void insert(long timestamp, const VitalRecord& record) = 0;
+    virtual VitalRecord* search(long timestamp) = 0;
+    
+    virtual std::vector<VitalRecord> rangeQuery(long startTime, long endTime) = 0;
+    virtual std::vector<VitalRecord> rangeQuery(long startTime, long endTime,
+                                                const VitalQuery& query) = 0;
+    virtual std::vector<VitalRecord> latestRecords(long startTime, long endTime, int count,
+                                                   const VitalQuery& query) = 0;
+    virtual std::vector<VitalRecord> scanWhere(long startTime, long endTime,
+                                               const std::vector<VitalPredicate>& predicates,
+                                               ZoneScanStats* stats = nullptr) = 0;
+    
+    // One patient's readings in the window that also pass `query`. The
+    // defaults push a patientID predicate into the time-ordered scans;
+    // engines with a patient index override them.
+    virtual std::vector<VitalRecord> patientRangeQuery(int patientID, long startTime, long endTime,
+                                                       const VitalQuery& query) {
+        VitalQuery patientQuery = query;
+        patientQuery.predicates.push_back(VitalPredicate(FIELD_PATIENT_ID, OP_EQUAL, patientID));
+        return rangeQuery(startTime, endTime, patientQuery);
+    }
+    virtual std::vector<VitalRecord> patientLatestRecords(int patientID, long startTime, long endTime,
+                                                          int count, const VitalQuery& query) {
+        VitalQuery patientQuery = query;
+        patientQuery.predicates.push_back(VitalPredicate(FIELD_PATIENT_ID, OP_EQUAL, patientID));
+        return latestRecords(startTime, endTime, count, patientQuery);
+    }
+    
+    // Column-oriented variants for analytics. The defaults convert the
+    // row results; engines that can decode straight into columns override.
+    virtual void rangeQueryBatch(long startTime, long endTime, VitalBatch& batch) {
+        batch = VitalBatch::fromRecords(rangeQuery(startTime, endTime));
+    }
+    virtual void patientRangeQueryBatch(int patientID, long startTime, long endTime, VitalBatch& batch) {
+        batch = VitalBatch::fromRecords(patientRangeQuery(patientID, startTime, endTime, VitalQuery()));
+    }
+    
+    virtual int getRecordCount() const = 0;
+    virtual bool isReady() const { return true; }
+    virtual std::string getEngineName() const = 0;
+};
+
+// Build the engine named "btree" or "lsm" on files under basePath.
+// Returns nullptr for an unknown name.
+VitalStorageEngine* createStorageEngine(const std::string& engine, const std::string& basePath);
+
+#endif
@@ -0,0 +1,191 @@
+#include "timer_wheel.h"
+#include <chrono>
+
+TimerWheel::TimerWheel(long tickMillis, bool background)
+    : currentTick(0), nextID(1), tickMillis(tickMillis > 0 ? tickMillis : 1), stopping(false) {
+    for (int level = 0; level < WHEEL_LEVELS; level++) {
+        for (int slot = 0; slot < WHEEL_SLOTS; slot++) {
+            slots[level][slot] = nullptr;
+        }
+    }
+    if (background) {
+        tickThread = std::thread(&TimerWheel::tickLoop, this);
+    }
+}
+
+TimerWheel::~TimerWheel() {
+    {
+        std::lock_guard<std::mutex> lock(signalMutex);
+        stopping = true;
+    }
+    stopSignal.notify_all();
+    if (tickThread.joinable()) {
+        tickThread.join();
+    }
+    
+    for (auto& entry : timers) {
+        delete entry.second;
+    }
+}
+
+// File a timer under the coarsest level whose slot span still separates
+// it from the current tick. Deadlines beyond the top level are parked in
+// its furthest slot and re-filed when that slot cascades.
+void TimerWheel::link(Timer* timer) {
+    uint64_t delta = timer->deadline > currentTick ? timer->deadline - currentTick : 0;
+    uint64_t deadline = timer->deadline;
+    
+    int level = 0;
+    while (level < WHEEL_LEVELS - 1 && delta >= (uint64_t(1) << (WHEEL_SLOT_BITS * (level + 1)))) {
+        level++;
+    }
+    uint64_t horizon = uint64_t(1) << (WHEEL_SLOT_BITS * WHEEL_LEVELS);
+    if (delta >= horizon) {
+        deadline = currentTick + horizon - 1;
+    }
+    
+    int slot = (deadline >> (WHEEL_SLOT_BITS * level)) & (WHEEL_SLOTS - 1);
+    Timer** bucket = &slots[level][slot];
+    
+    timer->bucket = bucket;
+    timer->prev = nullptr;
+    timer->next = *bucket;
+    if (*bucket) (*bucket)->prev = timer;
+    *bucket = timer;
+}
+
+void TimerWheel::unlink(Timer* timer) {
+    if (timer->prev) {
+        timer->prev->next = timer->next;
+    } else {
+        *timer->bucket = timer->next;
+    }
+    if (timer->next) timer->next->prev = timer->prev;
+    timer->prev = timer->next = nullptr;
+}
+
+// Re-file every timer in the current slot of `level` one level finer
+void TimerWheel::cascade(int level) {
+    int slot = (currentTick >> (WHEEL_SLOT_BITS * level)) & (WHEEL_SLOTS - 1);
+    Timer* timer = slots[level][slot];
+    slots[level][slot] = nullptr;
+    
+    while (timer) {
+        Timer* next = timer->next;
+        link(timer);
+        timer = next;
+    }
+}
+
+// Called with wheelMutex held; due timers are handed back so callbacks
+// run after the lock is released
+void TimerWheel::tickLocked(std::vector<Timer*>& expired) {
+    currentTick++;
+    
+    // Cascade top-down so a timer can fall through several levels at once
+    int top = 0;
+    while (top < WHEEL_LEVELS - 1 &&
+           (currentTick & ((uint64_t(1) << (WHEEL_SLOT_BITS * (top + 1))) - 1)) == 0) {
+        top++;
+    }
+    for (int level = top; level > 0; level--) {
+        cascade(level);
+    }
+    
+    int slot = currentTick & (WHEEL_SLOTS - 1);
+    Timer* timer = slots[0][slot];
+    slots[0][slot] = nullptr;
+    
+    while (timer) {
+        Timer* next = timer->next;
+        timers.erase(timer->id);
+        expired.push_back(timer);
+        timer = next;
+    }
+}
+
+TimerID TimerWheel::schedule(long delayMillis, const std::function<void()>& callback) {
+    uint64_t ticks = delayMillis > 0 ? (delayMillis + tickMillis - 1) / tickMillis : 0;
+    if (ticks == 0) ticks = 1;
+    
+    Timer* timer = new Timer();
+    timer->callback = callback;
+    
+    std::lock_guard<std::mutex> lock(wheelMutex);
+    timer->id = nextID++;
+    timer->deadline = currentTick + ticks;
+    link(timer);
+    timers[timer->id] = timer;
+    return timer->id;
+}
+
+bool TimerWheel::cancel(TimerID id) {
+    Timer* timer;
+    {
+        std::lock_guard<std::mutex> lock(wheelMutex);
+        auto it = timers.find(id);
+        if (it == timers.end()) return false;
+        
+        timer = it->second;
+        timers.erase(it);
+        unlink(timer);
+    }
+    delete timer;
+    return true;
+}
+
+int TimerWheel::advance(uint64_t ticks) {
+    int fired = 0;
+    std::vector<Timer*> expired;
+    
+    for (uint64_t i = 0; i < ticks; i++) {
+        {
+            std::lock_guard<std::mutex> lock(wheelMutex);
+            tickLocked(expired);
+        }
+        
+        // Callbacks of one tick run before the next tick is taken
+        for (Timer* timer : expired) {
+            if (timer->callback) timer->callback();
+            delete timer;
+        }
+        fired += expired.size();
+        expired.clear();
+    }
+    
+    return fired;
+}
+
+size_t TimerWheel::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(wheelMutex);
+    return timers.size();
+}
+
+uint64_t TimerWheel::getCurrentTick() const {
+    std::lock_guard<std::mutex> lock(wheelMutex);
+    return currentTick;
+}
+
+// Ticks are derived from a steady clock, so a slow callback delays later
+// ticks but never drops them
+void TimerWheel::tickLoop() {
+    auto start = std::chrono::steady_clock::now();
+    uint64_t ticked = 0;
+    
+    std::unique_lock<std::mutex> lock(signalMutex);
+    while (!stopping) {
+        auto next = start + std::chrono::milliseconds(tickMillis * (ticked + 1));
+        stopSignal.wait_until(lock, next);
+        if (stopping) break;
+        
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        uint64_t due = elapsed / tickMillis;
+        if (due <= ticked) continue;
+        
+        lock.unlock();
+        advance(due - ticked);
+        lock.lock();
+        ticked = due;
+    }
+}
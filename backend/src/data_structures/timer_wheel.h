@@ -0,0 +1,76 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+// 64 slots per level; four levels cover 64^4 ticks (about 194 days at 1 s)
+const int WHEEL_SLOT_BITS = 6;
+const int WHEEL_SLOTS = 1 << WHEEL_SLOT_BITS;
+const int WHEEL_LEVELS = 4;
+
+typedef uint64_t TimerID;
+
+// Hierarchical timing wheel. Timers live in intrusive per-slot lists, so
+// schedule and cancel are O(1) regardless of how many are pending; each
+// tick touches one level-0 slot and, every 64 ticks, cascades one slot of
+// the level above down into finer slots. Callbacks run on the thread that
+// advances the wheel, outside the wheel's lock, so they may schedule or
+// cancel timers themselves.
+class TimerWheel {
+private:
+    struct Timer {
+        TimerID id;
+        uint64_t deadline;    // Absolute tick
+        std::function<void()> callback;
+        Timer** bucket;       // Head pointer of the slot holding this timer
+        Timer* prev;
+        Timer* next;
+    };
+    
+    // Head of each slot's doubly linked list
+    Timer* slots[WHEEL_LEVELS][WHEEL_SLOTS];
+    std::unordered_map<TimerID, Timer*> timers;
+    uint64_t currentTick;
+    TimerID nextID;
+    long tickMillis;
+    mutable std::mutex wheelMutex;
+    
+    std::thread tickThread;
+    std::mutex signalMutex;
+    std::condition_variable stopSignal;
+    bool stopping;
+    
+    void link(Timer* timer);
+    void unlink(Timer* timer);
+    void cascade(int level);
+    void tickLocked(std::vector<Timer*>& expired);
+    void tickLoop();
+
+public:
+    // With background = false the wheel only moves via advance()
+    TimerWheel(long tickMillis = 1000, bool background = true);
+    ~TimerWheel();
+    
+    // Fire `callback` after `delayMillis` (rounded up to whole ticks, at
+    // least one). Returns an ID for cancel().
+    TimerID schedule(long delayMillis, const std::function<void()>& callback);
+    
+    // False if the timer already fired or was cancelled
+    bool cancel(TimerID id);
+    
+    // Move the wheel forward by `ticks`, running due callbacks; returns
+    // the number fired
+    int advance(uint64_t ticks = 1);
+    
+    size_t getPendingCount() const;
+    uint64_t getCurrentTick() const;
+    long getTickMillis() const { return tickMillis; }
+};
+
+#endif
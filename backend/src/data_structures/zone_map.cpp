@@ -0,0 +1,274 @@
+#include "zone_map.h"
+#include <iostream>
+#include <cfloat>
+#include <cstring>
+#include "bloom_filter.h"
+
+// ==================== VitalZone ====================
+
+VitalZone::VitalZone() {
+    reset();
+}
+
+void VitalZone::reset() {
+    recordCount = 0;
+    for (int f = 0; f < NUM_VITAL_FIELDS; f++) {
+        minValue[f] = DBL_MAX;
+        maxValue[f] = -DBL_MAX;
+    }
+    std::memset(patientBits, 0, sizeof(patientBits));
+}
+
+void VitalZone::update(const VitalRecord& record) {
+    for (int f = 0; f < NUM_VITAL_FIELDS; f++) {
+        double value = record.getField(static_cast<VitalField>(f));
+        if (value < minValue[f]) minValue[f] = value;
+        if (value > maxValue[f]) maxValue[f] = value;
+    }
+    BloomFilter::addKey(patientBits, ZONE_PATIENT_FILTER_WORDS * 64,
+                        ZONE_PATIENT_FILTER_HASHES, record.patientID);
+    recordCount++;
+}
+
+bool VitalZone::mayContainPatient(int patientID) const {
+    return BloomFilter::testKey(patientBits, ZONE_PATIENT_FILTER_WORDS * 64,
+                                ZONE_PATIENT_FILTER_HASHES, patientID);
+}
+
+bool VitalZone::mayMatch(const VitalPredicate& predicate) const {
+    if (recordCount == 0) return false;
+    
+    double lo = minValue[predicate.field];
+    double hi = maxValue[predicate.field];
+    
+    switch (predicate.op) {
+        case OP_LESS:          return lo < predicate.value;
+        case OP_LESS_EQUAL:    return lo <= predicate.value;
+        case OP_GREATER:       return hi > predicate.value;
+        case OP_GREATER_EQUAL: return hi >= predicate.value;
+        case OP_EQUAL:
+            if (predicate.value < lo || predicate.value > hi) return false;
+            if (predicate.field == FIELD_PATIENT_ID) {
+                return mayContainPatient(static_cast<int>(predicate.value));
+            }
+            return true;
+        default:               return true;
+    }
+}
+
+bool VitalZone::mayMatchAll(const std::vector<VitalPredicate>& predicates) const {
+    for (const auto& predicate : predicates) {
+        if (!mayMatch(predicate)) return false;
+    }
+    return true;
+}
+
+bool VitalZone::overlapsTime(long startTime, long endTime) const {
+    return recordCount > 0 &&
+           minValue[FIELD_TIMESTAMP] <= endTime &&
+           maxValue[FIELD_TIMESTAMP] >= startTime;
+}
+
+size_t VitalZone::getDiskSize() {
+    return sizeof(int) + sizeof(double) * NUM_VITAL_FIELDS * 2 +
+           sizeof(uint64_t) * ZONE_PATIENT_FILTER_WORDS;
+}
+
+void VitalZone::writeToDisk(std::ofstream& file) const {
+    file.write(reinterpret_cast<const char*>(&recordCount), sizeof(recordCount));
+    file.write(reinterpret_cast<const char*>(minValue), sizeof(minValue));
+    file.write(reinterpret_cast<const char*>(maxValue), sizeof(maxValue));
+    file.write(reinterpret_cast<const char*>(patientBits), sizeof(patientBits));
+}
+
+void VitalZone::readFromDisk(std::ifstream& file) {
+    file.read(reinterpret_cast<char*>(&recordCount), sizeof(recordCount));
+    file.read(reinterpret_cast<char*>(minValue), sizeof(minValue));
+    file.read(reinterpret_cast<char*>(maxValue), sizeof(maxValue));
+    file.read(reinterpret_cast<char*>(patientBits), sizeof(patientBits));
+}
+
+// ==================== ZoneMapIndex ====================
+
+ZoneMapIndex::ZoneMapIndex(const std::string& filePath)
+    : filePath(filePath) {
+    loadFromDisk();
+}
+
+long ZoneMapIndex::getBlockBytes() {
+    return VitalRecord::getDiskSize() * ZONE_CHUNK_RECORDS;
+}
+
+int ZoneMapIndex::getBlockIndex(long dataPosition) {
+    return dataPosition / getBlockBytes();
+}
+
+int ZoneMapIndex::getCoveredRecords() const {
+    int covered = 0;
+    for (const auto& zone : zones) {
+        covered += zone.recordCount;
+    }
+    return covered;
+}
+
+void ZoneMapIndex::recordInserted(long dataPosition, const VitalRecord& record) {
+    int block = getBlockIndex(dataPosition);
+    if (block >= static_cast<int>(zones.size())) {
+        zones.resize(block + 1);
+    }
+    
+    zones[block].update(record);
+    
+    // Persist each block once it is complete; the open tail block is
+    // written on shutdown and recomputed by catchUp() after a crash
+    if (zones[block].recordCount == ZONE_CHUNK_RECORDS) {
+        writeZone(block);
+    }
+}
+
+std::vector<int> ZoneMapIndex::findCandidateBlocks(long startTime, long endTime,
+                                                   const std::vector<VitalPredicate>& predicates) const {
+    std::vector<int> candidates;
+    
+    for (int block = 0; block < static_cast<int>(zones.size()); block++) {
+        const VitalZone& zone = zones[block];
+        if (zone.overlapsTime(startTime, endTime) && zone.mayMatchAll(predicates)) {
+            candidates.push_back(block);
+        }
+    }
+    
+    return candidates;
+}
+
+bool ZoneMapIndex::blockMayMatch(long dataPosition, const std::vector<VitalPredicate>& predicates) const {
+    int block = getBlockIndex(dataPosition);
+    if (block >= static_cast<int>(zones.size())) return true;
+    return zones[block].mayMatchAll(predicates);
+}
+
+void ZoneMapIndex::catchUp(const std::string& dataFilePath, int totalRecords) {
+    // Persisted zones must be full blocks, except possibly the last, and
+    // cannot cover more records than the data file holds
+    bool consistent = getCoveredRecords() <= totalRecords;
+    for (size_t block = 0; consistent && block < zones.size(); block++) {
+        int count = zones[block].recordCount;
+        bool last = block + 1 == zones.size();
+        consistent = last ? (count >= 0 && count <= ZONE_CHUNK_RECORDS) : count == ZONE_CHUNK_RECORDS;
+    }
+    if (!consistent) {
+        std::cout << "[ZONE-MAP] Zone file does not match the data file; rebuilding" << std::endl;
+        zones.clear();
+        resetFile();
+    } else if (getCoveredRecords() == totalRecords) {
+        return;
+    }
+    
+    // Drop the (possibly partial) last block and rebuild from there
+    int firstBlock = zones.empty() ? 0 : zones.size() - 1;
+    long firstRecord = static_cast<long>(firstBlock) * ZONE_CHUNK_RECORDS;
+    zones.resize(firstBlock);
+    
+    std::ifstream file(dataFilePath, std::ios::binary);
+    if (!file.is_open()) return;
+    
+    long recordSize = VitalRecord::getDiskSize();
+    file.seekg(firstRecord * recordSize);
+    
+    for (long i = firstRecord; i < totalRecords; i++) {
+        VitalRecord record;
+        record.readFromDisk(file);
+        if (!file) break;
+        recordInserted(i * recordSize, record);
+    }
+    
+    file.close();
+    std::cout << "[ZONE-MAP] Rebuilt summaries for " << (totalRecords - firstRecord)
+              << " records" << std::endl;
+}
+
+void ZoneMapIndex::clear() {
+    zones.clear();
+    resetFile();
+}
+
+long ZoneMapIndex::getHeaderSize() {
+    return sizeof(ZONE_FILE_MAGIC) + sizeof(ZONE_FILE_VERSION);
+}
+
+void ZoneMapIndex::writeHeader(std::ofstream& file) const {
+    file.write(reinterpret_cast<const char*>(&ZONE_FILE_MAGIC), sizeof(ZONE_FILE_MAGIC));
+    file.write(reinterpret_cast<const char*>(&ZONE_FILE_VERSION), sizeof(ZONE_FILE_VERSION));
+}
+
+// Replace the file with an empty, current-layout one
+void ZoneMapIndex::resetFile() {
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "[ZONE-MAP] Error: Cannot open file for writing: " << filePath << std::endl;
+        return;
+    }
+    writeHeader(file);
+    file.close();
+}
+
+void ZoneMapIndex::writeZone(int index) {
+    std::ifstream test(filePath);
+    bool exists = test.good();
+    test.close();
+    if (!exists) resetFile();
+    
+    std::ofstream file(filePath, std::ios::binary | std::ios::in | std::ios::out);
+    if (!file.is_open()) {
+        std::cerr << "[ZONE-MAP] Error: Cannot open file for writing: " << filePath << std::endl;
+        return;
+    }
+    
+    file.seekp(getHeaderSize() + static_cast<long>(index) * VitalZone::getDiskSize());
+    zones[index].writeToDisk(file);
+    file.close();
+}
+
+void ZoneMapIndex::saveToDisk() {
+    std::ofstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "[ZONE-MAP] Error: Cannot open file for writing: " << filePath << std::endl;
+        return;
+    }
+    
+    writeHeader(file);
+    for (const auto& zone : zones) {
+        zone.writeToDisk(file);
+    }
+    file.close();
+}
+
+void ZoneMapIndex::loadFromDisk() {
+    zones.clear();
+    
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open()) return;
+    
+    // A file without the current header (older layouts had none) is
+    // dropped; catchUp() rebuilds it from the data file
+    uint32_t magic = 0, version = 0;
+    file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    file.seekg(0, std::ios::end);
+    long fileSize = file.tellg();
+    file.seekg(getHeaderSize());
+    if (!file || magic != ZONE_FILE_MAGIC || version != ZONE_FILE_VERSION ||
+        (fileSize - getHeaderSize()) % static_cast<long>(VitalZone::getDiskSize()) != 0) {
+        std::cout << "[ZONE-MAP] Discarding zone file with old or unknown layout" << std::endl;
+        file.close();
+        resetFile();
+        return;
+    }
+    
+    while (true) {
+        VitalZone zone;
+        zone.readFromDisk(file);
+        if (!file) break;
+        zones.push_back(zone);
+    }
+    file.close();
+}
@@ -0,0 +1,100 @@
+#ifndef ZONE_MAP_H
+#define ZONE_MAP_H
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstdint>
+#include "../models/vital_record.h"
+
+// Records per zone-map block. Blocks follow the append order of the
+// vitals data file, so block i covers data positions
+// [i * ZONE_CHUNK_RECORDS, (i + 1) * ZONE_CHUNK_RECORDS) records.
+const int ZONE_CHUNK_RECORDS = 64;
+
+// Per-block patientID bloom filter: 512 bits, 4 probes (~2% false
+// positives at 64 distinct patients, far less in practice)
+const int ZONE_PATIENT_FILTER_WORDS = 8;
+const int ZONE_PATIENT_FILTER_HASHES = 4;
+
+// Zone files start with [magic][version]; anything else is rebuilt.
+// Version 2 added the patient filter.
+const uint32_t ZONE_FILE_MAGIC = 0x5A4D4150;    // "ZMAP"
+const uint32_t ZONE_FILE_VERSION = 2;
+
+// Min/max summary of every vital field over one block, plus a bloom
+// filter over the patients it contains
+struct VitalZone {
+    int recordCount;
+    double minValue[NUM_VITAL_FIELDS];
+    double maxValue[NUM_VITAL_FIELDS];
+    uint64_t patientBits[ZONE_PATIENT_FILTER_WORDS];
+    
+    VitalZone();
+    
+    void reset();
+    void update(const VitalRecord& record);
+    
+    // False only if no record in the block can satisfy the condition
+    bool mayMatch(const VitalPredicate& predicate) const;
+    bool mayMatchAll(const std::vector<VitalPredicate>& predicates) const;
+    bool mayContainPatient(int patientID) const;
+    bool overlapsTime(long startTime, long endTime) const;
+    
+    static size_t getDiskSize();
+    void writeToDisk(std::ofstream& file) const;
+    void readFromDisk(std::ifstream& file);
+};
+
+// How much of the data file a zone-map scan actually touched
+struct ZoneScanStats {
+    int blocksTotal;
+    int blocksScanned;
+    
+    ZoneScanStats() : blocksTotal(0), blocksScanned(0) {}
+};
+
+// Per-block zone maps for a vitals data file, maintained on ingest
+class ZoneMapIndex {
+private:
+    std::vector<VitalZone> zones;
+    std::string filePath;
+    
+    void writeZone(int index);
+    void writeHeader(std::ofstream& file) const;
+    void resetFile();
+    static long getHeaderSize();
+
+public:
+    ZoneMapIndex(const std::string& filePath);
+    
+    // Fold a newly written record into its block summary
+    void recordInserted(long dataPosition, const VitalRecord& record);
+    
+    // Blocks whose summaries overlap the window and can match all predicates
+    std::vector<int> findCandidateBlocks(long startTime, long endTime,
+                                         const std::vector<VitalPredicate>& predicates) const;
+    
+    // False if the block holding dataPosition provably has no match
+    bool blockMayMatch(long dataPosition, const std::vector<VitalPredicate>& predicates) const;
+    
+    const VitalZone& getZone(int block) const { return zones[block]; }
+    int getBlockCount() const { return zones.size(); }
+    int getCoveredRecords() const;
+    
+    static long getBlockBytes();
+    static int getBlockIndex(long dataPosition);
+    
+    // Recompute summaries for records written after the last persisted
+    // block. Zones that cannot describe the first totalRecords records
+    // (short interior blocks, more records than the data file) are
+    // discarded and rebuilt from the start.
+    void catchUp(const std::string& dataFilePath, int totalRecords);
+    void clear();
+    
+    // Disk persistence
+    void saveToDisk();
+    void loadFromDisk();
+};
+
+#endif
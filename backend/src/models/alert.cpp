@@ -5,12 +5,14 @@
 Alert::Alert() 
     : alertID(0), patientID(0), priority(INFO), type(CUSTOM),
       message(""), timestamp(0), acknowledged(false), 
-      acknowledgedBy(""), acknowledgedTime(0) {}
+      acknowledgedBy(""), acknowledgedTime(0), occurrenceCount(1), lastSeenTime(0) {}
 
 Alert::Alert(int id, int pid, AlertPriority prio, AlertType t, const std::string& msg)
     : alertID(id), patientID(pid), priority(prio), type(t),
-      message(msg), acknowledged(false), acknowledgedBy(""), acknowledgedTime(0) {
+      message(msg), acknowledged(false), acknowledgedBy(""), acknowledgedTime(0),
+      occurrenceCount(1) {
     timestamp = time(nullptr);
+    lastSeenTime = timestamp;
 }
 
 std::string Alert::getPriorityString() const {
@@ -51,6 +53,10 @@ void Alert::display() const {
     strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", timeinfo);
     std::cout << "│ Time: " << std::setw(44) << timeStr << "│" << std::endl;
     
+    if (occurrenceCount > 1) {
+        std::cout << "│ Repeated: " << std::setw(40) << (std::to_string(occurrenceCount) + " times") << "│" << std::endl;
+    }
+    
     if (acknowledged) {
         std::cout << "│ ✅ Acknowledged by: " << std::setw(29) << acknowledgedBy << "│" << std::endl;
     } else {
@@ -60,7 +66,7 @@ void Alert::display() const {
     std::cout << "└─────────────────────────────────────────────────────┘" << std::endl;
 }
 
-void Alert::writeToDisk(std::ofstream& file) const {
+void Alert::writeToDisk(std::ostream& file) const {
     // Write primitive types
     file.write(reinterpret_cast<const char*>(&alertID), sizeof(alertID));
     file.write(reinterpret_cast<const char*>(&patientID), sizeof(patientID));
@@ -79,9 +85,12 @@ void Alert::writeToDisk(std::ofstream& file) const {
     
     writeString(message);
     writeString(acknowledgedBy);
+    
+    file.write(reinterpret_cast<const char*>(&occurrenceCount), sizeof(occurrenceCount));
+    file.write(reinterpret_cast<const char*>(&lastSeenTime), sizeof(lastSeenTime));
 }
 
-void Alert::readFromDisk(std::ifstream& file) {
+void Alert::readFromDisk(std::istream& file, int version) {
     // Read primitive types
     file.read(reinterpret_cast<char*>(&alertID), sizeof(alertID));
     file.read(reinterpret_cast<char*>(&patientID), sizeof(patientID));
@@ -105,6 +114,14 @@ void Alert::readFromDisk(std::ifstream& file) {
     
     message = readString();
     acknowledgedBy = readString();
+    
+    if (version >= 2) {
+        file.read(reinterpret_cast<char*>(&occurrenceCount), sizeof(occurrenceCount));
+        file.read(reinterpret_cast<char*>(&lastSeenTime), sizeof(lastSeenTime));
+    } else {
+        occurrenceCount = 1;
+        lastSeenTime = timestamp;
+    }
 }
 
 // Comparison operators for min-heap
@@ -15,6 +15,9 @@ enum AlertPriority {
     INFO = 5         // General notification
 };
 
+// On-disk layout of an Alert; version 1 lacked the coalescing fields
+const int ALERT_DISK_VERSION = 2;
+
 // Alert types
 enum AlertType {
     VITAL_ABNORMAL,      // Vital signs out of range
@@ -36,6 +39,8 @@ struct Alert {
     bool acknowledged;       // Has someone seen this?
     std::string acknowledgedBy;
     long acknowledgedTime;
+    int occurrenceCount;     // Repeats merged into this alert (1 = no repeats)
+    long lastSeenTime;       // Timestamp of the latest merged repeat (see getLastSeenTime)
     
     // Constructors
     Alert();
@@ -46,9 +51,12 @@ struct Alert {
     std::string getPriorityString() const;
     std::string getTypeString() const;
     
+    // Latest occurrence; the creation time until a repeat has been merged
+    long getLastSeenTime() const { return occurrenceCount > 1 ? lastSeenTime : timestamp; }
+    
     // Disk I/O
-    void writeToDisk(std::ofstream& file) const;
-    void readFromDisk(std::ifstream& file);
+    void writeToDisk(std::ostream& file) const;
+    void readFromDisk(std::istream& file, int version = ALERT_DISK_VERSION);
     
     // Comparison operators for heap operations
     bool operator<(const Alert& other) const;
@@ -0,0 +1,152 @@
+#include "vital_batch.h"
+#include <cstring>
+
+void VitalBatch::reserve(size_t n) {
+    patientID.reserve(n);
+    timestamp.reserve(n);
+    heart_rate.reserve(n);
+    systolic_bp.reserve(n);
+    diastolic_bp.reserve(n);
+    spo2.reserve(n);
+    temperature.reserve(n);
+}
+
+void VitalBatch::clear() {
+    patientID.clear();
+    timestamp.clear();
+    heart_rate.clear();
+    systolic_bp.clear();
+    diastolic_bp.clear();
+    spo2.clear();
+    temperature.clear();
+}
+
+void VitalBatch::append(const VitalRecord& record) {
+    patientID.push_back(record.patientID);
+    timestamp.push_back(record.timestamp);
+    heart_rate.push_back(record.heart_rate);
+    systolic_bp.push_back(record.systolic_bp);
+    diastolic_bp.push_back(record.diastolic_bp);
+    spo2.push_back(record.spo2);
+    temperature.push_back(record.temperature);
+}
+
+void VitalBatch::appendEncoded(const char* buffer, size_t count) {
+    size_t base = size();
+    patientID.resize(base + count);
+    timestamp.resize(base + count);
+    heart_rate.resize(base + count);
+    systolic_bp.resize(base + count);
+    diastolic_bp.resize(base + count);
+    spo2.resize(base + count);
+    temperature.resize(base + count);
+    
+    for (size_t i = 0; i < count; i++) {
+        PackedVitalRecord packed;
+        memcpy(&packed, buffer + i * sizeof(PackedVitalRecord), sizeof(packed));
+        patientID[base + i] = packed.patientID;
+        timestamp[base + i] = packed.timestamp;
+        heart_rate[base + i] = packed.heart_rate;
+        systolic_bp[base + i] = packed.systolic_bp;
+        diastolic_bp[base + i] = packed.diastolic_bp;
+        spo2[base + i] = packed.spo2;
+        temperature[base + i] = packed.temperature;
+    }
+}
+
+VitalRecord VitalBatch::getRecord(size_t index) const {
+    return VitalRecord(patientID[index], timestamp[index], heart_rate[index],
+                       systolic_bp[index], diastolic_bp[index], spo2[index],
+                       temperature[index]);
+}
+
+VitalBatch VitalBatch::fromRecords(const std::vector<VitalRecord>& records) {
+    VitalBatch batch;
+    batch.reserve(records.size());
+    for (const auto& record : records) {
+        batch.append(record);
+    }
+    return batch;
+}
+
+std::vector<VitalRecord> VitalBatch::toRecords() const {
+    std::vector<VitalRecord> records;
+    records.reserve(size());
+    for (size_t i = 0; i < size(); i++) {
+        records.push_back(getRecord(i));
+    }
+    return records;
+}
+
+// Branch-free min/max/sum over one contiguous column
+template <typename T>
+static VitalColumnStats summarizeColumn(const T* values, size_t count) {
+    VitalColumnStats stats;
+    stats.count = count;
+    if (count == 0) return stats;
+    
+    T lo = values[0];
+    T hi = values[0];
+    double sum = 0;
+    for (size_t i = 0; i < count; i++) {
+        lo = values[i] < lo ? values[i] : lo;
+        hi = values[i] > hi ? values[i] : hi;
+        sum += values[i];
+    }
+    
+    stats.min = lo;
+    stats.max = hi;
+    stats.mean = sum / count;
+    return stats;
+}
+
+template <typename T>
+static size_t countColumn(const T* values, size_t count, CompareOp op, double threshold) {
+    size_t matches = 0;
+    switch (op) {
+        case OP_LESS:
+            for (size_t i = 0; i < count; i++) matches += values[i] < threshold;
+            break;
+        case OP_LESS_EQUAL:
+            for (size_t i = 0; i < count; i++) matches += values[i] <= threshold;
+            break;
+        case OP_GREATER:
+            for (size_t i = 0; i < count; i++) matches += values[i] > threshold;
+            break;
+        case OP_GREATER_EQUAL:
+            for (size_t i = 0; i < count; i++) matches += values[i] >= threshold;
+            break;
+        case OP_EQUAL:
+            for (size_t i = 0; i < count; i++) matches += values[i] == threshold;
+            break;
+    }
+    return matches;
+}
+
+VitalColumnStats VitalBatch::summarize(VitalField field) const {
+    switch (field) {
+        case FIELD_PATIENT_ID:   return summarizeColumn(patientID.data(), size());
+        case FIELD_TIMESTAMP:    return summarizeColumn(timestamp.data(), size());
+        case FIELD_HEART_RATE:   return summarizeColumn(heart_rate.data(), size());
+        case FIELD_SYSTOLIC_BP:  return summarizeColumn(systolic_bp.data(), size());
+        case FIELD_DIASTOLIC_BP: return summarizeColumn(diastolic_bp.data(), size());
+        case FIELD_SPO2:         return summarizeColumn(spo2.data(), size());
+        case FIELD_TEMPERATURE:  return summarizeColumn(temperature.data(), size());
+        default:                 return VitalColumnStats();
+    }
+}
+
+size_t VitalBatch::countMatching(const VitalPredicate& predicate) const {
+    CompareOp op = predicate.op;
+    double value = predicate.value;
+    switch (predicate.field) {
+        case FIELD_PATIENT_ID:   return countColumn(patientID.data(), size(), op, value);
+        case FIELD_TIMESTAMP:    return countColumn(timestamp.data(), size(), op, value);
+        case FIELD_HEART_RATE:   return countColumn(heart_rate.data(), size(), op, value);
+        case FIELD_SYSTOLIC_BP:  return countColumn(systolic_bp.data(), size(), op, value);
+        case FIELD_DIASTOLIC_BP: return countColumn(diastolic_bp.data(), size(), op, value);
+        case FIELD_SPO2:         return countColumn(spo2.data(), size(), op, value);
+        case FIELD_TEMPERATURE:  return countColumn(temperature.data(), size(), op, value);
+        default:                 return 0;
+    }
+}
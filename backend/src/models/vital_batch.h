@@ -0,0 +1,83 @@
+#ifndef VITAL_BATCH_H
+#define VITAL_BATCH_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include "vital_record.h"
+
+// Column storage is aligned to a cache line so loops over a column start
+// on a vector-register boundary
+const size_t VITAL_BATCH_ALIGNMENT = 64;
+
+template <typename T>
+struct AlignedAllocator {
+    typedef T value_type;
+    
+    AlignedAllocator() {}
+    template <typename U> AlignedAllocator(const AlignedAllocator<U>&) {}
+    
+    T* allocate(size_t n) {
+        void* memory = nullptr;
+        size_t bytes = n * sizeof(T);
+        if (bytes == 0) bytes = 1;
+        if (posix_memalign(&memory, VITAL_BATCH_ALIGNMENT, bytes) != 0) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(memory);
+    }
+    
+    void deallocate(T* p, size_t) { free(p); }
+    
+    template <typename U> bool operator==(const AlignedAllocator<U>&) const { return true; }
+    template <typename U> bool operator!=(const AlignedAllocator<U>&) const { return false; }
+};
+
+template <typename T>
+using VitalColumn = std::vector<T, AlignedAllocator<T>>;
+
+// Summary of one column over a batch
+struct VitalColumnStats {
+    size_t count;
+    double min;
+    double max;
+    double mean;
+    
+    VitalColumnStats() : count(0), min(0), max(0), mean(0) {}
+};
+
+// Structure-of-arrays view of vital readings: each field is its own
+// contiguous, aligned column. Analytics (statistics, thresholds, charts)
+// loop over the columns they need instead of striding through
+// VitalRecord structs.
+struct VitalBatch {
+    VitalColumn<int32_t> patientID;
+    VitalColumn<int64_t> timestamp;
+    VitalColumn<int32_t> heart_rate;
+    VitalColumn<int32_t> systolic_bp;
+    VitalColumn<int32_t> diastolic_bp;
+    VitalColumn<int32_t> spo2;
+    VitalColumn<float> temperature;
+    
+    size_t size() const { return timestamp.size(); }
+    bool empty() const { return timestamp.empty(); }
+    void reserve(size_t n);
+    void clear();
+    
+    void append(const VitalRecord& record);
+    // Decode `count` consecutive on-disk records straight into the columns
+    void appendEncoded(const char* buffer, size_t count);
+    VitalRecord getRecord(size_t index) const;
+    
+    // Conversion helpers
+    static VitalBatch fromRecords(const std::vector<VitalRecord>& records);
+    std::vector<VitalRecord> toRecords() const;
+    
+    // Column kernels
+    VitalColumnStats summarize(VitalField field) const;
+    size_t countMatching(const VitalPredicate& predicate) const;
+};
+
+#endif
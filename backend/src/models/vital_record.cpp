@@ -1,6 +1,9 @@
 #include "vital_record.h"
 #include <iostream>
 #include <iomanip>
+#include <cstdlib>
+#include <cstring>
+#include <cstddef>
 
 VitalRecord::VitalRecord() 
     : patientID(0), timestamp(0), heart_rate(0), 
@@ -23,25 +26,256 @@ void VitalRecord::display() const {
 }
 
 void VitalRecord::writeToDisk(std::ofstream& file) const {
-    file.write(reinterpret_cast<const char*>(&patientID), sizeof(patientID));
-    file.write(reinterpret_cast<const char*>(&timestamp), sizeof(timestamp));
-    file.write(reinterpret_cast<const char*>(&heart_rate), sizeof(heart_rate));
-    file.write(reinterpret_cast<const char*>(&systolic_bp), sizeof(systolic_bp));
-    file.write(reinterpret_cast<const char*>(&diastolic_bp), sizeof(diastolic_bp));
-    file.write(reinterpret_cast<const char*>(&spo2), sizeof(spo2));
-    file.write(reinterpret_cast<const char*>(&temperature), sizeof(temperature));
+    char buffer[VITAL_RECORD_DISK_SIZE];
+    encode(buffer);
+    file.write(buffer, sizeof(buffer));
 }
 
 void VitalRecord::readFromDisk(std::ifstream& file) {
-    file.read(reinterpret_cast<char*>(&patientID), sizeof(patientID));
-    file.read(reinterpret_cast<char*>(&timestamp), sizeof(timestamp));
-    file.read(reinterpret_cast<char*>(&heart_rate), sizeof(heart_rate));
-    file.read(reinterpret_cast<char*>(&systolic_bp), sizeof(systolic_bp));
-    file.read(reinterpret_cast<char*>(&diastolic_bp), sizeof(diastolic_bp));
-    file.read(reinterpret_cast<char*>(&spo2), sizeof(spo2));
-    file.read(reinterpret_cast<char*>(&temperature), sizeof(temperature));
+    char buffer[VITAL_RECORD_DISK_SIZE];
+    if (file.read(buffer, sizeof(buffer))) {
+        decode(buffer);
+    }
 }
 
 size_t VitalRecord::getDiskSize() {
-    return sizeof(int) * 5 + sizeof(long) + sizeof(float);
-}
\ No newline at end of file
+    return sizeof(PackedVitalRecord);
+}
+
+void VitalRecord::pack(PackedVitalRecord& packed) const {
+    packed.patientID = patientID;
+    packed.timestamp = timestamp;
+    packed.heart_rate = heart_rate;
+    packed.systolic_bp = systolic_bp;
+    packed.diastolic_bp = diastolic_bp;
+    packed.spo2 = spo2;
+    packed.temperature = temperature;
+}
+
+void VitalRecord::unpack(const PackedVitalRecord& packed) {
+    patientID = packed.patientID;
+    timestamp = packed.timestamp;
+    heart_rate = packed.heart_rate;
+    systolic_bp = packed.systolic_bp;
+    diastolic_bp = packed.diastolic_bp;
+    spo2 = packed.spo2;
+    temperature = packed.temperature;
+}
+
+void VitalRecord::encode(char* buffer) const {
+    PackedVitalRecord packed;
+    pack(packed);
+    memcpy(buffer, &packed, sizeof(packed));
+}
+
+void VitalRecord::decode(const char* buffer) {
+    PackedVitalRecord packed;
+    memcpy(&packed, buffer, sizeof(packed));
+    unpack(packed);
+}
+
+// Straight-line loop over fixed-size records: no stream calls and no
+// per-field branching, so the compiler can unroll and vectorise it
+void VitalRecord::decodeBatch(const char* buffer, size_t count, std::vector<VitalRecord>& out,
+                              long firstPosition) {
+    size_t base = out.size();
+    out.resize(base + count);
+    VitalRecord* dest = out.data() + base;
+    
+    for (size_t i = 0; i < count; i++) {
+        PackedVitalRecord packed;
+        memcpy(&packed, buffer + i * sizeof(PackedVitalRecord), sizeof(packed));
+        dest[i].unpack(packed);
+        dest[i].diskPosition = firstPosition < 0 ? -1 :
+                               firstPosition + static_cast<long>(i * sizeof(PackedVitalRecord));
+    }
+}
+
+double VitalRecord::getField(VitalField field) const {
+    switch (field) {
+        case FIELD_PATIENT_ID:   return patientID;
+        case FIELD_TIMESTAMP:    return timestamp;
+        case FIELD_HEART_RATE:   return heart_rate;
+        case FIELD_SYSTOLIC_BP:  return systolic_bp;
+        case FIELD_DIASTOLIC_BP: return diastolic_bp;
+        case FIELD_SPO2:         return spo2;
+        case FIELD_TEMPERATURE:  return temperature;
+        default:                 return 0;
+    }
+}
+
+bool VitalRecord::parseField(const std::string& name, VitalField& field) {
+    for (int f = 0; f < NUM_VITAL_FIELDS; f++) {
+        if (getFieldName(static_cast<VitalField>(f)) == name) {
+            field = static_cast<VitalField>(f);
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string VitalRecord::getFieldName(VitalField field) {
+    switch (field) {
+        case FIELD_PATIENT_ID:   return "patientID";
+        case FIELD_TIMESTAMP:    return "timestamp";
+        case FIELD_HEART_RATE:   return "heart_rate";
+        case FIELD_SYSTOLIC_BP:  return "systolic_bp";
+        case FIELD_DIASTOLIC_BP: return "diastolic_bp";
+        case FIELD_SPO2:         return "spo2";
+        case FIELD_TEMPERATURE:  return "temperature";
+        default:                 return "unknown";
+    }
+}
+
+size_t VitalRecord::getFieldOffset(VitalField field) {
+    switch (field) {
+        case FIELD_PATIENT_ID:   return offsetof(PackedVitalRecord, patientID);
+        case FIELD_TIMESTAMP:    return offsetof(PackedVitalRecord, timestamp);
+        case FIELD_HEART_RATE:   return offsetof(PackedVitalRecord, heart_rate);
+        case FIELD_SYSTOLIC_BP:  return offsetof(PackedVitalRecord, systolic_bp);
+        case FIELD_DIASTOLIC_BP: return offsetof(PackedVitalRecord, diastolic_bp);
+        case FIELD_SPO2:         return offsetof(PackedVitalRecord, spo2);
+        case FIELD_TEMPERATURE:  return offsetof(PackedVitalRecord, temperature);
+        default:                 return 0;
+    }
+}
+
+double VitalRecord::decodeField(const char* buffer, VitalField field) {
+    const char* src = buffer + getFieldOffset(field);
+    
+    if (field == FIELD_TIMESTAMP) {
+        int64_t value;
+        memcpy(&value, src, sizeof(value));
+        return value;
+    }
+    if (field == FIELD_TEMPERATURE) {
+        float value;
+        memcpy(&value, src, sizeof(value));
+        return value;
+    }
+    
+    int32_t value;
+    memcpy(&value, src, sizeof(value));
+    return value;
+}
+
+void VitalRecord::decodeFields(const char* buffer, unsigned fieldMask) {
+    PackedVitalRecord packed;
+    memcpy(&packed, buffer, sizeof(packed));
+    
+    if ((fieldMask >> FIELD_PATIENT_ID) & 1u)   patientID = packed.patientID;
+    if ((fieldMask >> FIELD_TIMESTAMP) & 1u)    timestamp = packed.timestamp;
+    if ((fieldMask >> FIELD_HEART_RATE) & 1u)   heart_rate = packed.heart_rate;
+    if ((fieldMask >> FIELD_SYSTOLIC_BP) & 1u)  systolic_bp = packed.systolic_bp;
+    if ((fieldMask >> FIELD_DIASTOLIC_BP) & 1u) diastolic_bp = packed.diastolic_bp;
+    if ((fieldMask >> FIELD_SPO2) & 1u)         spo2 = packed.spo2;
+    if ((fieldMask >> FIELD_TEMPERATURE) & 1u)  temperature = packed.temperature;
+}
+
+// ==================== VitalPredicate ====================
+
+VitalPredicate::VitalPredicate()
+    : field(FIELD_TIMESTAMP), op(OP_GREATER_EQUAL), value(0) {}
+
+VitalPredicate::VitalPredicate(VitalField f, CompareOp o, double v)
+    : field(f), op(o), value(v) {}
+
+bool VitalPredicate::matches(double fieldValue) const {
+    switch (op) {
+        case OP_LESS:          return fieldValue < value;
+        case OP_LESS_EQUAL:    return fieldValue <= value;
+        case OP_GREATER:       return fieldValue > value;
+        case OP_GREATER_EQUAL: return fieldValue >= value;
+        case OP_EQUAL:         return fieldValue == value;
+        default:               return false;
+    }
+}
+
+bool VitalPredicate::matches(const VitalRecord& record) const {
+    return matches(record.getField(field));
+}
+
+bool VitalPredicate::parse(const std::string& text, VitalPredicate& predicate) {
+    size_t opStart = text.find_first_of("<>=");
+    if (opStart == std::string::npos || opStart == 0) {
+        return false;
+    }
+    
+    size_t opEnd = opStart + 1;
+    if (opEnd < text.size() && text[opEnd] == '=') {
+        opEnd++;
+    }
+    
+    std::string op = text.substr(opStart, opEnd - opStart);
+    if (op == "<")       predicate.op = OP_LESS;
+    else if (op == "<=") predicate.op = OP_LESS_EQUAL;
+    else if (op == ">")  predicate.op = OP_GREATER;
+    else if (op == ">=") predicate.op = OP_GREATER_EQUAL;
+    else if (op == "=" || op == "==") predicate.op = OP_EQUAL;
+    else return false;
+    
+    if (!VitalRecord::parseField(text.substr(0, opStart), predicate.field)) {
+        return false;
+    }
+    
+    std::string number = text.substr(opEnd);
+    char* end = nullptr;
+    predicate.value = strtod(number.c_str(), &end);
+    return !number.empty() && end != nullptr && *end == '\0';
+}
+
+bool VitalPredicate::parseList(const std::string& text, std::vector<VitalPredicate>& predicates) {
+    size_t start = 0;
+    while (start <= text.size()) {
+        size_t comma = text.find(',', start);
+        if (comma == std::string::npos) comma = text.size();
+        
+        VitalPredicate predicate;
+        if (!parse(text.substr(start, comma - start), predicate)) {
+            return false;
+        }
+        predicates.push_back(predicate);
+        start = comma + 1;
+    }
+    return true;
+}
+
+// ==================== VitalQuery ====================
+
+VitalQuery::VitalQuery() : fieldMask(allFields()) {}
+
+bool VitalQuery::matches(const VitalRecord& record) const {
+    for (const auto& predicate : predicates) {
+        if (!predicate.matches(record)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool VitalQuery::matchesEncoded(const char* buffer) const {
+    for (const auto& predicate : predicates) {
+        if (!predicate.matches(VitalRecord::decodeField(buffer, predicate.field))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool VitalQuery::parseFields(const std::string& text, unsigned& mask) {
+    mask = (1u << FIELD_PATIENT_ID) | (1u << FIELD_TIMESTAMP);
+    
+    size_t start = 0;
+    while (start <= text.size()) {
+        size_t comma = text.find(',', start);
+        if (comma == std::string::npos) comma = text.size();
+        
+        VitalField field;
+        if (!VitalRecord::parseField(text.substr(start, comma - start), field)) {
+            return false;
+        }
+        mask |= 1u << field;
+        start = comma + 1;
+    }
+    return true;
+}
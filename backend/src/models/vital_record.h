@@ -4,6 +4,40 @@
 #include <string>
 #include <ctime>
 #include <fstream>
+#include <vector>
+#include <cstdint>
+
+// Vital fields addressable by queries and zone maps
+enum VitalField {
+    FIELD_PATIENT_ID,
+    FIELD_TIMESTAMP,
+    FIELD_HEART_RATE,
+    FIELD_SYSTOLIC_BP,
+    FIELD_DIASTOLIC_BP,
+    FIELD_SPO2,
+    FIELD_TEMPERATURE
+};
+
+const int NUM_VITAL_FIELDS = 7;
+
+// Explicit on-disk record layout: 32 bytes, no padding, host (little-endian)
+// byte order. Field order and widths match the files written before the
+// layout was pinned, so existing data loads unchanged.
+#pragma pack(push, 1)
+struct PackedVitalRecord {
+    int32_t patientID;
+    int64_t timestamp;
+    int32_t heart_rate;
+    int32_t systolic_bp;
+    int32_t diastolic_bp;
+    int32_t spo2;
+    float temperature;
+};
+#pragma pack(pop)
+
+const size_t VITAL_RECORD_DISK_SIZE = 32;
+static_assert(sizeof(PackedVitalRecord) == VITAL_RECORD_DISK_SIZE,
+              "PackedVitalRecord must stay 32 bytes");
 
 // Fixed-size record for disk storage (no dynamic allocation)
 struct VitalRecord {
@@ -23,7 +57,28 @@ struct VitalRecord {
     
     void display() const;
     
-    // Fixed-size disk I/O
+    // Field access by enum (used by predicates and zone maps)
+    double getField(VitalField field) const;
+    static bool parseField(const std::string& name, VitalField& field);
+    static std::string getFieldName(VitalField field);
+    
+    // Decode a single field straight from a raw on-disk record
+    static double decodeField(const char* buffer, VitalField field);
+    static size_t getFieldOffset(VitalField field);
+    // Decode only the fields selected in fieldMask; the rest are left as is
+    void decodeFields(const char* buffer, unsigned fieldMask);
+    // Encode into / decode from the on-disk layout (getDiskSize() bytes)
+    void encode(char* buffer) const;
+    void decode(const char* buffer);
+    void pack(PackedVitalRecord& packed) const;
+    void unpack(const PackedVitalRecord& packed);
+    
+    // Decode `count` consecutive on-disk records and append them to `out`.
+    // Disk positions are set from firstPosition when it is >= 0.
+    static void decodeBatch(const char* buffer, size_t count, std::vector<VitalRecord>& out,
+                            long firstPosition = -1);
+    
+    // Fixed-size disk I/O (one read/write call per record)
     void writeToDisk(std::ofstream& file) const;
     void readFromDisk(std::ifstream& file);
     
@@ -31,4 +86,50 @@ struct VitalRecord {
     static size_t getDiskSize();
 };
 
+// Comparison operators supported in value predicates
+enum CompareOp {
+    OP_LESS,
+    OP_LESS_EQUAL,
+    OP_GREATER,
+    OP_GREATER_EQUAL,
+    OP_EQUAL
+};
+
+// Single "field op value" condition, e.g. spo2<90
+struct VitalPredicate {
+    VitalField field;
+    CompareOp op;
+    double value;
+    
+    VitalPredicate();
+    VitalPredicate(VitalField f, CompareOp o, double v);
+    
+    bool matches(double fieldValue) const;
+    bool matches(const VitalRecord& record) const;
+    
+    // Parse "spo2<90"; returns false on malformed input
+    static bool parse(const std::string& text, VitalPredicate& predicate);
+    // Parse a comma-separated conjunction: "spo2<90,heart_rate>120"
+    static bool parseList(const std::string& text, std::vector<VitalPredicate>& predicates);
+};
+
+// Filter and projection pushed down into a storage scan: rows failing a
+// predicate are dropped before decoding, and only fields in fieldMask are
+// decoded (patientID and timestamp always are).
+struct VitalQuery {
+    std::vector<VitalPredicate> predicates;
+    unsigned fieldMask;
+    
+    VitalQuery();
+    
+    bool wantsField(VitalField field) const { return (fieldMask >> field) & 1u; }
+    bool matches(const VitalRecord& record) const;
+    // Evaluate the predicates directly on an encoded record
+    bool matchesEncoded(const char* buffer) const;
+    
+    static unsigned allFields() { return (1u << NUM_VITAL_FIELDS) - 1; }
+    // Parse "heart_rate,spo2" into a field mask
+    static bool parseFields(const std::string& text, unsigned& mask);
+};
+
 #endif
\ No newline at end of file
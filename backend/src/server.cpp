@@ -1,23 +1,79 @@
 #include <iostream>
 #include <string>
+#include <set>
+#include <map>
+#include <cstdlib>
+#include <atomic>
+#include <algorithm>
 #include "../../include/httplib.h"
 #include "../../include/nlohmann/json.hpp"
-#include "data_structures/btree.h"
+#include "data_structures/storage_engine.h"
 #include "data_structures/priority_queue.h"
+#include "data_structures/alert_intake.h"
 #include "data_structures/hash_table.h"
 #include "data_structures/drug_graph.h"
 #include "models/vital_record.h"
 #include "models/patient.h"
 #include "models/alert.h"
+#include "utils/threshold_scanner.h"
+#include "utils/risk_calculator.h"
+#include "utils/sliding_window_stats.h"
+#include "utils/ward_aggregator.h"
+#include "utils/rw_lock.h"
+#include "utils/downsampler.h"
+#include "utils/alert_escalator.h"
 
 using namespace httplib;
 using json = nlohmann::json;
 
 // Global data structures
-DiskBTree* vitalSignsDB;
+VitalStorageEngine* vitalSignsDB;
 HashTable<int, Patient>* patientDB;
 PriorityQueue* alertQueue;
+AlertIntake* alertIntake;    // All producers submit here, never to alertQueue directly
+AlertEscalator* alertEscalator;
 DrugGraph* drugInteractionGraph;
+ThresholdScanner* thresholdScanner;
+RiskCalculator* riskCalculator;
+SlidingWindowStats* windowStats;
+WardAggregator* wardAggregator;
+
+// Vitals readers share the storage engine; ingest holds it exclusively
+RWLock vitalsLock;
+
+// Guards patientDB: request threads and the alert queue's ward resolver
+// (intake drain and escalator threads) read it while POST /api/patient
+// may grow and rehash the table. Never held while calling into the queue.
+RWLock patientsLock;
+
+// Alert IDs are shared by manual and automatically raised alerts
+std::atomic<int> nextAlertID(1);
+
+int allocateAlertID() {
+    return nextAlertID++;
+}
+
+// Queue a new alert without waiting for the intake to drain; the escalator
+// picks it up from the queue. If it is merged into an existing alert its
+// own ID still addresses that alert, so it is returned as submitted.
+Alert submitAlert(const Alert& alert) {
+    alertIntake->submit(alert);
+    return alert;
+}
+
+// Ward used to resolve thresholds for a patient ("" if unknown)
+std::string patientWard(int patientID) {
+    ReadGuard guard(patientsLock);
+    Patient* patient = patientDB->search(patientID);
+    return patient ? patient->ward : "";
+}
+
+// Queue a VITAL_ABNORMAL alert for a flagged reading
+Alert raiseVitalAlert(const VitalRecord& record, uint8_t flags) {
+    Alert alert(allocateAlertID(), record.patientID, ThresholdScanner::priorityFor(flags),
+                VITAL_ABNORMAL, ThresholdScanner::describe(record, flags));
+    return submitAlert(alert);
+}
 
 // Convert VitalRecord to JSON
 json vitalToJson(const VitalRecord& v) {
@@ -32,6 +88,24 @@ json vitalToJson(const VitalRecord& v) {
     };
 }
 
+// Convert only the projected fields of a VitalRecord to JSON
+json vitalToJson(const VitalRecord& v, unsigned fieldMask) {
+    json result = json::object();
+    for (int f = 0; f < NUM_VITAL_FIELDS; f++) {
+        VitalField field = static_cast<VitalField>(f);
+        if (!((fieldMask >> f) & 1u)) continue;
+        
+        if (field == FIELD_TEMPERATURE) {
+            result[VitalRecord::getFieldName(field)] = v.temperature;
+        } else if (field == FIELD_TIMESTAMP) {
+            result[VitalRecord::getFieldName(field)] = v.timestamp;
+        } else {
+            result[VitalRecord::getFieldName(field)] = static_cast<int>(v.getField(field));
+        }
+    }
+    return result;
+}
+
 // Convert Alert to JSON
 json alertToJson(const Alert& a) {
     return {
@@ -39,11 +113,56 @@ json alertToJson(const Alert& a) {
         {"patientID", a.patientID},
         {"priority", a.priority},
         {"priorityString", a.getPriorityString()},
+        {"type", a.type},
         {"message", a.message},
-        {"timestamp", a.timestamp}
+        {"timestamp", a.timestamp},
+        {"acknowledged", a.acknowledged},
+        {"acknowledgedBy", a.acknowledgedBy},
+        {"acknowledgedTime", a.acknowledgedTime},
+        {"occurrenceCount", a.occurrenceCount},
+        {"lastSeenTime", a.getLastSeenTime()}
+    };
+}
+
+// Convert EarlyWarningScore to JSON
+json scoreToJson(const EarlyWarningScore& s) {
+    return {
+        {"timestamp", s.timestamp},
+        {"score", s.total},
+        {"risk", RiskCalculator::getRiskString(s.level)},
+        {"components", {
+            {"heart_rate", s.heartRatePoints},
+            {"systolic_bp", s.systolicPoints},
+            {"spo2", s.spo2Points},
+            {"temperature", s.temperaturePoints}
+        }}
     };
 }
 
+// Convert VitalThresholds to JSON
+json thresholdsToJson(const VitalThresholds& t) {
+    return {
+        {"heartRateLow", t.heartRateLow},
+        {"heartRateHigh", t.heartRateHigh},
+        {"systolicLow", t.systolicLow},
+        {"systolicHigh", t.systolicHigh},
+        {"spo2Low", t.spo2Low},
+        {"temperatureLow", t.temperatureLow},
+        {"temperatureHigh", t.temperatureHigh}
+    };
+}
+
+// Overwrite only the thresholds present in the JSON body
+void thresholdsFromJson(const json& data, VitalThresholds& t) {
+    if (data.contains("heartRateLow")) t.heartRateLow = data["heartRateLow"];
+    if (data.contains("heartRateHigh")) t.heartRateHigh = data["heartRateHigh"];
+    if (data.contains("systolicLow")) t.systolicLow = data["systolicLow"];
+    if (data.contains("systolicHigh")) t.systolicHigh = data["systolicHigh"];
+    if (data.contains("spo2Low")) t.spo2Low = data["spo2Low"];
+    if (data.contains("temperatureLow")) t.temperatureLow = data["temperatureLow"];
+    if (data.contains("temperatureHigh")) t.temperatureHigh = data["temperatureHigh"];
+}
+
 // Convert Patient to JSON
 json patientToJson(const Patient& p) {
     json medications = json::array();
@@ -69,12 +188,37 @@ void enableCORS(Response& res) {
     res.set_header("Access-Control-Allow-Headers", "Content-Type");
 }
 
-int main() {
-    vitalSignsDB = new DiskBTree(50, "vitals");
+int main(int argc, char* argv[]) {
+    // Storage engine for vitals: --engine=btree|lsm, or ICU_STORAGE_ENGINE.
+    // Repeated alerts merge within --coalesce-window=SECONDS (0 disables).
+    std::string engine = "btree";
+    long coalesceWindow = PQ_DEFAULT_COALESCE_WINDOW;
+    if (const char* envEngine = getenv("ICU_STORAGE_ENGINE")) engine = envEngine;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.compare(0, 9, "--engine=") == 0) engine = arg.substr(9);
+        if (arg.compare(0, 18, "--coalesce-window=") == 0) coalesceWindow = std::atol(arg.c_str() + 18);
+    }
+    
+    vitalSignsDB = createStorageEngine(engine, "vitals");
+    if (!vitalSignsDB) {
+        std::cerr << "Unknown storage engine: " << engine << " (expected btree or lsm)" << std::endl;
+        return 1;
+    }
     patientDB = new HashTable<int, Patient>(101, "patients.bin");
     alertQueue = new PriorityQueue("alerts.bin");
+    alertQueue->setCoalesceWindow(coalesceWindow);
+    alertQueue->setWardResolver(patientWard);
+    alertIntake = new AlertIntake(*alertQueue);
+    alertEscalator = new AlertEscalator(*alertQueue);
+    alertEscalator->trackQueued();
     drugInteractionGraph = new DrugGraph("drug_interactions.bin");
     drugInteractionGraph->loadCommonInteractions();
+    thresholdScanner = new ThresholdScanner("thresholds.bin");
+    riskCalculator = new RiskCalculator("news2_scores.bin");
+    windowStats = new SlidingWindowStats();
+    wardAggregator = new WardAggregator(*vitalSignsDB, *thresholdScanner);
+    nextAlertID = alertQueue->getMaxAlertID() + 1;
     
     Server svr;
     
@@ -88,7 +232,9 @@ int main() {
         json response = {
             {"status", "online"},
             {"message", "IntelliCare ICU API"},
-            {"version", "1.0.0"}
+            {"version", "1.0.0"},
+            {"ready", vitalSignsDB->isReady()},
+            {"storageEngine", vitalSignsDB->getEngineName()}
         };
         res.set_content(response.dump(), "application/json");
     });
@@ -107,9 +253,35 @@ int main() {
             record.spo2 = jsonData["spo2"];
             record.temperature = jsonData["temperature"];
             
-            vitalSignsDB->insert(record.timestamp, record);
+            {
+                WriteGuard guard(vitalsLock);
+                vitalSignsDB->insert(record.timestamp, record);
+            }
             
             json response = {{"status", "success"}, {"message", "Vitals recorded"}};
+            
+            // Check the new reading against the patient's thresholds
+            VitalThresholds thresholds = thresholdScanner->resolve(record.patientID,
+                                                                   patientWard(record.patientID));
+            uint8_t flags = ThresholdScanner::checkReading(record, thresholds);
+            if (flags) {
+                Alert alert = raiseVitalAlert(record, flags);
+                response["abnormal"] = alertToJson(alert);
+            }
+            
+            windowStats->add(record);
+            
+            // Early warning score; alert only when the risk band rises
+            ScoreUpdate update = riskCalculator->update(record);
+            response["news2"] = scoreToJson(update.score);
+            if (update.escalated) {
+                Alert alert(allocateAlertID(), record.patientID,
+                            RiskCalculator::alertPriority(update.score.level), DETERIORATION,
+                            "NEWS2 " + std::to_string(update.score.total) + ": risk rose from " +
+                            RiskCalculator::getRiskString(update.previousLevel) + " to " +
+                            RiskCalculator::getRiskString(update.score.level));
+                response["deterioration"] = alertToJson(submitAlert(alert));
+            }
             res.set_content(response.dump(), "application/json");
         } catch (const std::exception& e) {
             json error = {{"status", "error"}, {"message", e.what()}};
@@ -129,13 +301,83 @@ int main() {
             if (req.has_param("start")) startTime = std::stol(req.get_param_value("start"));
             if (req.has_param("end")) endTime = std::stol(req.get_param_value("end"));
             
-            auto readings = vitalSignsDB->rangeQuery(startTime, endTime);
+            // ?where= conditions and ?fields= projection are evaluated
+            // inside the storage scan
+            VitalQuery query;
+            
+            if (req.has_param("where") &&
+                !VitalPredicate::parseList(req.get_param_value("where"), query.predicates)) {
+                json error = {{"status", "error"}, {"message", "Invalid 'where' condition"}};
+                res.status = 400;
+                res.set_content(error.dump(), "application/json");
+                return;
+            }
+            if (req.has_param("fields") &&
+                !VitalQuery::parseFields(req.get_param_value("fields"), query.fieldMask)) {
+                json error = {{"status", "error"}, {"message", "Invalid 'fields' list"}};
+                res.status = 400;
+                res.set_content(error.dump(), "application/json");
+                return;
+            }
+            
+            // ?points=N: chart series of at most N LTTB-selected points per
+            // vital, so the payload does not grow with the window length
+            if (req.has_param("points") && !req.has_param("last")) {
+                int points = std::stoi(req.get_param_value("points"));
+                if (points < 3) points = 3;
+                
+                VitalBatch batch;
+                {
+                    ReadGuard guard(vitalsLock);
+                    if (query.predicates.empty()) {
+                        vitalSignsDB->patientRangeQueryBatch(patientID, startTime, endTime, batch);
+                    } else {
+                        batch = VitalBatch::fromRecords(
+                            vitalSignsDB->patientRangeQuery(patientID, startTime, endTime, query));
+                    }
+                }
+                
+                json series = json::object();
+                for (int f = FIELD_HEART_RATE; f < NUM_VITAL_FIELDS; f++) {
+                    VitalField field = static_cast<VitalField>(f);
+                    if (!query.wantsField(field)) continue;
+                    
+                    json values = json::array();
+                    for (size_t i : Downsampler::lttb(batch, field, points)) {
+                        VitalRecord reading = batch.getRecord(i);
+                        if (field == FIELD_TEMPERATURE) {
+                            values.push_back({reading.timestamp, reading.temperature});
+                        } else {
+                            values.push_back({reading.timestamp, static_cast<int>(reading.getField(field))});
+                        }
+                    }
+                    series[VitalRecord::getFieldName(field)] = values;
+                }
+                
+                json response = {
+                    {"status", "success"},
+                    {"count", batch.size()},
+                    {"points", points},
+                    {"series", series}
+                };
+                res.set_content(response.dump(), "application/json");
+                return;
+            }
+            
+            // Only this patient's readings are visited; ?last=N walks them
+            // backwards from endTime instead of reading the whole window
+            std::vector<VitalRecord> readings;
+            ReadGuard guard(vitalsLock);
+            if (req.has_param("last")) {
+                int last = std::stoi(req.get_param_value("last"));
+                readings = vitalSignsDB->patientLatestRecords(patientID, startTime, endTime, last, query);
+            } else {
+                readings = vitalSignsDB->patientRangeQuery(patientID, startTime, endTime, query);
+            }
             json results = json::array();
             
             for (const auto& reading : readings) {
-                if (reading.patientID == patientID) {
-                    results.push_back(vitalToJson(reading));
-                }
+                results.push_back(vitalToJson(reading, query.fieldMask));
             }
             
             json response = {{"status", "success"}, {"count", results.size()}, {"readings", results}};
@@ -147,6 +389,264 @@ int main() {
         }
     });
     
+    // GET /api/vitals/:id/summary?start=..&end=..
+    // Min/max/mean of each vital over the window, computed column-wise
+    svr.Get(R"(/api/vitals/(\d+)/summary)", [](const Request& req, Response& res) {
+        enableCORS(res);
+        try {
+            int patientID = std::stoi(req.matches[1]);
+            long startTime = 0;
+            long endTime = time(nullptr);
+            
+            if (req.has_param("start")) startTime = std::stol(req.get_param_value("start"));
+            if (req.has_param("end")) endTime = std::stol(req.get_param_value("end"));
+            
+            VitalBatch batch;
+            {
+                ReadGuard guard(vitalsLock);
+                vitalSignsDB->patientRangeQueryBatch(patientID, startTime, endTime, batch);
+            }
+            
+            json vitals = json::object();
+            for (int f = FIELD_HEART_RATE; f < NUM_VITAL_FIELDS; f++) {
+                VitalField field = static_cast<VitalField>(f);
+                VitalColumnStats stats = batch.summarize(field);
+                vitals[VitalRecord::getFieldName(field)] = {
+                    {"min", stats.min},
+                    {"max", stats.max},
+                    {"mean", stats.mean}
+                };
+            }
+            
+            json response = {
+                {"status", "success"},
+                {"patientID", patientID},
+                {"count", batch.size()},
+                {"vitals", vitals}
+            };
+            if (!batch.empty()) {
+                response["firstTimestamp"] = batch.timestamp.front();
+                response["lastTimestamp"] = batch.timestamp.back();
+            }
+            res.set_content(response.dump(), "application/json");
+        } catch (const std::exception& e) {
+            json error = {{"status", "error"}, {"message", e.what()}};
+            res.status = 400;
+            res.set_content(error.dump(), "application/json");
+        }
+    });
+    
+    // POST /api/vitals/:id/scan?start=..&end=..
+    // Re-check historical readings against the current thresholds and raise
+    // one alert summarising the abnormal readings found
+    svr.Post(R"(/api/vitals/(\d+)/scan)", [](const Request& req, Response& res) {
+        enableCORS(res);
+        try {
+            int patientID = std::stoi(req.matches[1]);
+            long startTime = 0;
+            long endTime = time(nullptr);
+            
+            if (req.has_param("start")) startTime = std::stol(req.get_param_value("start"));
+            if (req.has_param("end")) endTime = std::stol(req.get_param_value("end"));
+            
+            VitalBatch batch;
+            {
+                ReadGuard guard(vitalsLock);
+                vitalSignsDB->patientRangeQueryBatch(patientID, startTime, endTime, batch);
+            }
+            
+            VitalThresholds thresholds = thresholdScanner->resolve(patientID, patientWard(patientID));
+            auto abnormal = ThresholdScanner::findAbnormal(batch, thresholds);
+            
+            json readings = json::array();
+            uint8_t combinedFlags = 0;
+            for (const auto& reading : abnormal) {
+                json entry = vitalToJson(batch.getRecord(reading.index));
+                entry["flags"] = reading.flags;
+                readings.push_back(entry);
+                combinedFlags |= reading.flags;
+            }
+            
+            json response = {
+                {"status", "success"},
+                {"patientID", patientID},
+                {"scanned", batch.size()},
+                {"abnormalCount", abnormal.size()},
+                {"readings", readings}
+            };
+            
+            if (!abnormal.empty()) {
+                // Priority reflects everything found; the message quotes the latest reading
+                VitalRecord last = batch.getRecord(abnormal.back().index);
+                Alert alert(allocateAlertID(), patientID, ThresholdScanner::priorityFor(combinedFlags),
+                            VITAL_ABNORMAL,
+                            std::to_string(abnormal.size()) + " abnormal readings; latest: " +
+                            ThresholdScanner::describe(last, abnormal.back().flags));
+                response["alert"] = alertToJson(submitAlert(alert));
+            }
+            res.set_content(response.dump(), "application/json");
+        } catch (const std::exception& e) {
+            json error = {{"status", "error"}, {"message", e.what()}};
+            res.status = 400;
+            res.set_content(error.dump(), "application/json");
+        }
+    });
+    
+    // GET/PUT /api/thresholds/patient/:id and /api/thresholds/ward/:ward
+    // PUT bodies may set any subset of the threshold fields
+    svr.Get(R"(/api/thresholds/patient/(\d+))", [](const Request& req, Response& res) {
+        enableCORS(res);
+        int patientID = std::stoi(req.matches[1]);
+        VitalThresholds thresholds = thresholdScanner->resolve(patientID, patientWard(patientID));
+        json response = {{"status", "success"}, {"patientID", patientID},
+                         {"thresholds", thresholdsToJson(thresholds)}};
+        res.set_content(response.dump(), "application/json");
+    });
+    
+    svr.Put(R"(/api/thresholds/patient/(\d+))", [](const Request& req, Response& res) {
+        enableCORS(res);
+        try {
+            int patientID = std::stoi(req.matches[1]);
+            VitalThresholds thresholds = thresholdScanner->resolve(patientID, patientWard(patientID));
+            thresholdsFromJson(json::parse(req.body), thresholds);
+            thresholdScanner->setPatientThresholds(patientID, thresholds);
+            thresholdScanner->saveToDisk();
+            
+            json response = {{"status", "success"}, {"thresholds", thresholdsToJson(thresholds)}};
+            res.set_content(response.dump(), "application/json");
+        } catch (const std::exception& e) {
+            json error = {{"status", "error"}, {"message", e.what()}};
+            res.status = 400;
+            res.set_content(error.dump(), "application/json");
+        }
+    });
+    
+    svr.Get(R"(/api/thresholds/ward/([^/]+))", [](const Request& req, Response& res) {
+        enableCORS(res);
+        std::string ward = req.matches[1];
+        json response = {{"status", "success"}, {"ward", ward},
+                         {"thresholds", thresholdsToJson(thresholdScanner->resolve(-1, ward))}};
+        res.set_content(response.dump(), "application/json");
+    });
+    
+    svr.Put(R"(/api/thresholds/ward/([^/]+))", [](const Request& req, Response& res) {
+        enableCORS(res);
+        try {
+            std::string ward = req.matches[1];
+            VitalThresholds thresholds = thresholdScanner->resolve(-1, ward);
+            thresholdsFromJson(json::parse(req.body), thresholds);
+            thresholdScanner->setWardThresholds(ward, thresholds);
+            thresholdScanner->saveToDisk();
+            
+            json response = {{"status", "success"}, {"thresholds", thresholdsToJson(thresholds)}};
+            res.set_content(response.dump(), "application/json");
+        } catch (const std::exception& e) {
+            json error = {{"status", "error"}, {"message", e.what()}};
+            res.status = 400;
+            res.set_content(error.dump(), "application/json");
+        }
+    });
+    
+    // GET /api/vitals/:id/trends?now=..
+    // Rolling mean/variance/min/max/slope over the last 5, 15 and 60 minutes,
+    // maintained incrementally on ingest. Windows end at the latest reading
+    // unless `now` is given.
+    svr.Get(R"(/api/vitals/(\d+)/trends)", [](const Request& req, Response& res) {
+        enableCORS(res);
+        try {
+            int patientID = std::stoi(req.matches[1]);
+            long now = -1;
+            if (req.has_param("now")) now = std::stol(req.get_param_value("now"));
+            
+            std::vector<WindowStats> stats;
+            if (!windowStats->getStats(patientID, stats, now)) {
+                // Nothing ingested since startup: seed from the last hour on disk
+                long endTime = now >= 0 ? now : time(nullptr);
+                long startTime = endTime - SLIDING_WINDOW_SECONDS[SLIDING_WINDOW_COUNT - 1];
+                std::vector<VitalRecord> history;
+                {
+                    ReadGuard guard(vitalsLock);
+                    history = vitalSignsDB->patientRangeQuery(patientID, startTime, endTime, VitalQuery());
+                }
+                windowStats->seedIfEmpty(patientID, history);
+                windowStats->getStats(patientID, stats, now);
+            }
+            
+            json windows = json::array();
+            for (const auto& window : stats) {
+                json fields = json::object();
+                for (int f = 0; f < WINDOW_FIELD_COUNT; f++) {
+                    const WindowFieldStats& field = window.fields[f];
+                    fields[VitalRecord::getFieldName(WINDOW_FIELDS[f])] = {
+                        {"mean", field.mean},
+                        {"variance", field.variance},
+                        {"min", field.min},
+                        {"max", field.max},
+                        {"slopePerMinute", field.slopePerMinute}
+                    };
+                }
+                windows.push_back({{"seconds", window.windowSeconds}, {"count", window.count}, {"vitals", fields}});
+            }
+            
+            json response = {{"status", "success"}, {"patientID", patientID}, {"windows", windows}};
+            res.set_content(response.dump(), "application/json");
+        } catch (const std::exception& e) {
+            json error = {{"status", "error"}, {"message", e.what()}};
+            res.status = 400;
+            res.set_content(error.dump(), "application/json");
+        }
+    });
+    
+    // GET /api/vitals/query?where=spo2<90&start=..&end=..
+    // Ward-wide predicate search; only data blocks whose zone maps can
+    // match the conditions are read.
+    svr.Get("/api/vitals/query", [](const Request& req, Response& res) {
+        enableCORS(res);
+        try {
+            std::vector<VitalPredicate> predicates;
+            if (!req.has_param("where") ||
+                !VitalPredicate::parseList(req.get_param_value("where"), predicates)) {
+                json error = {{"status", "error"}, {"message", "Invalid or missing 'where' condition"}};
+                res.status = 400;
+                res.set_content(error.dump(), "application/json");
+                return;
+            }
+            
+            long startTime = 0;
+            long endTime = time(nullptr);
+            if (req.has_param("start")) startTime = std::stol(req.get_param_value("start"));
+            if (req.has_param("end")) endTime = std::stol(req.get_param_value("end"));
+            
+            ZoneScanStats stats;
+            std::vector<VitalRecord> readings;
+            {
+                ReadGuard guard(vitalsLock);
+                readings = vitalSignsDB->scanWhere(startTime, endTime, predicates, &stats);
+            }
+            
+            json results = json::array();
+            std::set<int> patientIDs;
+            for (const auto& reading : readings) {
+                results.push_back(vitalToJson(reading));
+                patientIDs.insert(reading.patientID);
+            }
+            
+            json response = {
+                {"status", "success"},
+                {"count", results.size()},
+                {"patients", patientIDs},
+                {"blocksScanned", stats.blocksScanned},
+                {"blocksTotal", stats.blocksTotal},
+                {"readings", results}
+            };
+            res.set_content(response.dump(), "application/json");
+        } catch (const std::exception& e) {
+            json error = {{"status", "error"}, {"message", e.what()}};
+            res.status = 400;
+            res.set_content(error.dump(), "application/json");
+        }
+    });
+    
     // POST /api/patient
     svr.Post("/api/patient", [](const Request& req, Response& res) {
         enableCORS(res);
@@ -162,7 +662,11 @@ int main() {
             patient.admissionDate = jsonData["admissionDate"];
             if (jsonData.contains("bloodType")) patient.bloodType = jsonData["bloodType"];
             
-            patientDB->insert(patient.patientID, patient);
+            {
+                WriteGuard guard(patientsLock);
+                patientDB->insert(patient.patientID, patient);
+            }
+            alertQueue->reindexPatient(patient.patientID);    // Ward may have changed
             
             json response = {{"status", "success"}, {"message", "Patient added"}};
             res.set_content(response.dump(), "application/json");
@@ -178,10 +682,19 @@ int main() {
         enableCORS(res);
         try {
             int patientID = std::stoi(req.matches[1]);
-            Patient* patient = patientDB->search(patientID);
+            Patient patient;
+            bool found = false;
+            {
+                ReadGuard guard(patientsLock);
+                Patient* stored = patientDB->search(patientID);
+                if (stored) {
+                    patient = *stored;
+                    found = true;
+                }
+            }
             
-            if (patient) {
-                json response = {{"status", "success"}, {"data", patientToJson(*patient)}};
+            if (found) {
+                json response = {{"status", "success"}, {"data", patientToJson(patient)}};
                 res.set_content(response.dump(), "application/json");
             } else {
                 json error = {{"status", "error"}, {"message", "Patient not found"}};
@@ -195,10 +708,47 @@ int main() {
         }
     });
     
+    // GET /api/patient/:id/score?history=N
+    // Latest early warning score plus up to N recent scores (default 20)
+    svr.Get(R"(/api/patient/(\d+)/score)", [](const Request& req, Response& res) {
+        enableCORS(res);
+        try {
+            int patientID = std::stoi(req.matches[1]);
+            int historyCount = 20;
+            if (req.has_param("history")) historyCount = std::stoi(req.get_param_value("history"));
+            
+            EarlyWarningScore latest;
+            if (!riskCalculator->getLatest(patientID, latest)) {
+                json error = {{"status", "error"}, {"message", "No scored vitals for patient"}};
+                res.status = 404;
+                res.set_content(error.dump(), "application/json");
+                return;
+            }
+            
+            json history = json::array();
+            for (const auto& entry : riskCalculator->getHistory(patientID, historyCount)) {
+                history.push_back(scoreToJson(entry));
+            }
+            
+            json response = {
+                {"status", "success"},
+                {"patientID", patientID},
+                {"current", scoreToJson(latest)},
+                {"history", history}
+            };
+            res.set_content(response.dump(), "application/json");
+        } catch (const std::exception& e) {
+            json error = {{"status", "error"}, {"message", e.what()}};
+            res.status = 400;
+            res.set_content(error.dump(), "application/json");
+        }
+    });
+    
     // GET /api/patients
     svr.Get("/api/patients", [](const Request& req, Response& res) {
         enableCORS(res);
         try {
+            ReadGuard guard(patientsLock);
             auto patientIDs = patientDB->getAllKeys();
             json patients = json::array();
             
@@ -216,24 +766,100 @@ int main() {
         }
     });
     
+    // GET /api/ward/:ward/summary?start=..&end=..
+    // One-round-trip overview of every bed in a ward: latest reading,
+    // min/max/mean and abnormal counts over the window (default: last hour).
+    // Beds are summarized in parallel on the aggregation thread pool.
+    svr.Get(R"(/api/ward/([^/]+)/summary)", [](const Request& req, Response& res) {
+        enableCORS(res);
+        try {
+            std::string ward = req.matches[1];
+            long endTime = time(nullptr);
+            if (req.has_param("end")) endTime = std::stol(req.get_param_value("end"));
+            long startTime = endTime - 3600;
+            if (req.has_param("start")) startTime = std::stol(req.get_param_value("start"));
+            
+            std::vector<int> patientIDs;
+            std::map<int, std::string> names;
+            {
+                ReadGuard guard(patientsLock);
+                for (int patientID : patientDB->getAllKeys()) {
+                    Patient* patient = patientDB->search(patientID);
+                    if (patient && patient->ward == ward) {
+                        patientIDs.push_back(patientID);
+                        names[patientID] = patient->name;
+                    }
+                }
+            }
+            std::sort(patientIDs.begin(), patientIDs.end());
+            
+            std::vector<BedSummary> beds;
+            {
+                ReadGuard guard(vitalsLock);
+                beds = wardAggregator->summarizeWard(ward, patientIDs, startTime, endTime);
+            }
+            
+            json bedList = json::array();
+            int bedsAbnormal = 0;
+            for (const auto& bed : beds) {
+                json vitals = json::object();
+                for (int f = 0; f < BED_SUMMARY_FIELDS; f++) {
+                    VitalField field = static_cast<VitalField>(FIELD_HEART_RATE + f);
+                    const VitalColumnStats& stats = bed.getStats(field);
+                    vitals[VitalRecord::getFieldName(field)] = {
+                        {"min", stats.min},
+                        {"max", stats.max},
+                        {"mean", stats.mean}
+                    };
+                }
+                
+                json entry = {
+                    {"patientID", bed.patientID},
+                    {"name", names[bed.patientID]},
+                    {"count", bed.readingCount},
+                    {"abnormalCount", bed.abnormalCount},
+                    {"vitals", vitals}
+                };
+                if (bed.hasLatest) {
+                    entry["latest"] = vitalToJson(bed.latest);
+                    entry["latestAbnormal"] = ThresholdScanner::describe(bed.latest, bed.latestFlags);
+                }
+                if (bed.abnormalCount > 0) bedsAbnormal++;
+                bedList.push_back(entry);
+            }
+            
+            json response = {
+                {"status", "success"},
+                {"ward", ward},
+                {"bedCount", beds.size()},
+                {"bedsWithAbnormal", bedsAbnormal},
+                {"beds", bedList}
+            };
+            res.set_content(response.dump(), "application/json");
+        } catch (const std::exception& e) {
+            json error = {{"status", "error"}, {"message", e.what()}};
+            res.status = 400;
+            res.set_content(error.dump(), "application/json");
+        }
+    });
+    
     // POST /api/alert
     svr.Post("/api/alert", [](const Request& req, Response& res) {
         enableCORS(res);
         try {
             auto jsonData = json::parse(req.body);
-            static int alertIDCounter = 1;
             
             Alert alert;
-            alert.alertID = alertIDCounter++;
+            alert.alertID = allocateAlertID();
             alert.patientID = jsonData["patientID"];
             alert.priority = static_cast<AlertPriority>(jsonData["priority"].get<int>());
             alert.type = static_cast<AlertType>(jsonData["type"].get<int>());
             alert.message = jsonData["message"];
             alert.timestamp = time(nullptr);
             
-            alertQueue->insert(alert);
+            Alert stored = submitAlert(alert);
             
-            json response = {{"status", "success"}, {"message", "Alert created"}};
+            json response = {{"status", "success"}, {"message", "Alert created"}, {"alert", alertToJson(stored)}};
             res.set_content(response.dump(), "application/json");
         } catch (const std::exception& e) {
             json error = {{"status", "error"}, {"message", e.what()}};
@@ -242,24 +868,87 @@ int main() {
         }
     });
     
-    // GET /api/alerts
+    // GET /api/alerts[?limit=k&offset=n&minPriority=1-5&unacknowledged=true&cursor=c
+    //                 &patientID=id&ward=name&type=0-6]
     svr.Get("/api/alerts", [](const Request& req, Response& res) {
         enableCORS(res);
         try {
-            json alerts = json::array();
-            PriorityQueue tempQueue;
+            bool paged = req.has_param("limit") || req.has_param("offset") || req.has_param("cursor") ||
+                         req.has_param("minPriority") || req.has_param("unacknowledged") ||
+                         req.has_param("patientID") || req.has_param("ward") || req.has_param("type");
+            if (!paged) {
+                // Ordered read-only snapshot; the live queue is not touched
+                json alerts = json::array();
+                for (const auto& alert : *alertIntake->settled().getSortedSnapshot()) {
+                    alerts.push_back(alertToJson(alert));
+                }
+                
+                json response = {{"status", "success"}, {"count", alerts.size()}, {"alerts", alerts}};
+                res.set_content(response.dump(), "application/json");
+                return;
+            }
             
-            while (!alertQueue->isEmpty()) {
-                Alert alert = alertQueue->extractMin();
-                alerts.push_back(alertToJson(alert));
-                tempQueue.insert(alert);
+            // One page read straight from the queue's levels; pass the
+            // returned nextCursor back as ?cursor= for the following page
+            AlertQuery query;
+            if (req.has_param("limit")) query.limit = std::stoi(req.get_param_value("limit"));
+            if (req.has_param("offset")) query.offset = std::stoi(req.get_param_value("offset"));
+            if (req.has_param("minPriority")) {
+                int minPriority = std::stoi(req.get_param_value("minPriority"));
+                if (minPriority < CRITICAL || minPriority > INFO) {
+                    json error = {{"status", "error"}, {"message", "minPriority must be 1-5"}};
+                    res.status = 400;
+                    res.set_content(error.dump(), "application/json");
+                    return;
+                }
+                query.minPriority = static_cast<AlertPriority>(minPriority);
+            }
+            if (req.has_param("unacknowledged")) {
+                std::string flag = req.get_param_value("unacknowledged");
+                query.unacknowledgedOnly = flag == "true" || flag == "1";
+            }
+            // Per-bed and per-ward panels are answered from the queue's
+            // secondary indexes
+            if (req.has_param("patientID")) query.patientID = std::stoi(req.get_param_value("patientID"));
+            if (req.has_param("ward")) query.ward = req.get_param_value("ward");
+            if (req.has_param("type")) {
+                query.type = std::stoi(req.get_param_value("type"));
+                if (query.type < VITAL_ABNORMAL || query.type > CUSTOM) {
+                    json error = {{"status", "error"}, {"message", "type must be 0-6"}};
+                    res.status = 400;
+                    res.set_content(error.dump(), "application/json");
+                    return;
+                }
+            }
+            if (query.limit < 0 || query.offset < 0) {
+                json error = {{"status", "error"}, {"message", "limit and offset must not be negative"}};
+                res.status = 400;
+                res.set_content(error.dump(), "application/json");
+                return;
+            }
+            if (req.has_param("cursor") && !req.get_param_value("cursor").empty() &&
+                !AlertCursor::parse(req.get_param_value("cursor"), query.after)) {
+                json error = {{"status", "error"}, {"message", "Invalid cursor"}};
+                res.status = 400;
+                res.set_content(error.dump(), "application/json");
+                return;
             }
             
-            while (!tempQueue.isEmpty()) {
-                alertQueue->insert(tempQueue.extractMin());
+            PriorityQueue& queue = alertIntake->settled();
+            AlertPage page = queue.query(query);
+            json alerts = json::array();
+            for (const auto& alert : page.alerts) {
+                alerts.push_back(alertToJson(alert));
             }
             
-            json response = {{"status", "success"}, {"count", alerts.size()}, {"alerts", alerts}};
+            json response = {
+                {"status", "success"},
+                {"count", alerts.size()},
+                {"total", queue.size()},
+                {"hasMore", page.hasMore},
+                {"nextCursor", page.hasMore ? json(page.next.toString()) : json(nullptr)},
+                {"alerts", alerts}
+            };
             res.set_content(response.dump(), "application/json");
         } catch (const std::exception& e) {
             json error = {{"status", "error"}, {"message", e.what()}};
@@ -267,6 +956,104 @@ int main() {
             res.set_content(error.dump(), "application/json");
         }
     });
+    
+    // GET /api/alerts/top - most urgent alert, including ones just submitted
+    svr.Get("/api/alerts/top", [](const Request& req, Response& res) {
+        enableCORS(res);
+        try {
+            Alert alert;
+            json response = {{"status", "success"}};
+            if (alertIntake->peekMin(alert)) {
+                response["alert"] = alertToJson(alert);
+            } else {
+                response["alert"] = nullptr;
+            }
+            res.set_content(response.dump(), "application/json");
+        } catch (const std::exception& e) {
+            json error = {{"status", "error"}, {"message", e.what()}};
+            res.status = 500;
+            res.set_content(error.dump(), "application/json");
+        }
+    });
+    
+    // PUT /api/alert/:id/ack  body: {"acknowledgedBy": "..."} (optional)
+    svr.Put(R"(/api/alert/(\d+)/ack)", [](const Request& req, Response& res) {
+        enableCORS(res);
+        try {
+            int alertID = std::stoi(req.matches[1]);
+            std::string acknowledgedBy = "unknown";
+            if (!req.body.empty()) {
+                auto jsonData = json::parse(req.body);
+                if (jsonData.contains("acknowledgedBy")) acknowledgedBy = jsonData["acknowledgedBy"];
+            }
+            
+            if (!alertIntake->settled().acknowledge(alertID, acknowledgedBy, time(nullptr))) {
+                json error = {{"status", "error"}, {"message", "Alert not found"}};
+                res.status = 404;
+                res.set_content(error.dump(), "application/json");
+                return;
+            }
+            
+            Alert alert;
+            alertQueue->getAlert(alertID, alert);
+            if (alert.priority != INFO) alertEscalator->untrack(alert.alertID);    // INFO still expires
+            json response = {{"status", "success"}, {"alert", alertToJson(alert)}};
+            res.set_content(response.dump(), "application/json");
+        } catch (const std::exception& e) {
+            json error = {{"status", "error"}, {"message", e.what()}};
+            res.status = 400;
+            res.set_content(error.dump(), "application/json");
+        }
+    });
+    
+    // PUT /api/alert/:id/priority  body: {"priority": 1-5}
+    svr.Put(R"(/api/alert/(\d+)/priority)", [](const Request& req, Response& res) {
+        enableCORS(res);
+        try {
+            int alertID = std::stoi(req.matches[1]);
+            int priority = json::parse(req.body)["priority"].get<int>();
+            if (priority < CRITICAL || priority > INFO) {
+                json error = {{"status", "error"}, {"message", "Priority must be 1-5"}};
+                res.status = 400;
+                res.set_content(error.dump(), "application/json");
+                return;
+            }
+            
+            if (!alertIntake->settled().updatePriority(alertID, static_cast<AlertPriority>(priority))) {
+                json error = {{"status", "error"}, {"message", "Alert not found"}};
+                res.status = 404;
+                res.set_content(error.dump(), "application/json");
+                return;
+            }
+            
+            Alert alert;
+            alertQueue->getAlert(alertID, alert);
+            alertEscalator->track(alert);    // Clock restarts at the new priority
+            json response = {{"status", "success"}, {"alert", alertToJson(alert)}};
+            res.set_content(response.dump(), "application/json");
+        } catch (const std::exception& e) {
+            json error = {{"status", "error"}, {"message", e.what()}};
+            res.status = 400;
+            res.set_content(error.dump(), "application/json");
+        }
+    });
+    
+    // DELETE /api/alert/:id
+    svr.Delete(R"(/api/alert/(\d+))", [](const Request& req, Response& res) {
+        enableCORS(res);
+        // A merged repeat's ID removes the alert it joined
+        int alertID = alertIntake->settled().resolveAlertID(std::stoi(req.matches[1]));
+        if (!alertQueue->remove(alertID)) {
+            json error = {{"status", "error"}, {"message", "Alert not found"}};
+            res.status = 404;
+            res.set_content(error.dump(), "application/json");
+            return;
+        }
+        alertEscalator->untrack(alertID);
+        
+        json response = {{"status", "success"}, {"message", "Alert removed"}};
+        res.set_content(response.dump(), "application/json");
+    });
 
     // POST /api/drug-check
     svr.Post("/api/drug-check", [](const Request& req, Response& res) {
@@ -337,23 +1124,42 @@ int main() {
     int port = 8080;
     
     std::cout << "\n🚀 Server at http://" << host << ":" << port << std::endl;
+    std::cout << "Vitals storage engine: " << vitalSignsDB->getEngineName() << std::endl;
     std::cout << "\nEndpoints:" << std::endl;
     std::cout << "  GET  /                - Health check" << std::endl;
     std::cout << "  POST /api/vitals      - Add vitals" << std::endl;
     std::cout << "  GET  /api/vitals/:id  - Get vitals" << std::endl;
+    std::cout << "  GET  /api/vitals/:id/summary - Vital statistics" << std::endl;
+    std::cout << "  GET  /api/vitals/:id/trends - 5/15/60 min rolling statistics" << std::endl;
+    std::cout << "  POST /api/vitals/:id/scan - Scan history for abnormal vitals" << std::endl;
+    std::cout << "  GET  /api/vitals/query - Search vitals by condition" << std::endl;
+    std::cout << "  GET|PUT /api/thresholds/patient/:id - Patient alert thresholds" << std::endl;
+    std::cout << "  GET|PUT /api/thresholds/ward/:ward  - Ward alert thresholds" << std::endl;
     std::cout << "  POST /api/patient     - Add patient" << std::endl;
     std::cout << "  GET  /api/patient/:id - Get patient" << std::endl;
+    std::cout << "  GET  /api/patient/:id/score - NEWS2 early warning score" << std::endl;
     std::cout << "  GET  /api/patients    - Get all" << std::endl;
+    std::cout << "  GET  /api/ward/:ward/summary - Ward overview, one entry per bed" << std::endl;
     std::cout << "  POST /api/alert       - Create alert" << std::endl;
-    std::cout << "  GET  /api/alerts      - Get alerts" << std::endl;
+    std::cout << "  GET  /api/alerts      - Get alerts (?limit, offset, cursor, minPriority, unacknowledged, patientID, ward, type)" << std::endl;
+    std::cout << "  GET  /api/alerts/top  - Most urgent alert" << std::endl;
+    std::cout << "  PUT  /api/alert/:id/ack - Acknowledge alert" << std::endl;
+    std::cout << "  PUT  /api/alert/:id/priority - Escalate/de-escalate alert" << std::endl;
+    std::cout << "  DELETE /api/alert/:id - Cancel alert" << std::endl;
     std::cout << "\nPress Ctrl+C to stop\n" << std::endl;
     
     svr.listen(host.c_str(), port);
     
+    delete wardAggregator;
     delete vitalSignsDB;
     delete patientDB;
+    delete alertEscalator;
+    delete alertIntake;
     delete alertQueue;
     delete drugInteractionGraph;
+    delete thresholdScanner;
+    delete riskCalculator;
+    delete windowStats;
     
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,138 @@
+#include "alert_escalator.h"
+#include <ctime>
+#include <iostream>
+
+AlertEscalator::AlertEscalator(PriorityQueue& queue, const EscalationPolicy& policy,
+                               long tickMillis, bool background)
+    : queue(queue), policy(policy), nextToken(1),
+      escalatedCount(0), reminderCount(0), expiredCount(0),
+      wheel(tickMillis, background) {
+    queue.setAlertListener([this](const Alert& alert) { track(alert); });
+}
+
+AlertEscalator::~AlertEscalator() {
+    queue.setAlertListener(nullptr);
+}
+
+// Seconds until the next action for an alert in its current state, or 0
+// if nothing is due
+long AlertEscalator::delayFor(const Alert& alert) const {
+    if (alert.priority == INFO) return policy.infoExpireAfter;
+    if (alert.acknowledged) return 0;
+    
+    switch (alert.priority) {
+        case CRITICAL: return policy.criticalReminderEvery;
+        case HIGH:     return policy.highEscalateAfter;
+        case MEDIUM:   return policy.mediumEscalateAfter;
+        default:       return 0;
+    }
+}
+
+void AlertEscalator::arm(int alertID, long delaySeconds) {
+    std::lock_guard<std::mutex> lock(trackMutex);
+    auto it = pending.find(alertID);
+    if (it != pending.end()) {
+        wheel.cancel(it->second.timer);
+        pending.erase(it);
+    }
+    if (delaySeconds < 0) return;
+    
+    unsigned int token = nextToken++;
+    TimerID timer = wheel.schedule(delaySeconds * 1000, [this, alertID, token]() {
+        fire(alertID, token);
+    });
+    pending[alertID] = {timer, token};
+}
+
+void AlertEscalator::track(const Alert& alert) {
+    long delay = delayFor(alert);
+    if (delay > 0) {
+        arm(alert.alertID, delay);
+    } else {
+        untrack(alert.alertID);
+    }
+}
+
+void AlertEscalator::untrack(int alertID) {
+    std::lock_guard<std::mutex> lock(trackMutex);
+    auto it = pending.find(alertID);
+    if (it == pending.end()) return;
+    
+    wheel.cancel(it->second.timer);
+    pending.erase(it);
+}
+
+// After a restart the time an alert has already been open counts, so
+// overdue alerts act on the next tick and reminders keep their phase
+int AlertEscalator::trackQueued() {
+    long now = time(nullptr);
+    int tracked = 0;
+    
+    for (const auto& alert : *queue.getSortedSnapshot()) {
+        long delay = delayFor(alert);
+        if (delay <= 0) continue;
+        
+        long age = now - alert.timestamp;
+        if (age < 0) age = 0;
+        long remaining = alert.priority == CRITICAL ? delay - age % delay : delay - age;
+        arm(alert.alertID, remaining > 0 ? remaining : 0);
+        tracked++;
+    }
+    
+    std::cout << "[ESCALATION] Tracking " << tracked << " queued alerts" << std::endl;
+    return tracked;
+}
+
+void AlertEscalator::setReminderHandler(const std::function<void(const Alert&)>& handler) {
+    std::lock_guard<std::mutex> lock(trackMutex);
+    reminderHandler = handler;
+}
+
+// Runs on the wheel thread
+void AlertEscalator::fire(int alertID, unsigned int token) {
+    std::function<void(const Alert&)> handler;
+    {
+        std::lock_guard<std::mutex> lock(trackMutex);
+        auto it = pending.find(alertID);
+        if (it == pending.end() || it->second.token != token) return;
+        pending.erase(it);
+        handler = reminderHandler;
+    }
+    
+    Alert alert;
+    if (!queue.getAlert(alertID, alert)) return;
+    
+    if (alert.priority == INFO) {
+        if (queue.remove(alertID)) {
+            expiredCount++;
+            std::cout << "[ESCALATION] Expired INFO alert " << alertID << std::endl;
+        }
+        return;
+    }
+    if (alert.acknowledged) return;
+    
+    if (alert.priority == CRITICAL) {
+        reminderCount++;
+        if (handler) {
+            handler(alert);
+        } else {
+            std::cout << "[ESCALATION] Reminder: CRITICAL alert " << alertID
+                      << " for patient " << alert.patientID << " is unacknowledged" << std::endl;
+        }
+    } else if (alert.priority == HIGH || alert.priority == MEDIUM) {
+        // Re-checked under the queue lock: an ack since getAlert() wins
+        Alert before = alert;
+        bool escalated;
+        if (!queue.escalateIfUnacknowledged(alertID, alert, escalated)) return;
+        
+        if (escalated) {
+            escalatedCount++;
+            std::cout << "[ESCALATION] Alert " << alertID << " unacknowledged, "
+                      << before.getPriorityString() << " -> "
+                      << alert.getPriorityString() << std::endl;
+        }
+    }
+    
+    long delay = delayFor(alert);
+    if (delay > 0) arm(alertID, delay);
+}
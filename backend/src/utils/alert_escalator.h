@@ -0,0 +1,84 @@
+#ifndef ALERT_ESCALATOR_H
+#define ALERT_ESCALATOR_H
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include "../models/alert.h"
+#include "../data_structures/priority_queue.h"
+#include "../data_structures/timer_wheel.h"
+
+// Seconds an alert may sit unacknowledged before each action; 0 disables it
+struct EscalationPolicy {
+    long mediumEscalateAfter;     // MEDIUM -> HIGH
+    long highEscalateAfter;       // HIGH -> CRITICAL
+    long criticalReminderEvery;   // Repeated while a CRITICAL alert is open
+    long infoExpireAfter;         // INFO alerts are removed, acknowledged or not
+    
+    EscalationPolicy()
+        : mediumEscalateAfter(600), highEscalateAfter(120),
+          criticalReminderEvery(60), infoExpireAfter(3600) {}
+};
+
+// Drives time-based alert handling from a timer wheel: one pending timer
+// per tracked alert, armed on track() and cancelled on untrack(). The
+// escalator listens on the queue, so every newly queued alert is tracked
+// and a merged repeat that raises an alert's priority re-arms it. When a
+// timer fires the alert is re-read from the queue and the action for its
+// current state is applied, so a stale timer can never act on an alert
+// that was acknowledged or removed in the meantime.
+class AlertEscalator {
+private:
+    struct Pending {
+        TimerID timer;
+        unsigned int token;    // Matches the callback that may act on it
+    };
+    
+    PriorityQueue& queue;
+    EscalationPolicy policy;
+    std::function<void(const Alert&)> reminderHandler;
+    
+    std::mutex trackMutex;
+    std::unordered_map<int, Pending> pending;
+    unsigned int nextToken;
+    
+    std::atomic<int> escalatedCount;
+    std::atomic<int> reminderCount;
+    std::atomic<int> expiredCount;
+    
+    // Declared last so its thread stops before the members above go away
+    TimerWheel wheel;
+    
+    long delayFor(const Alert& alert) const;
+    void arm(int alertID, long delaySeconds);
+    void fire(int alertID, unsigned int token);
+
+public:
+    // With background = false the clock only moves via advance()
+    AlertEscalator(PriorityQueue& queue, const EscalationPolicy& policy = EscalationPolicy(),
+                   long tickMillis = 1000, bool background = true);
+    ~AlertEscalator();
+    
+    // Start (or restart) the clock for an alert at its current priority
+    void track(const Alert& alert);
+    
+    // Stop timing an alert, e.g. once acknowledged or removed
+    void untrack(int alertID);
+    
+    // Track every alert already in the queue, counting time since creation
+    int trackQueued();
+    
+    // Called on the wheel thread for each CRITICAL reminder
+    void setReminderHandler(const std::function<void(const Alert&)>& handler);
+    
+    int advance(uint64_t ticks) { return wheel.advance(ticks); }
+    
+    size_t getPendingCount() const { return wheel.getPendingCount(); }
+    int getEscalatedCount() const { return escalatedCount.load(); }
+    int getReminderCount() const { return reminderCount.load(); }
+    int getExpiredCount() const { return expiredCount.load(); }
+    const EscalationPolicy& getPolicy() const { return policy; }
+};
+
+#endif
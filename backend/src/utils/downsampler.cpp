@@ -0,0 +1,17 @@
+#include "downsampler.h"
+
+std::vector<size_t> Downsampler::lttb(const VitalBatch& batch, VitalField field, size_t threshold) {
+    const int64_t* x = batch.timestamp.data();
+    size_t n = batch.size();
+    
+    switch (field) {
+        case FIELD_PATIENT_ID: return lttb(x, batch.patientID.data(), n, threshold);
+        case FIELD_TIMESTAMP: return lttb(x, x, n, threshold);
+        case FIELD_HEART_RATE: return lttb(x, batch.heart_rate.data(), n, threshold);
+        case FIELD_SYSTOLIC_BP: return lttb(x, batch.systolic_bp.data(), n, threshold);
+        case FIELD_DIASTOLIC_BP: return lttb(x, batch.diastolic_bp.data(), n, threshold);
+        case FIELD_SPO2: return lttb(x, batch.spo2.data(), n, threshold);
+        case FIELD_TEMPERATURE: return lttb(x, batch.temperature.data(), n, threshold);
+    }
+    return std::vector<size_t>();
+}
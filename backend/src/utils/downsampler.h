@@ -0,0 +1,92 @@
+#ifndef DOWNSAMPLER_H
+#define DOWNSAMPLER_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include "../models/vital_batch.h"
+
+// Largest-Triangle-Three-Buckets downsampling for charts. The first and
+// last points are always kept; every bucket in between contributes the
+// point forming the largest triangle with its neighbours, so spikes and
+// turning points survive while flat stretches collapse.
+class Downsampler {
+public:
+    // Indices (ascending) of at most `threshold` points of (x[i], y[i]).
+    // Returns every index when n <= threshold.
+    template<typename T>
+    static std::vector<size_t> lttb(const int64_t* x, const T* y, size_t n, size_t threshold);
+    
+    // Same over one vital column of a batch, using its timestamps as x
+    static std::vector<size_t> lttb(const VitalBatch& batch, VitalField field, size_t threshold);
+};
+
+// ==================== IMPLEMENTATION ====================
+
+template<typename T>
+std::vector<size_t> Downsampler::lttb(const int64_t* x, const T* y, size_t n, size_t threshold) {
+    std::vector<size_t> selected;
+    if (n <= threshold || threshold == 0) {
+        selected.reserve(n);
+        for (size_t i = 0; i < n; i++) selected.push_back(i);
+        return selected;
+    }
+    if (threshold == 1) {
+        selected.push_back(n - 1);
+        return selected;
+    }
+    
+    selected.reserve(threshold);
+    selected.push_back(0);
+    
+    // Interior points split into threshold - 2 buckets
+    const double bucketSize = static_cast<double>(n - 2) / (threshold - 2);
+    const int64_t origin = x[0];
+    size_t anchor = 0;
+    
+    for (size_t bucket = 0; bucket + 2 < threshold; bucket++) {
+        size_t start = static_cast<size_t>(bucket * bucketSize) + 1;
+        size_t end = static_cast<size_t>((bucket + 1) * bucketSize) + 1;
+        
+        // Average of the next bucket stands in for the third vertex
+        size_t nextStart = end;
+        size_t nextEnd = static_cast<size_t>((bucket + 2) * bucketSize) + 1;
+        if (nextEnd > n) nextEnd = n;
+        if (nextStart >= nextEnd) {
+            nextStart = n - 1;
+            nextEnd = n;
+        }
+        
+        double avgX = 0;
+        double avgY = 0;
+        for (size_t i = nextStart; i < nextEnd; i++) {
+            avgX += x[i] - origin;
+            avgY += y[i];
+        }
+        avgX /= (nextEnd - nextStart);
+        avgY /= (nextEnd - nextStart);
+        
+        double anchorX = x[anchor] - origin;
+        double anchorY = y[anchor];
+        double bestArea = -1;
+        size_t best = start;
+        
+        for (size_t i = start; i < end; i++) {
+            double area = std::fabs((anchorX - avgX) * (static_cast<double>(y[i]) - anchorY) -
+                                    (anchorX - (x[i] - origin)) * (avgY - anchorY));
+            if (area > bestArea) {
+                bestArea = area;
+                best = i;
+            }
+        }
+        
+        selected.push_back(best);
+        anchor = best;
+    }
+    
+    selected.push_back(n - 1);
+    return selected;
+}
+
+#endif
@@ -0,0 +1,378 @@
+#include "risk_calculator.h"
+#include <iostream>
+#include <algorithm>
+#include <cstdio>
+
+// ==================== EarlyWarningScore ====================
+
+EarlyWarningScore::EarlyWarningScore()
+    : timestamp(0), total(0), heartRatePoints(0), systolicPoints(0),
+      spo2Points(0), temperaturePoints(0), level(RISK_LOW) {}
+
+void EarlyWarningScore::writeToDisk(std::ofstream& file) const {
+    int levelValue = level;
+    file.write(reinterpret_cast<const char*>(&timestamp), sizeof(timestamp));
+    file.write(reinterpret_cast<const char*>(&total), sizeof(total));
+    file.write(reinterpret_cast<const char*>(&heartRatePoints), sizeof(heartRatePoints));
+    file.write(reinterpret_cast<const char*>(&systolicPoints), sizeof(systolicPoints));
+    file.write(reinterpret_cast<const char*>(&spo2Points), sizeof(spo2Points));
+    file.write(reinterpret_cast<const char*>(&temperaturePoints), sizeof(temperaturePoints));
+    file.write(reinterpret_cast<const char*>(&levelValue), sizeof(levelValue));
+}
+
+void EarlyWarningScore::readFromDisk(std::ifstream& file) {
+    int levelValue = 0;
+    file.read(reinterpret_cast<char*>(&timestamp), sizeof(timestamp));
+    file.read(reinterpret_cast<char*>(&total), sizeof(total));
+    file.read(reinterpret_cast<char*>(&heartRatePoints), sizeof(heartRatePoints));
+    file.read(reinterpret_cast<char*>(&systolicPoints), sizeof(systolicPoints));
+    file.read(reinterpret_cast<char*>(&spo2Points), sizeof(spo2Points));
+    file.read(reinterpret_cast<char*>(&temperaturePoints), sizeof(temperaturePoints));
+    file.read(reinterpret_cast<char*>(&levelValue), sizeof(levelValue));
+    level = static_cast<RiskLevel>(levelValue);
+}
+
+// ==================== RiskCalculator ====================
+
+RiskCalculator::RiskCalculator(const std::string& filePath)
+    : dataFilePath(filePath), logEntries(0),
+      compacting(false), rotatedLogLeft(false), compactStop(false) {
+    if (!dataFilePath.empty()) {
+        logFilePath = dataFilePath + ".log";
+        rotatedLogPath = dataFilePath + ".log.old";
+        loadFromDisk();
+        logFile.open(logFilePath, std::ios::binary | std::ios::app);
+        if (!logFile.is_open()) {
+            std::cerr << "[NEWS2] Error: Cannot open score log: " << logFilePath << std::endl;
+        }
+    }
+}
+
+// Every score is already logged; this only keeps the next start fast
+RiskCalculator::~RiskCalculator() {
+    if (dataFilePath.empty()) return;
+    
+    saveToDisk();
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        compactStop = true;
+    }
+    compactCond.notify_all();
+    if (compactThread.joinable()) {
+        compactThread.join();
+    }
+}
+
+int RiskCalculator::scoreHeartRate(int heartRate) {
+    if (heartRate <= 40) return 3;
+    if (heartRate <= 50) return 1;
+    if (heartRate <= 90) return 0;
+    if (heartRate <= 110) return 1;
+    if (heartRate <= 130) return 2;
+    return 3;
+}
+
+int RiskCalculator::scoreSystolic(int systolic) {
+    if (systolic <= 90) return 3;
+    if (systolic <= 100) return 2;
+    if (systolic <= 110) return 1;
+    if (systolic <= 219) return 0;
+    return 3;
+}
+
+// SpO2 scale 1 (no hypercapnic respiratory failure target range)
+int RiskCalculator::scoreSpO2(int spo2) {
+    if (spo2 <= 91) return 3;
+    if (spo2 <= 93) return 2;
+    if (spo2 <= 95) return 1;
+    return 0;
+}
+
+int RiskCalculator::scoreTemperature(float temperature) {
+    if (temperature <= 35.0f) return 3;
+    if (temperature <= 36.0f) return 1;
+    if (temperature <= 38.0f) return 0;
+    if (temperature <= 39.0f) return 1;
+    return 2;
+}
+
+EarlyWarningScore RiskCalculator::score(const VitalRecord& record) {
+    EarlyWarningScore result;
+    result.timestamp = record.timestamp;
+    result.heartRatePoints = scoreHeartRate(record.heart_rate);
+    result.systolicPoints = scoreSystolic(record.systolic_bp);
+    result.spo2Points = scoreSpO2(record.spo2);
+    result.temperaturePoints = scoreTemperature(record.temperature);
+    result.total = result.heartRatePoints + result.systolicPoints +
+                   result.spo2Points + result.temperaturePoints;
+    
+    int maxComponent = std::max(std::max(result.heartRatePoints, result.systolicPoints),
+                                std::max(result.spo2Points, result.temperaturePoints));
+    result.level = classify(result.total, maxComponent);
+    return result;
+}
+
+RiskLevel RiskCalculator::classify(int total, int maxComponent) {
+    if (total >= 7) return RISK_HIGH;
+    if (total >= 5) return RISK_MEDIUM;
+    if (maxComponent >= 3) return RISK_LOW_MEDIUM;
+    return RISK_LOW;
+}
+
+std::string RiskCalculator::getRiskString(RiskLevel level) {
+    switch (level) {
+        case RISK_LOW: return "LOW";
+        case RISK_LOW_MEDIUM: return "LOW-MEDIUM";
+        case RISK_MEDIUM: return "MEDIUM";
+        case RISK_HIGH: return "HIGH";
+        default: return "UNKNOWN";
+    }
+}
+
+AlertPriority RiskCalculator::alertPriority(RiskLevel level) {
+    switch (level) {
+        case RISK_HIGH: return CRITICAL;
+        case RISK_MEDIUM: return HIGH;
+        case RISK_LOW_MEDIUM: return MEDIUM;
+        default: return INFO;
+    }
+}
+
+ScoreUpdate RiskCalculator::update(const VitalRecord& record) {
+    ScoreUpdate result;
+    result.score = score(record);
+    result.escalated = false;
+    
+    std::lock_guard<std::mutex> lock(stateMutex);
+    PatientRiskState& state = patients[record.patientID];
+    result.previousLevel = state.level;
+    
+    // Late or back-filled readings do not rewrite the current state
+    if (!applyScore(state, result.score)) {
+        return result;
+    }
+    
+    result.escalated = result.score.level > result.previousLevel;
+    if (logFile.is_open()) {
+        appendToLog(record.patientID, result.score);
+        rotateLogIfNeeded();
+    }
+    return result;
+}
+
+// Record a score as the patient's latest unless it is older than it.
+// Returns false if the score was not recorded.
+bool RiskCalculator::applyScore(PatientRiskState& state, const EarlyWarningScore& score) {
+    if (!state.history.empty() && score.timestamp < state.history.back().timestamp) {
+        return false;
+    }
+    
+    state.history.push(score);
+    state.level = score.level;
+    return true;
+}
+
+bool RiskCalculator::getLatest(int patientID, EarlyWarningScore& score) const {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    auto it = patients.find(patientID);
+    if (it == patients.end() || it->second.history.empty()) return false;
+    
+    score = it->second.history.back();
+    return true;
+}
+
+std::vector<EarlyWarningScore> RiskCalculator::getHistory(int patientID, int count) const {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    auto it = patients.find(patientID);
+    if (it == patients.end()) return std::vector<EarlyWarningScore>();
+    return it->second.history.toVector(count);
+}
+
+int RiskCalculator::getPatientCount() const {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    return patients.size();
+}
+
+// Fixed-size entries, flushed before update() returns
+void RiskCalculator::appendToLog(int patientID, const EarlyWarningScore& score) {
+    logFile.write(reinterpret_cast<const char*>(&patientID), sizeof(patientID));
+    score.writeToDisk(logFile);
+    logFile.flush();
+    logEntries++;
+}
+
+// The snapshot holds at most RISK_HISTORY_CAPACITY scores per patient, so
+// merging the log in once it outgrows that keeps both bounded. Here the
+// full log is only renamed aside; the compactor thread does the merge.
+void RiskCalculator::rotateLogIfNeeded() {
+    if (compacting || rotatedLogLeft) return;    // Keep appending until it is done
+    int limit = std::max(RISK_LOG_COMPACT_MIN, static_cast<int>(patients.size()) * RISK_HISTORY_CAPACITY);
+    if (logEntries < limit) return;
+    
+    logFile.close();
+    if (std::rename(logFilePath.c_str(), rotatedLogPath.c_str()) != 0) {
+        std::cerr << "[NEWS2] Error: Cannot rotate score log: " << logFilePath << std::endl;
+        logFile.open(logFilePath, std::ios::binary | std::ios::app);
+        return;
+    }
+    logFile.open(logFilePath, std::ios::binary | std::ios::trunc);
+    logEntries = 0;
+    
+    compacting = true;
+    if (!compactThread.joinable()) {
+        compactThread = std::thread(&RiskCalculator::compactLoop, this);
+    }
+    compactCond.notify_all();
+}
+
+// Runs on compactThread. Rebuilds the snapshot from the files alone (old
+// snapshot plus rotated log), so update() and readers are never blocked
+// while it is written.
+void RiskCalculator::compactLoop() {
+    std::unique_lock<std::mutex> lock(stateMutex);
+    while (true) {
+        compactCond.wait(lock, [this]() { return compacting || compactStop; });
+        if (!compacting) return;
+        
+        lock.unlock();
+        PatientStates merged;
+        readSnapshot(dataFilePath, merged);
+        replayLog(rotatedLogPath, merged);
+        bool written = writeSnapshot(dataFilePath, merged);
+        if (written) {
+            std::remove(rotatedLogPath.c_str());
+        }
+        lock.lock();
+        
+        compacting = false;
+        rotatedLogLeft = !written;
+        compactCond.notify_all();
+    }
+}
+
+void RiskCalculator::truncateLog() {
+    bool reopen = logFile.is_open();
+    if (reopen) logFile.close();
+    logFile.open(logFilePath, std::ios::binary | std::ios::trunc);
+    if (!reopen) logFile.close();
+    logEntries = 0;
+}
+
+// Apply every complete log entry on top of `states`. An entry that
+// repeats the latest score was already merged into the snapshot by a
+// compaction that stopped before removing its log.
+int RiskCalculator::replayLog(const std::string& path, PatientStates& states) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return 0;
+    
+    int replayed = 0;
+    while (true) {
+        int patientID = 0;
+        EarlyWarningScore score;
+        file.read(reinterpret_cast<char*>(&patientID), sizeof(patientID));
+        score.readFromDisk(file);
+        if (!file) break;    // End of log or a torn final entry
+        
+        replayed++;
+        
+        PatientRiskState& state = states[patientID];
+        if (!state.history.empty() && state.history.back().timestamp == score.timestamp &&
+            state.history.back().total == score.total) {
+            continue;
+        }
+        applyScore(state, score);
+    }
+    return replayed;
+}
+
+void RiskCalculator::saveToDisk() {
+    if (dataFilePath.empty()) return;
+    
+    std::unique_lock<std::mutex> lock(stateMutex);
+    compactCond.wait(lock, [this]() { return !compacting; });
+    if (writeSnapshot(dataFilePath, patients)) {
+        std::remove(rotatedLogPath.c_str());
+        rotatedLogLeft = false;
+        truncateLog();
+    }
+}
+
+// Written to a temporary file and renamed over the old snapshot
+bool RiskCalculator::writeSnapshot(const std::string& path, const PatientStates& states) {
+    std::string tempPath = path + ".tmp";
+    std::ofstream file(tempPath, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "[NEWS2] Error: Cannot open file for writing: " << tempPath << std::endl;
+        return false;
+    }
+    
+    int patientCount = states.size();
+    file.write(reinterpret_cast<const char*>(&patientCount), sizeof(patientCount));
+    
+    for (const auto& entry : states) {
+        int levelValue = entry.second.level;
+        int historyCount = entry.second.history.size();
+        file.write(reinterpret_cast<const char*>(&entry.first), sizeof(entry.first));
+        file.write(reinterpret_cast<const char*>(&levelValue), sizeof(levelValue));
+        file.write(reinterpret_cast<const char*>(&historyCount), sizeof(historyCount));
+        for (int i = 0; i < historyCount; i++) {
+            entry.second.history[i].writeToDisk(file);
+        }
+    }
+    
+    file.close();
+    if (!file || std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::cerr << "[NEWS2] Error: Cannot replace " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void RiskCalculator::readSnapshot(const std::string& path, PatientStates& states) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return;
+    
+    int patientCount = 0;
+    file.read(reinterpret_cast<char*>(&patientCount), sizeof(patientCount));
+    
+    for (int p = 0; p < patientCount && file; p++) {
+        int patientID = 0;
+        int levelValue = 0;
+        int historyCount = 0;
+        file.read(reinterpret_cast<char*>(&patientID), sizeof(patientID));
+        file.read(reinterpret_cast<char*>(&levelValue), sizeof(levelValue));
+        file.read(reinterpret_cast<char*>(&historyCount), sizeof(historyCount));
+        
+        PatientRiskState& state = states[patientID];
+        state.level = static_cast<RiskLevel>(levelValue);
+        for (int i = 0; i < historyCount && file; i++) {
+            EarlyWarningScore entry;
+            entry.readFromDisk(file);
+            state.history.push(entry);
+        }
+    }
+}
+
+void RiskCalculator::loadFromDisk() {
+    if (dataFilePath.empty()) return;
+    
+    std::unique_lock<std::mutex> lock(stateMutex);
+    compactCond.wait(lock, [this]() { return !compacting; });
+    patients.clear();
+    readSnapshot(dataFilePath, patients);
+    
+    // A log rotated aside for an unfinished compaction precedes the live one.
+    // Fold both into a fresh snapshot so the log starts empty.
+    int replayed = replayLog(rotatedLogPath, patients) + replayLog(logFilePath, patients);
+    if (replayed > 0) {
+        std::cout << "[NEWS2] Replayed " << replayed << " logged scores" << std::endl;
+        if (writeSnapshot(dataFilePath, patients)) {
+            std::remove(rotatedLogPath.c_str());
+            truncateLog();
+        }
+    } else {
+        std::remove(rotatedLogPath.c_str());
+    }
+    rotatedLogLeft = std::ifstream(rotatedLogPath).good();
+    std::cout << "[NEWS2] Loaded score history for " << patients.size() << " patients" << std::endl;
+}
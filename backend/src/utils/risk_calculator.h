@@ -0,0 +1,130 @@
+#ifndef RISK_CALCULATOR_H
+#define RISK_CALCULATOR_H
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <fstream>
+#include "../models/vital_record.h"
+#include "../models/alert.h"
+#include "../data_structures/circular_buffer.h"
+
+// Scores kept per patient for trend display
+const int RISK_HISTORY_CAPACITY = 256;
+
+// Score-log entries tolerated before they are folded into the snapshot
+const int RISK_LOG_COMPACT_MIN = 4096;
+
+// NEWS2 clinical risk bands
+enum RiskLevel {
+    RISK_LOW = 0,          // Aggregate 0-4
+    RISK_LOW_MEDIUM = 1,   // A single parameter scoring 3
+    RISK_MEDIUM = 2,       // Aggregate 5-6
+    RISK_HIGH = 3          // Aggregate 7 or more
+};
+
+// NEWS2-style early warning score for one reading. Respiration rate and
+// consciousness are not monitored, so only four parameters contribute.
+struct EarlyWarningScore {
+    long timestamp;
+    int total;
+    int heartRatePoints;
+    int systolicPoints;
+    int spo2Points;
+    int temperaturePoints;
+    RiskLevel level;
+    
+    EarlyWarningScore();
+    
+    void writeToDisk(std::ofstream& file) const;
+    void readFromDisk(std::ifstream& file);
+};
+
+// Result of feeding one reading into the engine
+struct ScoreUpdate {
+    EarlyWarningScore score;
+    RiskLevel previousLevel;
+    bool escalated;         // Risk band rose; raise a DETERIORATION alert
+};
+
+// Streaming per-patient early warning scores. Each reading is scored in
+// constant time and appended to the patient's bounded history; an alert is
+// due only when the risk band rises, so a patient holding steady at one
+// level does not re-alert on every reading.
+//
+// With a file path, every recorded score is appended to "<file>.log" as it
+// happens, so risk levels survive a crash or a kill without a clean
+// shutdown. A full log is renamed aside and merged into the snapshot by a
+// background compactor, never on the update() path.
+class RiskCalculator {
+private:
+    struct PatientRiskState {
+        CircularBuffer<EarlyWarningScore> history;
+        RiskLevel level;
+        
+        PatientRiskState() : history(RISK_HISTORY_CAPACITY), level(RISK_LOW) {}
+    };
+    
+    typedef std::unordered_map<int, PatientRiskState> PatientStates;
+    
+    PatientStates patients;
+    std::string dataFilePath;
+    std::string logFilePath;
+    std::string rotatedLogPath;    // Full log waiting to be merged
+    std::ofstream logFile;
+    int logEntries;
+    mutable std::mutex stateMutex;
+    
+    // Compaction state, guarded by stateMutex
+    std::condition_variable compactCond;
+    bool compacting;         // rotatedLogPath is being merged
+    bool rotatedLogLeft;     // A failed merge left it behind; don't rotate
+    bool compactStop;
+    std::thread compactThread;    // Started on the first rotation
+    
+    static bool applyScore(PatientRiskState& state, const EarlyWarningScore& score);
+    static void readSnapshot(const std::string& path, PatientStates& states);
+    static int replayLog(const std::string& path, PatientStates& states);
+    static bool writeSnapshot(const std::string& path, const PatientStates& states);
+    
+    // Called with stateMutex held
+    void appendToLog(int patientID, const EarlyWarningScore& score);
+    void rotateLogIfNeeded();
+    void truncateLog();
+    
+    void compactLoop();
+
+public:
+    RiskCalculator(const std::string& filePath = "");
+    ~RiskCalculator();
+    
+    // Per-parameter NEWS2 points
+    static int scoreHeartRate(int heartRate);
+    static int scoreSystolic(int systolic);
+    static int scoreSpO2(int spo2);
+    static int scoreTemperature(float temperature);
+    
+    static EarlyWarningScore score(const VitalRecord& record);
+    static RiskLevel classify(int total, int maxComponent);
+    static std::string getRiskString(RiskLevel level);
+    static AlertPriority alertPriority(RiskLevel level);
+    
+    // Score a new reading and update the patient's state. Readings older
+    // than the latest scored one are scored but not recorded.
+    ScoreUpdate update(const VitalRecord& record);
+    
+    bool getLatest(int patientID, EarlyWarningScore& score) const;
+    std::vector<EarlyWarningScore> getHistory(int patientID, int count = -1) const;
+    int getPatientCount() const;
+    
+    // Disk persistence: saveToDisk() waits out a running compaction, then
+    // writes a snapshot and empties the log; loadFromDisk() reads the
+    // snapshot and replays any rotated log and the live log on top
+    void saveToDisk();
+    void loadFromDisk();
+};
+
+#endif
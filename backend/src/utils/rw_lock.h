@@ -0,0 +1,50 @@
+#ifndef RW_LOCK_H
+#define RW_LOCK_H
+
+#include <pthread.h>
+
+// Reader-writer lock (C++11 has no shared_mutex). Any number of readers
+// may hold it together; a writer holds it alone.
+class RWLock {
+private:
+    pthread_rwlock_t lock;
+    
+    RWLock(const RWLock&);
+    RWLock& operator=(const RWLock&);
+
+public:
+    RWLock() { pthread_rwlock_init(&lock, nullptr); }
+    ~RWLock() { pthread_rwlock_destroy(&lock); }
+    
+    void lockRead() { pthread_rwlock_rdlock(&lock); }
+    void lockWrite() { pthread_rwlock_wrlock(&lock); }
+    void unlock() { pthread_rwlock_unlock(&lock); }
+};
+
+// Scoped shared (read) hold
+class ReadGuard {
+private:
+    RWLock& rwLock;
+    
+    ReadGuard(const ReadGuard&);
+    ReadGuard& operator=(const ReadGuard&);
+
+public:
+    explicit ReadGuard(RWLock& l) : rwLock(l) { rwLock.lockRead(); }
+    ~ReadGuard() { rwLock.unlock(); }
+};
+
+// Scoped exclusive (write) hold
+class WriteGuard {
+private:
+    RWLock& rwLock;
+    
+    WriteGuard(const WriteGuard&);
+    WriteGuard& operator=(const WriteGuard&);
+
+public:
+    explicit WriteGuard(RWLock& l) : rwLock(l) { rwLock.lockWrite(); }
+    ~WriteGuard() { rwLock.unlock(); }
+};
+
+#endif
@@ -0,0 +1,228 @@
+#include "sliding_window_stats.h"
+#include <algorithm>
+
+// ==================== WindowAccumulator ====================
+
+WindowAccumulator::WindowAccumulator() {
+    reset();
+}
+
+void WindowAccumulator::reset() {
+    count = 0;
+    mean = 0;
+    m2 = 0;
+    sumT = 0;
+    sumTT = 0;
+    sumTX = 0;
+    sumX = 0;
+    minDeque.clear();
+    maxDeque.clear();
+}
+
+void WindowAccumulator::add(long sequence, double t, double x) {
+    count++;
+    double delta = x - mean;
+    mean += delta / count;
+    m2 += delta * (x - mean);
+    
+    sumT += t;
+    sumTT += t * t;
+    sumTX += t * x;
+    sumX += x;
+    
+    // Drop entries that can never be the min/max again
+    while (!minDeque.empty() && minDeque.back().second >= x) minDeque.pop_back();
+    minDeque.push_back(std::make_pair(sequence, x));
+    while (!maxDeque.empty() && maxDeque.back().second <= x) maxDeque.pop_back();
+    maxDeque.push_back(std::make_pair(sequence, x));
+}
+
+// Readings leave in the order they arrived, so only deque fronts expire
+void WindowAccumulator::remove(long sequence, double t, double x) {
+    if (count <= 1) {
+        reset();
+        return;
+    }
+    
+    double delta = x - mean;
+    count--;
+    mean -= delta / count;
+    m2 -= delta * (x - mean);
+    if (m2 < 0) m2 = 0;
+    
+    sumT -= t;
+    sumTT -= t * t;
+    sumTX -= t * x;
+    sumX -= x;
+    
+    if (!minDeque.empty() && minDeque.front().first == sequence) minDeque.pop_front();
+    if (!maxDeque.empty() && maxDeque.front().first == sequence) maxDeque.pop_front();
+}
+
+WindowFieldStats WindowAccumulator::getStats() const {
+    WindowFieldStats stats;
+    if (count == 0) return stats;
+    
+    stats.mean = mean;
+    stats.variance = count > 1 ? m2 / (count - 1) : 0;
+    stats.min = minDeque.front().second;
+    stats.max = maxDeque.front().second;
+    
+    double denominator = count * sumTT - sumT * sumT;
+    if (count > 1 && denominator > 1e-9) {
+        stats.slopePerMinute = 60.0 * (count * sumTX - sumT * sumX) / denominator;
+    }
+    return stats;
+}
+
+// ==================== SlidingWindowStats ====================
+
+SlidingWindowStats::PatientWindows::PatientWindows()
+    : firstSequence(0), nextSequence(0), referenceTime(0) {
+    for (int w = 0; w < SLIDING_WINDOW_COUNT; w++) {
+        windowStart[w] = 0;
+    }
+}
+
+void SlidingWindowStats::expire(PatientWindows& state, long now) {
+    long oldestStart = state.nextSequence;
+    
+    for (int w = 0; w < SLIDING_WINDOW_COUNT; w++) {
+        long cutoff = now - SLIDING_WINDOW_SECONDS[w];
+        while (state.windowStart[w] < state.nextSequence &&
+               state.at(state.windowStart[w]).timestamp <= cutoff) {
+            const Sample& sample = state.at(state.windowStart[w]);
+            double t = sample.timestamp - state.referenceTime;
+            for (int f = 0; f < WINDOW_FIELD_COUNT; f++) {
+                state.accumulators[w][f].remove(state.windowStart[w], t, sample.values[f]);
+            }
+            state.windowStart[w]++;
+        }
+        oldestStart = std::min(oldestStart, state.windowStart[w]);
+    }
+    
+    // Release samples no window still covers
+    while (state.firstSequence < oldestStart) {
+        state.samples.pop_front();
+        state.firstSequence++;
+    }
+}
+
+bool SlidingWindowStats::add(const VitalRecord& record) {
+    double values[WINDOW_FIELD_COUNT];
+    for (int f = 0; f < WINDOW_FIELD_COUNT; f++) {
+        values[f] = record.getField(WINDOW_FIELDS[f]);
+    }
+    
+    std::lock_guard<std::mutex> lock(statsMutex);
+    return append(patients[record.patientID], record.timestamp, values);
+}
+
+int SlidingWindowStats::seedIfEmpty(int patientID, const std::vector<VitalRecord>& history) {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    PatientWindows& state = patients[patientID];
+    
+    // Skip what the longest window has already let go of, so a reseed
+    // does not bring back expired readings
+    long newest = history.empty() ? 0 : history.back().timestamp;
+    if (!state.samples.empty()) newest = std::max(newest, state.samples.back().timestamp);
+    long horizon = newest - SLIDING_WINDOW_SECONDS[SLIDING_WINDOW_COUNT - 1];
+    
+    size_t first = 0;
+    while (first < history.size() && history[first].timestamp <= horizon) {
+        first++;
+    }
+    size_t older = first;
+    while (older < history.size() &&
+           (state.samples.empty() || history[older].timestamp < state.samples.front().timestamp)) {
+        older++;
+    }
+    if (older == first) return 0;
+    
+    // Rebuild: the history first, then whatever was ingested meanwhile
+    std::deque<Sample> live;
+    live.swap(state.samples);
+    state = PatientWindows();
+    
+    int seeded = 0;
+    for (size_t i = first; i < older; i++) {
+        double values[WINDOW_FIELD_COUNT];
+        for (int f = 0; f < WINDOW_FIELD_COUNT; f++) {
+            values[f] = history[i].getField(WINDOW_FIELDS[f]);
+        }
+        if (append(state, history[i].timestamp, values)) seeded++;
+    }
+    for (const auto& sample : live) {
+        append(state, sample.timestamp, sample.values);
+    }
+    return seeded;
+}
+
+// Called with statsMutex held
+bool SlidingWindowStats::append(PatientWindows& state, long timestamp, const double* values) {
+    if (!state.samples.empty() && timestamp < state.samples.back().timestamp) {
+        return false;
+    }
+    
+    // Keep regression times small by re-basing whenever the windows drain
+    if (state.samples.empty()) {
+        state.referenceTime = timestamp;
+    }
+    
+    Sample sample;
+    sample.timestamp = timestamp;
+    for (int f = 0; f < WINDOW_FIELD_COUNT; f++) {
+        sample.values[f] = values[f];
+    }
+    
+    long sequence = state.nextSequence++;
+    state.samples.push_back(sample);
+    
+    double t = sample.timestamp - state.referenceTime;
+    for (int w = 0; w < SLIDING_WINDOW_COUNT; w++) {
+        for (int f = 0; f < WINDOW_FIELD_COUNT; f++) {
+            state.accumulators[w][f].add(sequence, t, sample.values[f]);
+        }
+    }
+    
+    expire(state, timestamp);
+    return true;
+}
+
+bool SlidingWindowStats::getStats(int patientID, std::vector<WindowStats>& stats, long now) {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    auto it = patients.find(patientID);
+    if (it == patients.end() || it->second.samples.empty()) return false;
+    
+    PatientWindows& state = it->second;
+    if (now < 0) now = state.samples.back().timestamp;
+    expire(state, now);
+    
+    stats.clear();
+    for (int w = 0; w < SLIDING_WINDOW_COUNT; w++) {
+        WindowStats window;
+        window.windowSeconds = SLIDING_WINDOW_SECONDS[w];
+        window.count = state.nextSequence - state.windowStart[w];
+        for (int f = 0; f < WINDOW_FIELD_COUNT; f++) {
+            window.fields[f] = state.accumulators[w][f].getStats();
+        }
+        stats.push_back(window);
+    }
+    return true;
+}
+
+int SlidingWindowStats::getPatientCount() const {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    return patients.size();
+}
+
+int SlidingWindowStats::getRetainedCount(int patientID) const {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    auto it = patients.find(patientID);
+    return it == patients.end() ? 0 : it->second.samples.size();
+}
+
+void SlidingWindowStats::clear() {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    patients.clear();
+}
@@ -0,0 +1,112 @@
+#ifndef SLIDING_WINDOW_STATS_H
+#define SLIDING_WINDOW_STATS_H
+
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+#include "../models/vital_record.h"
+
+// Trailing windows tracked for every patient, in seconds
+const int SLIDING_WINDOW_COUNT = 3;
+const long SLIDING_WINDOW_SECONDS[SLIDING_WINDOW_COUNT] = {300, 900, 3600};
+
+// Vitals tracked (FIELD_HEART_RATE .. FIELD_TEMPERATURE)
+const int WINDOW_FIELD_COUNT = 5;
+const VitalField WINDOW_FIELDS[WINDOW_FIELD_COUNT] = {
+    FIELD_HEART_RATE, FIELD_SYSTOLIC_BP, FIELD_DIASTOLIC_BP, FIELD_SPO2, FIELD_TEMPERATURE
+};
+
+// Statistics of one vital over one window
+struct WindowFieldStats {
+    double mean;
+    double variance;        // Sample variance (n - 1)
+    double min;
+    double max;
+    double slopePerMinute;  // Least-squares trend
+    
+    WindowFieldStats() : mean(0), variance(0), min(0), max(0), slopePerMinute(0) {}
+};
+
+struct WindowStats {
+    long windowSeconds;
+    int count;
+    WindowFieldStats fields[WINDOW_FIELD_COUNT];
+    
+    WindowStats() : windowSeconds(0), count(0) {}
+};
+
+// Running accumulator for one vital in one window. Every operation is
+// O(1) amortized: mean/variance use Welford's update and its inverse,
+// the trend keeps regression sums, and min/max come from monotonic deques.
+class WindowAccumulator {
+private:
+    int count;
+    double mean;
+    double m2;
+    double sumT;
+    double sumTT;
+    double sumTX;
+    double sumX;
+    std::deque<std::pair<long, double>> minDeque;   // (sequence, value), increasing
+    std::deque<std::pair<long, double>> maxDeque;   // (sequence, value), decreasing
+
+public:
+    WindowAccumulator();
+    
+    void add(long sequence, double t, double x);
+    void remove(long sequence, double t, double x);
+    void reset();
+    
+    WindowFieldStats getStats() const;
+};
+
+// Per-patient trailing-window statistics fed one reading at a time.
+// Readings must arrive in timestamp order per patient; older ones are
+// ignored. Only the readings inside the longest window are retained.
+class SlidingWindowStats {
+private:
+    struct Sample {
+        long timestamp;
+        double values[WINDOW_FIELD_COUNT];
+    };
+    
+    struct PatientWindows {
+        std::deque<Sample> samples;     // Readings inside the longest window
+        long firstSequence;             // Sequence number of samples.front()
+        long nextSequence;
+        long referenceTime;             // Origin for trend regression
+        long windowStart[SLIDING_WINDOW_COUNT];     // First sequence in each window
+        WindowAccumulator accumulators[SLIDING_WINDOW_COUNT][WINDOW_FIELD_COUNT];
+        
+        PatientWindows();
+        const Sample& at(long sequence) const { return samples[sequence - firstSequence]; }
+    };
+    
+    std::unordered_map<int, PatientWindows> patients;
+    mutable std::mutex statsMutex;
+    
+    static void expire(PatientWindows& state, long now);
+    static bool append(PatientWindows& state, long timestamp, const double* values);
+
+public:
+    // Add a reading; returns false if it is older than the patient's latest
+    bool add(const VitalRecord& record);
+    
+    // Seed a patient's windows from stored history (oldest first) in one
+    // step under the lock. Only readings older than the earliest one held
+    // are taken, so concurrent seeds never count a reading twice and a
+    // reading ingested first does not shut the history out. Returns the
+    // number of readings seeded.
+    int seedIfEmpty(int patientID, const std::vector<VitalRecord>& history);
+    
+    // Stats for every window ending at `now` (the latest reading if now < 0).
+    // Returns false if the patient has no readings.
+    bool getStats(int patientID, std::vector<WindowStats>& stats, long now = -1);
+    
+    int getPatientCount() const;
+    int getRetainedCount(int patientID) const;
+    void clear();
+};
+
+#endif
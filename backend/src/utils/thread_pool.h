@@ -0,0 +1,93 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+
+// Fixed set of worker threads draining a shared task queue. submit()
+// returns a future for the task's result; the destructor finishes queued
+// tasks before joining.
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex queueMutex;
+    std::condition_variable taskAvailable;
+    bool stopping;
+    
+    void workerLoop();
+
+public:
+    // threadCount <= 0 uses one thread per hardware core
+    explicit ThreadPool(int threadCount = 0);
+    ~ThreadPool();
+    
+    template<typename F>
+    std::future<typename std::result_of<F()>::type> submit(F task);
+    
+    int getThreadCount() const { return workers.size(); }
+
+private:
+    ThreadPool(const ThreadPool&);
+    ThreadPool& operator=(const ThreadPool&);
+};
+
+// ==================== IMPLEMENTATION ====================
+
+inline ThreadPool::ThreadPool(int threadCount) : stopping(false) {
+    if (threadCount <= 0) {
+        threadCount = std::thread::hardware_concurrency();
+        if (threadCount <= 0) threadCount = 4;
+    }
+    for (int i = 0; i < threadCount; i++) {
+        workers.push_back(std::thread(&ThreadPool::workerLoop, this));
+    }
+}
+
+inline ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    taskAvailable.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+inline void ThreadPool::workerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            taskAvailable.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (tasks.empty()) return;
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
+
+template<typename F>
+std::future<typename std::result_of<F()>::type> ThreadPool::submit(F task) {
+    typedef typename std::result_of<F()>::type Result;
+    
+    // packaged_task is move-only; share it so the queue can hold a copyable function
+    auto packaged = std::make_shared<std::packaged_task<Result()>>(task);
+    std::future<Result> result = packaged->get_future();
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        tasks.push([packaged] { (*packaged)(); });
+    }
+    taskAvailable.notify_one();
+    return result;
+}
+
+#endif
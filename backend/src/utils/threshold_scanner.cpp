@@ -0,0 +1,284 @@
+#include "threshold_scanner.h"
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// ==================== VitalThresholds ====================
+
+VitalThresholds::VitalThresholds()
+    : heartRateLow(50), heartRateHigh(120),
+      systolicLow(90), systolicHigh(180),
+      spo2Low(92),
+      temperatureLow(35.5f), temperatureHigh(38.5f) {}
+
+void VitalThresholds::writeToDisk(std::ofstream& file) const {
+    file.write(reinterpret_cast<const char*>(&heartRateLow), sizeof(heartRateLow));
+    file.write(reinterpret_cast<const char*>(&heartRateHigh), sizeof(heartRateHigh));
+    file.write(reinterpret_cast<const char*>(&systolicLow), sizeof(systolicLow));
+    file.write(reinterpret_cast<const char*>(&systolicHigh), sizeof(systolicHigh));
+    file.write(reinterpret_cast<const char*>(&spo2Low), sizeof(spo2Low));
+    file.write(reinterpret_cast<const char*>(&temperatureLow), sizeof(temperatureLow));
+    file.write(reinterpret_cast<const char*>(&temperatureHigh), sizeof(temperatureHigh));
+}
+
+void VitalThresholds::readFromDisk(std::ifstream& file) {
+    file.read(reinterpret_cast<char*>(&heartRateLow), sizeof(heartRateLow));
+    file.read(reinterpret_cast<char*>(&heartRateHigh), sizeof(heartRateHigh));
+    file.read(reinterpret_cast<char*>(&systolicLow), sizeof(systolicLow));
+    file.read(reinterpret_cast<char*>(&systolicHigh), sizeof(systolicHigh));
+    file.read(reinterpret_cast<char*>(&spo2Low), sizeof(spo2Low));
+    file.read(reinterpret_cast<char*>(&temperatureLow), sizeof(temperatureLow));
+    file.read(reinterpret_cast<char*>(&temperatureHigh), sizeof(temperatureHigh));
+}
+
+// ==================== ThresholdScanner ====================
+
+ThresholdScanner::ThresholdScanner(const std::string& filePath)
+    : dataFilePath(filePath) {
+    if (!dataFilePath.empty()) {
+        loadFromDisk();
+    }
+}
+
+ThresholdScanner::~ThresholdScanner() {
+    if (!dataFilePath.empty()) {
+        saveToDisk();
+    }
+}
+
+void ThresholdScanner::setDefaultThresholds(const VitalThresholds& thresholds) {
+    std::lock_guard<std::mutex> lock(configMutex);
+    defaults = thresholds;
+}
+
+void ThresholdScanner::setWardThresholds(const std::string& ward, const VitalThresholds& thresholds) {
+    std::lock_guard<std::mutex> lock(configMutex);
+    wardThresholds[ward] = thresholds;
+}
+
+void ThresholdScanner::setPatientThresholds(int patientID, const VitalThresholds& thresholds) {
+    std::lock_guard<std::mutex> lock(configMutex);
+    patientThresholds[patientID] = thresholds;
+}
+
+void ThresholdScanner::clearPatientThresholds(int patientID) {
+    std::lock_guard<std::mutex> lock(configMutex);
+    patientThresholds.erase(patientID);
+}
+
+VitalThresholds ThresholdScanner::resolve(int patientID, const std::string& ward) const {
+    std::lock_guard<std::mutex> lock(configMutex);
+    
+    auto patient = patientThresholds.find(patientID);
+    if (patient != patientThresholds.end()) return patient->second;
+    
+    auto wardEntry = wardThresholds.find(ward);
+    if (wardEntry != wardThresholds.end()) return wardEntry->second;
+    
+    return defaults;
+}
+
+uint8_t ThresholdScanner::checkReading(const VitalRecord& record, const VitalThresholds& t) {
+    uint8_t flags = 0;
+    if (record.heart_rate < t.heartRateLow)      flags |= FLAG_HR_LOW;
+    if (record.heart_rate > t.heartRateHigh)     flags |= FLAG_HR_HIGH;
+    if (record.systolic_bp < t.systolicLow)      flags |= FLAG_SBP_LOW;
+    if (record.systolic_bp > t.systolicHigh)     flags |= FLAG_SBP_HIGH;
+    if (record.spo2 < t.spo2Low)                 flags |= FLAG_SPO2_LOW;
+    if (record.temperature < t.temperatureLow)   flags |= FLAG_TEMP_LOW;
+    if (record.temperature > t.temperatureHigh)  flags |= FLAG_TEMP_HIGH;
+    return flags;
+}
+
+size_t ThresholdScanner::scanScalar(const VitalBatch& batch, const VitalThresholds& t, uint8_t* flags) {
+    size_t abnormal = 0;
+    for (size_t i = 0; i < batch.size(); i++) {
+        uint8_t f = 0;
+        f |= (batch.heart_rate[i] < t.heartRateLow) ? FLAG_HR_LOW : 0;
+        f |= (batch.heart_rate[i] > t.heartRateHigh) ? FLAG_HR_HIGH : 0;
+        f |= (batch.systolic_bp[i] < t.systolicLow) ? FLAG_SBP_LOW : 0;
+        f |= (batch.systolic_bp[i] > t.systolicHigh) ? FLAG_SBP_HIGH : 0;
+        f |= (batch.spo2[i] < t.spo2Low) ? FLAG_SPO2_LOW : 0;
+        f |= (batch.temperature[i] < t.temperatureLow) ? FLAG_TEMP_LOW : 0;
+        f |= (batch.temperature[i] > t.temperatureHigh) ? FLAG_TEMP_HIGH : 0;
+        flags[i] = f;
+        abnormal += (f != 0);
+    }
+    return abnormal;
+}
+
+bool ThresholdScanner::hasSIMD() {
+#if defined(__SSE2__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+size_t ThresholdScanner::scanSIMD(const VitalBatch& batch, const VitalThresholds& t, uint8_t* flags) {
+#if defined(__SSE2__)
+    const size_t n = batch.size();
+    const size_t vectorEnd = n & ~static_cast<size_t>(3);
+    size_t abnormal = 0;
+    
+    const __m128i hrLow = _mm_set1_epi32(t.heartRateLow);
+    const __m128i hrHigh = _mm_set1_epi32(t.heartRateHigh);
+    const __m128i sbpLow = _mm_set1_epi32(t.systolicLow);
+    const __m128i sbpHigh = _mm_set1_epi32(t.systolicHigh);
+    const __m128i spo2Low = _mm_set1_epi32(t.spo2Low);
+    const __m128 tempLow = _mm_set1_ps(t.temperatureLow);
+    const __m128 tempHigh = _mm_set1_ps(t.temperatureHigh);
+    const __m128i zero = _mm_setzero_si128();
+    
+    // Each comparison yields all-ones lanes; masking with the flag bit and
+    // OR-ing gives every lane its flag byte
+    #define FLAG_LANES(cmp, bit) _mm_and_si128((cmp), _mm_set1_epi32(bit))
+    
+    for (size_t i = 0; i < vectorEnd; i += 4) {
+        __m128i hr = _mm_loadu_si128(reinterpret_cast<const __m128i*>(batch.heart_rate.data() + i));
+        __m128i sbp = _mm_loadu_si128(reinterpret_cast<const __m128i*>(batch.systolic_bp.data() + i));
+        __m128i spo2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(batch.spo2.data() + i));
+        __m128 temp = _mm_loadu_ps(batch.temperature.data() + i);
+        
+        __m128i lanes = FLAG_LANES(_mm_cmplt_epi32(hr, hrLow), FLAG_HR_LOW);
+        lanes = _mm_or_si128(lanes, FLAG_LANES(_mm_cmpgt_epi32(hr, hrHigh), FLAG_HR_HIGH));
+        lanes = _mm_or_si128(lanes, FLAG_LANES(_mm_cmplt_epi32(sbp, sbpLow), FLAG_SBP_LOW));
+        lanes = _mm_or_si128(lanes, FLAG_LANES(_mm_cmpgt_epi32(sbp, sbpHigh), FLAG_SBP_HIGH));
+        lanes = _mm_or_si128(lanes, FLAG_LANES(_mm_cmplt_epi32(spo2, spo2Low), FLAG_SPO2_LOW));
+        lanes = _mm_or_si128(lanes, FLAG_LANES(_mm_castps_si128(_mm_cmplt_ps(temp, tempLow)), FLAG_TEMP_LOW));
+        lanes = _mm_or_si128(lanes, FLAG_LANES(_mm_castps_si128(_mm_cmpgt_ps(temp, tempHigh)), FLAG_TEMP_HIGH));
+        
+        // Narrow four 32-bit lanes to four bytes
+        __m128i packed = _mm_packus_epi16(_mm_packs_epi32(lanes, zero), zero);
+        int bytes = _mm_cvtsi128_si32(packed);
+        memcpy(flags + i, &bytes, 4);
+        
+        int normalMask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(lanes, zero)));
+        abnormal += 4 - __builtin_popcount(normalMask);
+    }
+    
+    #undef FLAG_LANES
+    
+    // Tail readings
+    for (size_t i = vectorEnd; i < n; i++) {
+        flags[i] = checkReading(batch.getRecord(i), t);
+        abnormal += (flags[i] != 0);
+    }
+    return abnormal;
+#else
+    return scanScalar(batch, t, flags);
+#endif
+}
+
+std::vector<AbnormalReading> ThresholdScanner::findAbnormal(const VitalBatch& batch,
+                                                            const VitalThresholds& thresholds) {
+    std::vector<uint8_t> flags(batch.size());
+    size_t count = scanSIMD(batch, thresholds, flags.data());
+    
+    std::vector<AbnormalReading> abnormal;
+    abnormal.reserve(count);
+    for (size_t i = 0; i < flags.size(); i++) {
+        if (flags[i]) {
+            AbnormalReading reading = {i, flags[i]};
+            abnormal.push_back(reading);
+        }
+    }
+    return abnormal;
+}
+
+std::string ThresholdScanner::describe(const VitalRecord& record, uint8_t flags) {
+    std::ostringstream text;
+    auto add = [&](const std::string& part) {
+        if (text.tellp() > 0) text << ", ";
+        text << part;
+    };
+    
+    if (flags & FLAG_HR_LOW)    add("HR low (" + std::to_string(record.heart_rate) + " bpm)");
+    if (flags & FLAG_HR_HIGH)   add("HR high (" + std::to_string(record.heart_rate) + " bpm)");
+    if (flags & FLAG_SBP_LOW)   add("SBP low (" + std::to_string(record.systolic_bp) + " mmHg)");
+    if (flags & FLAG_SBP_HIGH)  add("SBP high (" + std::to_string(record.systolic_bp) + " mmHg)");
+    if (flags & FLAG_SPO2_LOW)  add("SpO2 low (" + std::to_string(record.spo2) + "%)");
+    
+    std::ostringstream temp;
+    temp << std::fixed << std::setprecision(1) << record.temperature;
+    if (flags & FLAG_TEMP_LOW)  add("Temp low (" + temp.str() + "°C)");
+    if (flags & FLAG_TEMP_HIGH) add("Temp high (" + temp.str() + "°C)");
+    
+    return text.str();
+}
+
+// Hypoxia or several simultaneous abnormalities are critical
+AlertPriority ThresholdScanner::priorityFor(uint8_t flags) {
+    if ((flags & FLAG_SPO2_LOW) || __builtin_popcount(flags) >= 2) {
+        return CRITICAL;
+    }
+    return HIGH;
+}
+
+void ThresholdScanner::saveToDisk() {
+    if (dataFilePath.empty()) return;
+    
+    std::lock_guard<std::mutex> lock(configMutex);
+    std::ofstream file(dataFilePath, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "[THRESHOLDS] Error: Cannot open file for writing: " << dataFilePath << std::endl;
+        return;
+    }
+    
+    defaults.writeToDisk(file);
+    
+    int wardCount = wardThresholds.size();
+    file.write(reinterpret_cast<const char*>(&wardCount), sizeof(wardCount));
+    for (const auto& entry : wardThresholds) {
+        int length = entry.first.size();
+        file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+        file.write(entry.first.data(), length);
+        entry.second.writeToDisk(file);
+    }
+    
+    int patientCount = patientThresholds.size();
+    file.write(reinterpret_cast<const char*>(&patientCount), sizeof(patientCount));
+    for (const auto& entry : patientThresholds) {
+        file.write(reinterpret_cast<const char*>(&entry.first), sizeof(entry.first));
+        entry.second.writeToDisk(file);
+    }
+    
+    file.close();
+}
+
+void ThresholdScanner::loadFromDisk() {
+    if (dataFilePath.empty()) return;
+    
+    std::ifstream file(dataFilePath, std::ios::binary);
+    if (!file.is_open()) return;
+    
+    std::lock_guard<std::mutex> lock(configMutex);
+    defaults.readFromDisk(file);
+    
+    int wardCount = 0;
+    file.read(reinterpret_cast<char*>(&wardCount), sizeof(wardCount));
+    for (int i = 0; i < wardCount && file; i++) {
+        int length = 0;
+        file.read(reinterpret_cast<char*>(&length), sizeof(length));
+        std::string ward(length, '\0');
+        file.read(&ward[0], length);
+        wardThresholds[ward].readFromDisk(file);
+    }
+    
+    int patientCount = 0;
+    file.read(reinterpret_cast<char*>(&patientCount), sizeof(patientCount));
+    for (int i = 0; i < patientCount && file; i++) {
+        int patientID = 0;
+        file.read(reinterpret_cast<char*>(&patientID), sizeof(patientID));
+        patientThresholds[patientID].readFromDisk(file);
+    }
+    
+    file.close();
+    std::cout << "[THRESHOLDS] Loaded " << wardThresholds.size() << " ward and "
+              << patientThresholds.size() << " patient threshold sets" << std::endl;
+}
@@ -0,0 +1,84 @@
+#ifndef THRESHOLD_SCANNER_H
+#define THRESHOLD_SCANNER_H
+
+#include <vector>
+#include <string>
+#include <map>
+#include <mutex>
+#include <fstream>
+#include <cstdint>
+#include "../models/vital_record.h"
+#include "../models/vital_batch.h"
+#include "../models/alert.h"
+
+// Per-reading abnormality bits produced by the scanner
+const uint8_t FLAG_HR_LOW    = 1 << 0;
+const uint8_t FLAG_HR_HIGH   = 1 << 1;
+const uint8_t FLAG_SBP_LOW   = 1 << 2;
+const uint8_t FLAG_SBP_HIGH  = 1 << 3;
+const uint8_t FLAG_SPO2_LOW  = 1 << 4;
+const uint8_t FLAG_TEMP_LOW  = 1 << 5;
+const uint8_t FLAG_TEMP_HIGH = 1 << 6;
+
+// Normal ranges; a reading outside any bound is abnormal
+struct VitalThresholds {
+    int heartRateLow;
+    int heartRateHigh;
+    int systolicLow;
+    int systolicHigh;
+    int spo2Low;
+    float temperatureLow;
+    float temperatureHigh;
+    
+    VitalThresholds();  // Adult ICU defaults
+    
+    void writeToDisk(std::ofstream& file) const;
+    void readFromDisk(std::ifstream& file);
+};
+
+struct AbnormalReading {
+    size_t index;   // Position in the scanned batch
+    uint8_t flags;
+};
+
+// Threshold checks over VitalBatch columns. The batch kernel compares four
+// readings per instruction with SSE2 where available and falls back to a
+// scalar loop elsewhere. Thresholds resolve patient > ward > default.
+class ThresholdScanner {
+private:
+    VitalThresholds defaults;
+    std::map<std::string, VitalThresholds> wardThresholds;
+    std::map<int, VitalThresholds> patientThresholds;
+    std::string dataFilePath;
+    mutable std::mutex configMutex;
+
+public:
+    ThresholdScanner(const std::string& filePath = "");
+    ~ThresholdScanner();
+    
+    // Configuration
+    void setDefaultThresholds(const VitalThresholds& thresholds);
+    void setWardThresholds(const std::string& ward, const VitalThresholds& thresholds);
+    void setPatientThresholds(int patientID, const VitalThresholds& thresholds);
+    void clearPatientThresholds(int patientID);
+    VitalThresholds resolve(int patientID, const std::string& ward) const;
+    
+    // Kernels: fill flags[0..batch.size()) and return the abnormal count
+    static size_t scanScalar(const VitalBatch& batch, const VitalThresholds& thresholds, uint8_t* flags);
+    static size_t scanSIMD(const VitalBatch& batch, const VitalThresholds& thresholds, uint8_t* flags);
+    static bool hasSIMD();
+    
+    static uint8_t checkReading(const VitalRecord& record, const VitalThresholds& thresholds);
+    static std::vector<AbnormalReading> findAbnormal(const VitalBatch& batch,
+                                                     const VitalThresholds& thresholds);
+    
+    // Alert helpers
+    static std::string describe(const VitalRecord& record, uint8_t flags);
+    static AlertPriority priorityFor(uint8_t flags);
+    
+    // Disk persistence
+    void saveToDisk();
+    void loadFromDisk();
+};
+
+#endif
@@ -0,0 +1,56 @@
+#include "ward_aggregator.h"
+#include <future>
+
+BedSummary::BedSummary()
+    : patientID(0), readingCount(0), hasLatest(false),
+      abnormalCount(0), abnormalFlags(0), latestFlags(0) {}
+
+WardAggregator::WardAggregator(VitalStorageEngine& engine, const ThresholdScanner& scanner, int threadCount)
+    : engine(engine), scanner(scanner), pool(threadCount) {}
+
+BedSummary WardAggregator::summarizeBed(int patientID, const std::string& ward,
+                                        long startTime, long endTime) const {
+    BedSummary summary;
+    summary.patientID = patientID;
+    
+    VitalBatch batch;
+    engine.patientRangeQueryBatch(patientID, startTime, endTime, batch);
+    summary.readingCount = batch.size();
+    if (batch.empty()) return summary;
+    
+    for (int f = 0; f < BED_SUMMARY_FIELDS; f++) {
+        summary.vitals[f] = batch.summarize(static_cast<VitalField>(FIELD_HEART_RATE + f));
+    }
+    
+    std::vector<uint8_t> flags(batch.size());
+    VitalThresholds thresholds = scanner.resolve(patientID, ward);
+    summary.abnormalCount = ThresholdScanner::scanSIMD(batch, thresholds, flags.data());
+    for (uint8_t f : flags) {
+        summary.abnormalFlags |= f;
+    }
+    
+    // Batches come back in timestamp order
+    summary.hasLatest = true;
+    summary.latest = batch.getRecord(batch.size() - 1);
+    summary.latestFlags = flags.back();
+    return summary;
+}
+
+std::vector<BedSummary> WardAggregator::summarizeWard(const std::string& ward, const std::vector<int>& patientIDs,
+                                                      long startTime, long endTime) {
+    std::vector<std::future<BedSummary>> pending;
+    pending.reserve(patientIDs.size());
+    
+    for (int patientID : patientIDs) {
+        pending.push_back(pool.submit([this, patientID, ward, startTime, endTime] {
+            return summarizeBed(patientID, ward, startTime, endTime);
+        }));
+    }
+    
+    std::vector<BedSummary> beds;
+    beds.reserve(pending.size());
+    for (auto& result : pending) {
+        beds.push_back(result.get());
+    }
+    return beds;
+}
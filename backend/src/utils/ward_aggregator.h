@@ -0,0 +1,55 @@
+#ifndef WARD_AGGREGATOR_H
+#define WARD_AGGREGATOR_H
+
+#include <vector>
+#include <string>
+#include "../models/vital_record.h"
+#include "../models/vital_batch.h"
+#include "../data_structures/storage_engine.h"
+#include "threshold_scanner.h"
+#include "thread_pool.h"
+
+// Vitals summarized per bed (FIELD_HEART_RATE .. FIELD_TEMPERATURE)
+const int BED_SUMMARY_FIELDS = 5;
+
+// One bed's state over the aggregation window
+struct BedSummary {
+    int patientID;
+    int readingCount;
+    bool hasLatest;
+    VitalRecord latest;
+    VitalColumnStats vitals[BED_SUMMARY_FIELDS];   // Indexed from FIELD_HEART_RATE
+    int abnormalCount;
+    uint8_t abnormalFlags;          // Union of flags over the window
+    uint8_t latestFlags;
+    
+    BedSummary();
+    
+    const VitalColumnStats& getStats(VitalField field) const {
+        return vitals[field - FIELD_HEART_RATE];
+    }
+};
+
+// Builds ward overviews by running one per-patient batch query on each
+// pool thread and reducing the results into per-bed summaries. Callers
+// must keep writers out of the storage engine for the duration.
+class WardAggregator {
+private:
+    VitalStorageEngine& engine;
+    const ThresholdScanner& scanner;
+    ThreadPool pool;
+
+public:
+    WardAggregator(VitalStorageEngine& engine, const ThresholdScanner& scanner, int threadCount = 0);
+    
+    // Summarize one bed (runs on the calling thread)
+    BedSummary summarizeBed(int patientID, const std::string& ward, long startTime, long endTime) const;
+    
+    // Summaries for every patient, in the order given
+    std::vector<BedSummary> summarizeWard(const std::string& ward, const std::vector<int>& patientIDs,
+                                          long startTime, long endTime);
+    
+    int getThreadCount() const { return pool.getThreadCount(); }
+};
+
+#endif
@@ -0,0 +1,130 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+#include <string>
+#include "priority_queue.h"
+
+using namespace std;
+
+// Times alert queue churn on the slab-backed bucket queue against the
+// previous binary heap of Alert objects.
+// Usage: ./bench_priority_queue [alerts]
+
+// The binary heap PriorityQueue used before the bucket queue: whole
+// Alerts are swapped on every sift step and heapifyDown recurses
+class AlertHeap {
+private:
+    vector<Alert> heap;
+    
+    void heapifyUp(int index) {
+        while (index > 0 && heap[(index - 1) / 2] > heap[index]) {
+            swap(heap[index], heap[(index - 1) / 2]);
+            index = (index - 1) / 2;
+        }
+    }
+    
+    void heapifyDown(int index) {
+        int minIndex = index;
+        int left = 2 * index + 1;
+        int right = 2 * index + 2;
+        if (left < static_cast<int>(heap.size()) && heap[left] < heap[minIndex]) minIndex = left;
+        if (right < static_cast<int>(heap.size()) && heap[right] < heap[minIndex]) minIndex = right;
+        if (minIndex != index) {
+            Alert temp = heap[index];
+            heap[index] = heap[minIndex];
+            heap[minIndex] = temp;
+            heapifyDown(minIndex);
+        }
+    }
+
+public:
+    void insert(const Alert& alert) {
+        heap.push_back(alert);
+        heapifyUp(heap.size() - 1);
+    }
+    
+    Alert extractMin() {
+        Alert minAlert = heap[0];
+        heap[0] = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) heapifyDown(0);
+        return minAlert;
+    }
+    
+    bool isEmpty() const { return heap.empty(); }
+};
+
+// Storm of inserts, then steady churn (one in, one out), then drain.
+// Returns a checksum of the extraction order so both queues can be compared.
+template <typename Queue>
+double runWorkload(Queue& queue, const vector<Alert>& alerts, long& orderSum) {
+    size_t half = alerts.size() / 2;
+    orderSum = 0;
+    long position = 0;
+    
+    auto start = chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < half; i++) {
+        queue.insert(alerts[i]);
+    }
+    for (size_t i = half; i < alerts.size(); i++) {
+        queue.insert(alerts[i]);
+        Alert next = queue.extractMin();
+        orderSum += ++position * (next.priority * 31 + next.timestamp % 1000);
+    }
+    while (!queue.isEmpty()) {
+        Alert next = queue.extractMin();
+        orderSum += ++position * (next.priority * 31 + next.timestamp % 1000);
+    }
+    auto end = chrono::high_resolution_clock::now();
+    return chrono::duration<double>(end - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    int alertCount = argc > 1 ? atoi(argv[1]) : 100000;
+    
+    cout << "╔══════════════════════════════════════════════════════╗" << endl;
+    cout << "║   ALERT QUEUE BENCHMARK: Bucket Queue vs Heap       ║" << endl;
+    cout << "╚══════════════════════════════════════════════════════╝" << endl;
+    cout << "\nAlerts: " << alertCount << "  Handle size: " << sizeof(AlertHandle) << " bytes" << endl;
+    
+    // Monitor-style arrivals: increasing timestamps, mixed priorities
+    const long baseTime = 1733270400;
+    srand(42);
+    vector<Alert> alerts;
+    alerts.reserve(alertCount);
+    for (int i = 0; i < alertCount; i++) {
+        int roll = rand() % 100;
+        AlertPriority priority = roll < 5 ? CRITICAL : roll < 20 ? HIGH : roll < 50 ? MEDIUM : roll < 80 ? LOW : INFO;
+        Alert alert(i + 1, 100 + i % 40, priority, VITAL_ABNORMAL,
+                    "Patient " + to_string(100 + i % 40) + ": heart rate out of range");
+        alert.timestamp = baseTime + i / 4;
+        alerts.push_back(alert);
+    }
+    
+    long heapSum = 0;
+    AlertHeap heap;
+    double heapSeconds = runWorkload(heap, alerts, heapSum);
+    
+    // PriorityQueue logs every operation; keep that out of the timing
+    long bucketSum = 0;
+    PriorityQueue queue;
+    cout.setstate(ios::failbit);
+    double bucketSeconds = runWorkload(queue, alerts, bucketSum);
+    cout.clear();
+    
+    double operations = 2.0 * alertCount;
+    cout << fixed << setprecision(3);
+    cout << "\n" << left << setw(16) << "Queue" << setw(12) << "Time (s)" << "Ops/sec" << endl;
+    cout << setw(16) << "binary heap" << setw(12) << heapSeconds
+         << setprecision(0) << operations / heapSeconds << endl;
+    cout << setprecision(3) << setw(16) << "bucket + slab" << setw(12) << bucketSeconds
+         << setprecision(0) << operations / bucketSeconds << endl;
+    
+    cout << setprecision(1);
+    cout << "\nSpeedup (heap / bucket): " << heapSeconds / bucketSeconds << "x" << endl;
+    cout << "Extraction order " << (heapSum == bucketSum ? "matches" : "DIFFERS") << endl;
+    
+    return heapSum == bucketSum ? 0 : 1;
+}
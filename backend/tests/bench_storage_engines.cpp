@@ -0,0 +1,96 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "storage_engine.h"
+#include "lsm_tree.h"
+
+using namespace std;
+
+// Compares sustained ingest and range-scan cost of the two vitals
+// storage engines on the same disk.
+// Usage: ./bench_storage [records]
+
+void cleanupFiles(const string& basePath) {
+    const char* suffixes[] = {"_index.dat", "_data.dat", "_meta.dat", "_hot.dat", "_zones.dat", "_pidx.dat",
+                              "_lsm_manifest.dat", "_lsm_wal.dat"};
+    for (const char* suffix : suffixes) {
+        remove((basePath + suffix).c_str());
+    }
+    for (int id = 1; id < 1000; id++) {
+        remove((basePath + "_lsm_run_" + to_string(id) + ".dat").c_str());
+    }
+}
+
+struct BenchResult {
+    double insertSeconds;
+    double scanSeconds;
+    size_t scanned;
+};
+
+BenchResult runBenchmark(const string& engineName, int recordCount) {
+    string basePath = "bench_" + engineName;
+    cleanupFiles(basePath);
+    
+    const long baseTime = 1733270400;
+    BenchResult result;
+    
+    VitalStorageEngine* engine = createStorageEngine(engineName, basePath);
+    
+    // Engines log to stdout; keep it out of the timings
+    cout.setstate(ios::failbit);
+    auto start = chrono::high_resolution_clock::now();
+    for (int i = 0; i < recordCount; i++) {
+        VitalRecord r(100 + i % 40, baseTime + i, 60 + i % 60, 110 + i % 30, 70, 92 + i % 8, 36.5);
+        engine->insert(r.timestamp, r);
+    }
+    if (LSMTree* lsm = dynamic_cast<LSMTree*>(engine)) {
+        lsm->flush();
+        lsm->waitForCompaction();
+    }
+    auto end = chrono::high_resolution_clock::now();
+    result.insertSeconds = chrono::duration<double>(end - start).count();
+    
+    start = chrono::high_resolution_clock::now();
+    auto records = engine->rangeQuery(baseTime, baseTime + recordCount);
+    end = chrono::high_resolution_clock::now();
+    result.scanSeconds = chrono::duration<double>(end - start).count();
+    result.scanned = records.size();
+    
+    delete engine;
+    cout.clear();
+    
+    cleanupFiles(basePath);
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    int recordCount = argc > 1 ? atoi(argv[1]) : 2000;
+    
+    cout << "╔══════════════════════════════════════════════════════╗" << endl;
+    cout << "║   STORAGE ENGINE BENCHMARK: DiskBTree vs LSMTree    ║" << endl;
+    cout << "╚══════════════════════════════════════════════════════╝" << endl;
+    cout << "\nRecords: " << recordCount << endl;
+    
+    BenchResult btree = runBenchmark("btree", recordCount);
+    BenchResult lsm = runBenchmark("lsm", recordCount);
+    
+    cout << fixed << setprecision(3);
+    cout << "\n" << left << setw(10) << "Engine" << setw(14) << "Insert (s)"
+         << setw(16) << "Inserts/sec" << setw(12) << "Scan (s)" << "Scanned" << endl;
+    cout << setw(10) << "btree" << setw(14) << btree.insertSeconds
+         << setw(16) << setprecision(0) << recordCount / btree.insertSeconds
+         << setprecision(3) << setw(12) << btree.scanSeconds << btree.scanned << endl;
+    cout << setw(10) << "lsm" << setw(14) << lsm.insertSeconds
+         << setw(16) << setprecision(0) << recordCount / lsm.insertSeconds
+         << setprecision(3) << setw(12) << lsm.scanSeconds << lsm.scanned << endl;
+    
+    cout << setprecision(1);
+    cout << "\nIngest speedup (lsm / btree): " << btree.insertSeconds / lsm.insertSeconds << "x" << endl;
+    cout << "Scan speedup   (lsm / btree): " << btree.scanSeconds / lsm.scanSeconds << "x" << endl;
+    
+    return 0;
+}
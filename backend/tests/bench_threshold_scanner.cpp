@@ -0,0 +1,65 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+#include "threshold_scanner.h"
+
+using namespace std;
+
+// Times the scalar and SIMD threshold kernels over the same batch.
+// Usage: ./bench_threshold [readings] [passes]
+
+int main(int argc, char* argv[]) {
+    int readingCount = argc > 1 ? atoi(argv[1]) : 1000000;
+    int passes = argc > 2 ? atoi(argv[2]) : 20;
+    
+    cout << "╔══════════════════════════════════════════════════════╗" << endl;
+    cout << "║   THRESHOLD SCAN BENCHMARK: SIMD vs Scalar          ║" << endl;
+    cout << "╚══════════════════════════════════════════════════════╝" << endl;
+    cout << "\nReadings: " << readingCount << "  Passes: " << passes
+         << "  SIMD: " << (ThresholdScanner::hasSIMD() ? "SSE2" : "unavailable") << endl;
+    
+    const long baseTime = 1733270400;
+    VitalBatch batch;
+    batch.reserve(readingCount);
+    srand(42);
+    for (int i = 0; i < readingCount; i++) {
+        VitalRecord r(100 + i % 40, baseTime + i, 45 + rand() % 90, 85 + rand() % 100,
+                      70, 86 + rand() % 14, 35.0f + (rand() % 45) * 0.1f);
+        batch.append(r);
+    }
+    
+    VitalThresholds thresholds;
+    vector<uint8_t> flags(batch.size());
+    
+    size_t scalarCount = 0;
+    auto start = chrono::high_resolution_clock::now();
+    for (int p = 0; p < passes; p++) {
+        scalarCount = ThresholdScanner::scanScalar(batch, thresholds, flags.data());
+    }
+    auto end = chrono::high_resolution_clock::now();
+    double scalarSeconds = chrono::duration<double>(end - start).count();
+    
+    size_t simdCount = 0;
+    start = chrono::high_resolution_clock::now();
+    for (int p = 0; p < passes; p++) {
+        simdCount = ThresholdScanner::scanSIMD(batch, thresholds, flags.data());
+    }
+    end = chrono::high_resolution_clock::now();
+    double simdSeconds = chrono::duration<double>(end - start).count();
+    
+    double total = static_cast<double>(readingCount) * passes;
+    cout << fixed << setprecision(3);
+    cout << "\n" << left << setw(10) << "Kernel" << setw(12) << "Time (s)"
+         << setw(18) << "Readings/sec" << "Abnormal" << endl;
+    cout << setw(10) << "scalar" << setw(12) << scalarSeconds
+         << setw(18) << setprecision(0) << total / scalarSeconds << scalarCount << endl;
+    cout << setprecision(3) << setw(10) << "simd" << setw(12) << simdSeconds
+         << setw(18) << setprecision(0) << total / simdSeconds << simdCount << endl;
+    
+    cout << setprecision(1);
+    cout << "\nSpeedup (simd / scalar): " << scalarSeconds / simdSeconds << "x" << endl;
+    
+    return scalarCount == simdCount ? 0 : 1;
+}
@@ -0,0 +1,300 @@
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include "alert_intake.h"
+
+using namespace std;
+
+// ==================== TEST 1: Manual Drain ====================
+void test1_ManualDrain() {
+    cout << "\n========== TEST 1: Manual Drain ==========" << endl;
+    
+    PriorityQueue pq;
+    AlertIntake intake(pq, false);
+    
+    intake.submit(Alert(1, 101, LOW, MEDICATION_DUE, "Medication due"));
+    intake.submit(Alert(2, 102, CRITICAL, VITAL_ABNORMAL, "SpO2 84%"));
+    intake.submit(Alert(3, 103, HIGH, DRUG_INTERACTION, "Warfarin + Aspirin"));
+    assert(intake.getPendingCount() == 3 && pq.size() == 0);
+    cout << "✓ Submitted alerts wait in the intake" << endl;
+    
+    assert(intake.drain() == 3);
+    assert(intake.getPendingCount() == 0 && pq.size() == 3);
+    assert(pq.peekMin().alertID == 2);
+    assert(intake.drain() == 0);
+    cout << "✓ drain() moves them into the queue in one batch" << endl;
+    
+    cout << "\n✅ Test 1 Passed!" << endl;
+}
+
+// ==================== TEST 2: Linearizable Peek ====================
+void test2_LinearizablePeek() {
+    cout << "\n========== TEST 2: Linearizable Peek ==========" << endl;
+    
+    PriorityQueue pq;
+    AlertIntake intake(pq, false);
+    
+    Alert top;
+    assert(!intake.peekMin(top));
+    cout << "✓ Empty intake and queue peek nothing" << endl;
+    
+    intake.submit(Alert(1, 101, MEDIUM, CUSTOM, "Routine"));
+    assert(intake.peekMin(top) && top.alertID == 1);
+    
+    // A submit that has returned is visible to the very next peek
+    intake.submit(Alert(2, 102, CRITICAL, VITAL_ABNORMAL, "Asystole"));
+    assert(intake.peekMin(top) && top.alertID == 2);
+    assert(intake.settled().size() == 2);
+    cout << "✓ Peek sees every completed submit without waiting for the drainer" << endl;
+    
+    cout << "\n✅ Test 2 Passed!" << endl;
+}
+
+// ==================== TEST 3: 32 Concurrent Producers ====================
+void test3_ConcurrentProducers() {
+    cout << "\n========== TEST 3: 32 Concurrent Producers ==========" << endl;
+    
+    const int THREADS = 32;
+    const int PER_THREAD = 2000;
+    
+    PriorityQueue pq;
+    vector<vector<long>> latencies(THREADS);
+    
+    // The queue logs each batch from the drain thread
+    cout.setstate(ios::failbit);
+    {
+        AlertIntake intake(pq);
+        vector<thread> producers;
+        for (int t = 0; t < THREADS; t++) {
+            producers.push_back(thread([&intake, &latencies, t] {
+                latencies[t].reserve(PER_THREAD);
+                for (int i = 0; i < PER_THREAD; i++) {
+                    Alert alert(t * PER_THREAD + i + 1, 100 + t, static_cast<AlertPriority>(i % 5 + 1),
+                                VITAL_ABNORMAL, "Concurrent alert");
+                    auto start = chrono::steady_clock::now();
+                    intake.submit(alert);
+                    auto end = chrono::steady_clock::now();
+                    latencies[t].push_back(chrono::duration_cast<chrono::nanoseconds>(end - start).count());
+                }
+            }));
+        }
+        for (auto& producer : producers) producer.join();
+        
+        Alert top;
+        assert(intake.peekMin(top) && top.priority == CRITICAL);
+        assert(intake.getPendingCount() == 0);
+    }
+    cout.clear();
+    
+    assert(pq.size() == THREADS * PER_THREAD);
+    for (int id = 1; id <= THREADS * PER_THREAD; id += 997) {
+        assert(pq.contains(id));
+    }
+    cout << "✓ " << THREADS * PER_THREAD << " alerts from " << THREADS << " threads, none lost" << endl;
+    
+    vector<long> all;
+    for (const auto& perThread : latencies) {
+        all.insert(all.end(), perThread.begin(), perThread.end());
+    }
+    sort(all.begin(), all.end());
+    cout << "✓ Submit latency p50 " << all[all.size() / 2] << " ns, p99 "
+         << all[all.size() * 99 / 100] << " ns" << endl;
+    
+    // Drained batches keep priority order
+    auto snapshot = pq.getSortedSnapshot();
+    for (size_t i = 1; i < snapshot->size(); i++) {
+        assert(!((*snapshot)[i] < (*snapshot)[i - 1]));
+    }
+    cout << "✓ Queue ordered after concurrent intake" << endl;
+    
+    cout << "\n✅ Test 3 Passed!" << endl;
+}
+
+// ==================== TEST 4: Background Drainer ====================
+void test4_BackgroundDrain() {
+    cout << "\n========== TEST 4: Background Drainer ==========" << endl;
+    
+    PriorityQueue pq;
+    cout.setstate(ios::failbit);
+    {
+        AlertIntake intake(pq);
+        for (int i = 1; i <= 100; i++) {
+            intake.submit(Alert(i, 200, HIGH, DETERIORATION, "Deteriorating"));
+        }
+        
+        // No reader forces a drain; the worker picks them up on its own
+        for (int wait = 0; wait < 200 && pq.size() < 100; wait++) {
+            this_thread::sleep_for(chrono::milliseconds(5));
+        }
+        cout.clear();
+        assert(pq.size() == 100);
+        cout << "✓ Drain thread delivers alerts without a reader" << endl;
+        
+        cout.setstate(ios::failbit);
+        intake.submit(Alert(101, 200, CRITICAL, DETERIORATION, "Last alert"));
+    }
+    cout.clear();
+    assert(pq.size() == 101 && pq.peekMin().alertID == 101);
+    cout << "✓ Shutdown drains what is still pending" << endl;
+    
+    cout << "\n✅ Test 4 Passed!" << endl;
+}
+
+// Performs submit() in two halves, as a producer preempted between its
+// tail exchange and its link would
+struct AlertIntakeTestAccess {
+    typedef AlertIntake::Node Node;
+    typedef pair<Node*, Node*> Claim;
+    
+    static Claim claim(AlertIntake& intake, const Alert& alert) {
+        Node* node = new Node();
+        node->alert = alert;
+        Node* previous = intake.tail.exchange(node, memory_order_acq_rel);
+        intake.pending.fetch_add(1, memory_order_relaxed);
+        return Claim(previous, node);
+    }
+    
+    static void link(const Claim& claimed) {
+        claimed.first->next.store(claimed.second, memory_order_release);
+    }
+};
+
+// ==================== TEST 5: Read-Your-Writes ====================
+void test5_ReadYourWrites() {
+    cout << "\n========== TEST 5: Read-Your-Writes ==========" << endl;
+    
+    // Each producer acknowledges its alert right after submitting it,
+    // while others are mid-submit. A drain that stopped at a producer
+    // still linking its node would hide later, completed submits.
+    const int THREADS = 32;
+    const int PER_THREAD = 500;
+    
+    PriorityQueue pq;
+    atomic<int> missedAcks(0), missedPeeks(0);
+    
+    cout.setstate(ios::failbit);
+    {
+        AlertIntake intake(pq, false);
+        vector<thread> producers;
+        for (int t = 0; t < THREADS; t++) {
+            producers.push_back(thread([&, t] {
+                for (int i = 0; i < PER_THREAD; i++) {
+                    int alertID = t * PER_THREAD + i + 1;
+                    intake.submit(Alert(alertID, 100 + t, LOW, VITAL_ABNORMAL, "Ack me"));
+                    if (!intake.settled().acknowledge(alertID, "Nurse Joy", 1733270400)) {
+                        missedAcks++;
+                    }
+                    
+                    // A CRITICAL alert submitted by this thread must be
+                    // visible to its very next peek
+                    if (i % 50 == 0) {
+                        Alert critical(1000000 + alertID, 100 + t, CRITICAL, VITAL_ABNORMAL, "Peek me");
+                        critical.timestamp = 0;
+                        intake.submit(critical);
+                        Alert top;
+                        if (!intake.peekMin(top) || top.priority != CRITICAL) missedPeeks++;
+                    }
+                }
+            }));
+        }
+        for (auto& producer : producers) producer.join();
+        assert(intake.getPendingCount() == 0);
+    }
+    cout.clear();
+    
+    assert(missedAcks.load() == 0);
+    assert(missedPeeks.load() == 0);
+    assert(pq.getUnacknowledgedAlerts().size() == static_cast<size_t>(THREADS * (PER_THREAD / 50)));
+    cout << "✓ " << THREADS * PER_THREAD << " acks right after submit from " << THREADS
+         << " threads, none missed" << endl;
+    cout << "✓ Every peek saw its own thread's CRITICAL alert" << endl;
+    
+    // Deterministic version of the race: A has swapped the tail but not
+    // linked, B then submits fully behind it. B's submit has returned, so
+    // reads must wait for A's link rather than stop in front of it.
+    PriorityQueue stalled;
+    cout.setstate(ios::failbit);
+    {
+        AlertIntake intake(stalled, false);
+        AlertIntakeTestAccess::Claim producerA =
+            AlertIntakeTestAccess::claim(intake, Alert(1, 301, MEDIUM, VITAL_ABNORMAL, "Producer A"));
+        intake.submit(Alert(2, 302, CRITICAL, VITAL_ABNORMAL, "Producer B"));
+        
+        thread resumeA([producerA] {
+            this_thread::sleep_for(chrono::milliseconds(20));
+            AlertIntakeTestAccess::link(producerA);
+        });
+        Alert top;
+        bool peeked = intake.peekMin(top);
+        bool acked = intake.settled().acknowledge(2, "Nurse Joy", 1733270400);
+        resumeA.join();
+        cout.clear();
+        
+        assert(peeked && top.alertID == 2);
+        assert(acked);
+        assert(stalled.size() == 2);
+        cout << "✓ A completed submit behind a stalled producer is never missed" << endl;
+        cout.setstate(ios::failbit);
+    }
+    cout.clear();
+    
+    // Producers that only know the ID they submitted: repeats coalesce
+    // behind the drainer, and each producer still finds and acks its alert
+    PriorityQueue coalescing;
+    coalescing.setCoalesceWindow(60);
+    cout.setstate(ios::failbit);
+    {
+        AlertIntake intake(coalescing);
+        const int REPEATERS = 8;
+        atomic<int> found(0);
+        vector<thread> repeaters;
+        for (int t = 0; t < REPEATERS; t++) {
+            repeaters.emplace_back([&intake, &found, t]() {
+                Alert repeat(10 + t, 401, HIGH, VITAL_ABNORMAL, "SpO2 88%");
+                repeat.timestamp = 1733270400 + t;
+                intake.submit(repeat);
+                
+                Alert stored;
+                if (intake.settled().getAlert(10 + t, stored) && stored.patientID == 401) found++;
+            });
+        }
+        for (auto& repeater : repeaters) repeater.join();
+        
+        assert(found.load() == REPEATERS);
+        assert(coalescing.size() == 1);
+        Alert merged = coalescing.peekMin();
+        assert(merged.occurrenceCount == REPEATERS);
+        int repeatID = merged.alertID == 10 ? 17 : 10;
+        assert(intake.settled().acknowledge(repeatID, "Nurse Joy", 1733270410));
+        assert(coalescing.peekMin().acknowledged);
+        cout.clear();
+        cout << "✓ Coalesced repeats are acked by the ID their producer submitted" << endl;
+        cout.setstate(ios::failbit);
+    }
+    cout.clear();
+    
+    cout << "\n✅ Test 5 Passed!" << endl;
+}
+
+int main() {
+    cout << "╔══════════════════════════════════════════════════════╗" << endl;
+    cout << "║   ALERT INTAKE (MPSC) TEST SUITE                    ║" << endl;
+    cout << "║   IntelliCare ICU - Alert Management                ║" << endl;
+    cout << "╚══════════════════════════════════════════════════════╝" << endl;
+    
+    test1_ManualDrain();
+    test2_LinearizablePeek();
+    test3_ConcurrentProducers();
+    test4_BackgroundDrain();
+    test5_ReadYourWrites();
+    
+    cout << "\n\n╔══════════════════════════════════════════════════════╗" << endl;
+    cout << "║    ALL TESTS PASSED SUCCESSFULLY!                 ║" << endl;
+    cout << "╚══════════════════════════════════════════════════════╝" << endl;
+    
+    return 0;
+}
@@ -3,6 +3,7 @@
 #include <cassert>
 #include <cstdio>
 #include <vector>
+#include <fstream>
 #include "btree.h"
 
 using namespace std;
@@ -18,6 +19,9 @@ void cleanupFiles(const string& basePath) {
     remove((basePath + "_index.dat").c_str());
     remove((basePath + "_data.dat").c_str());
     remove((basePath + "_meta.dat").c_str());
+    remove((basePath + "_hot.dat").c_str());
+    remove((basePath + "_zones.dat").c_str());
+    remove((basePath + "_pidx.dat").c_str());
 }
 
 // ==================== TEST 1: Basic Persistence ====================
@@ -367,6 +371,567 @@ void test7_EdgeCases() {
     cout << "\n✅ TEST 7 PASSED: Edge cases handled correctly!" << endl;
 }
 
+// ==================== TEST 8: Hot-Page Warm-Up ====================
+void test8_WarmUp() {
+    cout << "\n╔════════════════════════════════════════════════╗" << endl;
+    cout << "║  TEST 8: Hot-Page Warm-Up                     ║" << endl;
+    cout << "╚════════════════════════════════════════════════╝" << endl;
+    
+    string testPath = "test8_warmup";
+    cleanupFiles(testPath);
+    
+    {
+        DiskBTree tree(3, testPath);
+        assert(tree.isReady());
+        
+        for (int i = 0; i < 50; i++) {
+            VitalRecord r(101, createTimestamp(9, i), 70 + i % 10, 120, 80, 98, 37.0);
+            tree.insert(createTimestamp(9, i), r);
+        }
+        
+        // Touch the same window repeatedly so its pages become hot
+        for (int i = 0; i < 20; i++) {
+            auto results = tree.rangeQuery(createTimestamp(9, 40), createTimestamp(9, 49));
+            assert(results.size() == 10);
+        }
+        cout << "✓ Generated hot pages" << endl;
+        
+        // Crossing the record interval hands the save to the writer
+        // thread; the list appears while the tree is still open
+        for (int i = 0; i < 500; i++) {
+            tree.rangeQuery(createTimestamp(9, 40), createTimestamp(9, 49));
+        }
+        bool saved = false;
+        auto deadline = chrono::steady_clock::now() + chrono::seconds(5);
+        while (!saved && chrono::steady_clock::now() < deadline) {
+            saved = ifstream(testPath + "_hot.dat").good();
+            if (!saved) this_thread::sleep_for(chrono::milliseconds(5));
+        }
+        assert(saved);
+        cout << "✓ Hot-page list written in the background" << endl;
+    }
+    
+    ifstream hotFile(testPath + "_hot.dat", ios::binary);
+    assert(hotFile.good());
+    int hotCount = 0;
+    hotFile.read(reinterpret_cast<char*>(&hotCount), sizeof(hotCount));
+    hotFile.close();
+    assert(hotCount > 0);
+    cout << "✓ Hot-page list persisted (" << hotCount << " pages)" << endl;
+    
+    {
+        DiskBTree tree(3, testPath);
+        tree.waitUntilReady();
+        assert(tree.isReady());
+        
+        auto results = tree.rangeQuery(createTimestamp(9, 40), createTimestamp(9, 49));
+        assert(results.size() == 10);
+        cout << "✓ Tree ready after warm-up, queries unaffected" << endl;
+    }
+    
+    cout << "\n✅ TEST 8 PASSED: Warm-up from hot-page list works!" << endl;
+}
+
+// ==================== TEST 9: Range Scan Read-Ahead ====================
+void test9_RangePrefetch() {
+    cout << "\n╔════════════════════════════════════════════════╗" << endl;
+    cout << "║  TEST 9: Range Scan Read-Ahead                ║" << endl;
+    cout << "╚════════════════════════════════════════════════╝" << endl;
+    
+    string testPath = "test9_prefetch";
+    cleanupFiles(testPath);
+    
+    {
+        DiskBTree tree(3, testPath);
+        for (int i = 0; i < 200; i++) {
+            VitalRecord r(100 + i % 4, createTimestamp(8, 0, i * 10), 60 + i % 40, 120, 80, 97, 36.8);
+            tree.insert(createTimestamp(8, 0, i * 10), r);
+        }
+        
+        tree.setPrefetchDepth(0);
+        auto plain = tree.rangeQuery(createTimestamp(8, 5), createTimestamp(8, 25));
+        
+        tree.setPrefetchDepth(8);
+        assert(tree.getPrefetchDepth() == 8);
+        auto prefetched = tree.rangeQuery(createTimestamp(8, 5), createTimestamp(8, 25));
+        
+        assert(plain.size() == prefetched.size());
+        for (size_t i = 0; i < plain.size(); i++) {
+            assert(plain[i].timestamp == prefetched[i].timestamp);
+            assert(plain[i].patientID == prefetched[i].patientID);
+        }
+        cout << "✓ " << prefetched.size() << " records, identical with and without read-ahead" << endl;
+    }
+    
+    cout << "\n✅ TEST 9 PASSED: Read-ahead does not change scan results!" << endl;
+}
+
+// ==================== TEST 10: Zone-Map Predicate Scan ====================
+void test10_ZoneMapScan() {
+    cout << "\n╔════════════════════════════════════════════════╗" << endl;
+    cout << "║  TEST 10: Zone-Map Predicate Scan             ║" << endl;
+    cout << "╚════════════════════════════════════════════════╝" << endl;
+    
+    string testPath = "test10_zones";
+    cleanupFiles(testPath);
+    
+    // Six blocks of normal readings; only the fifth block has low SpO2
+    const int RECORD_COUNT = ZONE_CHUNK_RECORDS * 6;
+    {
+        DiskBTree tree(3, testPath);
+        for (int i = 0; i < RECORD_COUNT; i++) {
+            int spo2 = (i == ZONE_CHUNK_RECORDS * 4 + 10) ? 86 : 97;
+            VitalRecord r(100 + i % 8, createTimestamp(6, 0, i), 80, 120, 80, spo2, 37.0);
+            tree.insert(createTimestamp(6, 0, i), r);
+        }
+        
+        vector<VitalPredicate> predicates;
+        assert(VitalPredicate::parseList("spo2<90", predicates));
+        
+        ZoneScanStats stats;
+        auto results = tree.scanWhere(createTimestamp(0, 0), createTimestamp(23, 0), predicates, &stats);
+        assert(results.size() == 1);
+        assert(results[0].spo2 == 86);
+        assert(stats.blocksTotal == 6);
+        assert(stats.blocksScanned == 1);
+        cout << "✓ Found low SpO2 reading after scanning " << stats.blocksScanned
+             << "/" << stats.blocksTotal << " blocks" << endl;
+        
+        // Time window excludes the abnormal block entirely
+        results = tree.scanWhere(createTimestamp(6, 0), createTimestamp(6, 1), predicates, &stats);
+        assert(results.empty());
+        assert(stats.blocksScanned == 0);
+        cout << "✓ Time window prunes every block" << endl;
+    }
+    
+    // Zone maps are rebuilt if the summary file is lost
+    remove((testPath + "_zones.dat").c_str());
+    {
+        DiskBTree tree(3, testPath);
+        vector<VitalPredicate> predicates;
+        assert(VitalPredicate::parseList("spo2<90,patientID=102", predicates));
+        
+        ZoneScanStats stats;
+        auto results = tree.scanWhere(createTimestamp(0, 0), createTimestamp(23, 0), predicates, &stats);
+        assert(results.size() == 1);
+        assert(stats.blocksScanned == 1);
+        cout << "✓ Zone maps recomputed from the data file after loss" << endl;
+    }
+    
+    // 45 old 116-byte zones are exactly as long as 29 current ones; the
+    // missing header, not the size, identifies the layout
+    const size_t OLD_ZONE_BYTES = 116;
+    assert((45 * OLD_ZONE_BYTES) % VitalZone::getDiskSize() == 0);
+    {
+        ofstream old(testPath + "_zones.dat", ios::binary | ios::trunc);
+        vector<char> zeros(45 * OLD_ZONE_BYTES, 0);
+        old.write(zeros.data(), zeros.size());
+    }
+    {
+        DiskBTree tree(3, testPath);
+        assert(tree.getZoneMap().getBlockCount() == 6);
+        assert(tree.getZoneMap().getCoveredRecords() == RECORD_COUNT);
+        vector<VitalPredicate> predicates;
+        assert(VitalPredicate::parseList("spo2<90", predicates));
+        assert(tree.scanWhere(createTimestamp(0, 0), createTimestamp(23, 0), predicates).size() == 1);
+        cout << "✓ Headerless zone file of a coinciding size rebuilt" << endl;
+    }
+    
+    // A current-layout file that does not describe the data file (here
+    // eight empty zones) is rebuilt as well
+    {
+        ofstream stale(testPath + "_zones.dat", ios::binary | ios::trunc);
+        stale.write(reinterpret_cast<const char*>(&ZONE_FILE_MAGIC), sizeof(ZONE_FILE_MAGIC));
+        stale.write(reinterpret_cast<const char*>(&ZONE_FILE_VERSION), sizeof(ZONE_FILE_VERSION));
+        VitalZone empty;
+        for (int b = 0; b < 8; b++) empty.writeToDisk(stale);
+    }
+    {
+        DiskBTree tree(3, testPath);
+        assert(tree.getZoneMap().getBlockCount() == 6);
+        vector<VitalPredicate> predicates;
+        assert(VitalPredicate::parseList("spo2<90", predicates));
+        assert(tree.scanWhere(createTimestamp(0, 0), createTimestamp(23, 0), predicates).size() == 1);
+        cout << "✓ Zone file disagreeing with the record count rebuilt" << endl;
+    }
+    
+    VitalPredicate bad;
+    assert(!VitalPredicate::parse("spo2", bad));
+    assert(!VitalPredicate::parse("pulse<90", bad));
+    cout << "✓ Malformed conditions rejected" << endl;
+    
+    cout << "\n✅ TEST 10 PASSED: Zone maps skip non-matching blocks!" << endl;
+}
+
+// ==================== TEST 11: Predicate & Projection Pushdown ====================
+void test11_Pushdown() {
+    cout << "\n╔════════════════════════════════════════════════╗" << endl;
+    cout << "║  TEST 11: Predicate & Projection Pushdown     ║" << endl;
+    cout << "╚════════════════════════════════════════════════╝" << endl;
+    
+    string testPath = "test11_pushdown";
+    cleanupFiles(testPath);
+    
+    {
+        DiskBTree tree(3, testPath);
+        for (int i = 0; i < 60; i++) {
+            VitalRecord r(101 + i % 3, createTimestamp(7, i), 70 + i, 120, 80, 88 + i % 10, 36.5);
+            tree.insert(createTimestamp(7, i), r);
+        }
+        
+        VitalQuery query;
+        query.predicates.push_back(VitalPredicate(FIELD_PATIENT_ID, OP_EQUAL, 102));
+        assert(VitalPredicate::parseList("spo2<92", query.predicates));
+        assert(VitalQuery::parseFields("spo2", query.fieldMask));
+        
+        auto results = tree.rangeQuery(createTimestamp(7, 0), createTimestamp(8, 0), query);
+        auto all = tree.rangeQuery(createTimestamp(7, 0), createTimestamp(8, 0));
+        
+        size_t expected = 0;
+        for (const auto& r : all) {
+            if (r.patientID == 102 && r.spo2 < 92) expected++;
+        }
+        assert(results.size() == expected && expected > 0);
+        
+        for (const auto& r : results) {
+            assert(r.patientID == 102);
+            assert(r.spo2 < 92);
+            assert(r.timestamp != 0);
+            assert(r.heart_rate == 0);  // not projected
+        }
+        cout << "✓ " << results.size() << " rows matched, unrequested fields not decoded" << endl;
+    }
+    
+    cout << "\n✅ TEST 11 PASSED: Filters and projection run inside the scan!" << endl;
+}
+
+// ==================== TEST 12: Reverse Cursor / Latest N ====================
+void test12_LatestReadings() {
+    cout << "\n╔════════════════════════════════════════════════╗" << endl;
+    cout << "║  TEST 12: Reverse Cursor / Latest N           ║" << endl;
+    cout << "╚════════════════════════════════════════════════╝" << endl;
+    
+    string testPath = "test12_latest";
+    cleanupFiles(testPath);
+    
+    {
+        DiskBTree tree(3, testPath);
+        
+        // Insert out of order so the tree is not a simple append pattern
+        for (int i = 0; i < 120; i++) {
+            int minute = (i * 37) % 120;
+            VitalRecord r(101 + minute % 2, createTimestamp(4, 0) + minute * 60, 60 + minute % 50, 120, 80, 97, 36.9);
+            tree.insert(createTimestamp(4, 0) + minute * 60, r);
+        }
+        
+        // Full reverse walk visits every key in descending order
+        DiskBTreeReverseCursor cursor(tree, createTimestamp(23, 0));
+        long key, dataPos, lastKey = createTimestamp(23, 0) + 1;
+        int visited = 0;
+        while (cursor.prev(key, dataPos)) {
+            assert(key <= lastKey);
+            lastKey = key;
+            visited++;
+        }
+        assert(visited == 120);
+        cout << "✓ Reverse cursor visits all " << visited << " keys in descending order" << endl;
+        
+        // Last 5 readings of patient 102 up to 05:00
+        VitalQuery query;
+        query.predicates.push_back(VitalPredicate(FIELD_PATIENT_ID, OP_EQUAL, 102));
+        auto latest = tree.latestRecords(0, createTimestamp(5, 0), 5, query);
+        assert(latest.size() == 5);
+        for (size_t i = 0; i < latest.size(); i++) {
+            assert(latest[i].patientID == 102);
+            if (i > 0) assert(latest[i - 1].timestamp < latest[i].timestamp);
+        }
+        assert(latest.back().timestamp == createTimestamp(4, 59));
+        cout << "✓ Latest 5 readings returned oldest-first, ending at 04:59" << endl;
+        
+        // Start bound stops the walk early
+        latest = tree.latestRecords(createTimestamp(4, 57), createTimestamp(5, 0), 50, VitalQuery());
+        assert(latest.size() == 4);
+        cout << "✓ Start bound respected" << endl;
+    }
+    
+    cout << "\n✅ TEST 12 PASSED: Latest-N queries walk the index backwards!" << endl;
+}
+
+void test13_PatientBloom() {
+    cout << "\n╔════════════════════════════════════════════════╗" << endl;
+    cout << "║  TEST 13: Per-Block Patient Bloom Filters     ║" << endl;
+    cout << "╚════════════════════════════════════════════════╝" << endl;
+    
+    string testPath = "test13_pidbloom";
+    cleanupFiles(testPath);
+    
+    const int OLD_RECORDS = ZONE_CHUNK_RECORDS * 5;
+    {
+        DiskBTree tree(3, testPath);
+        
+        // Five blocks of long-stay patients 101-110 and 299, so a newly
+        // admitted patient 200 falls inside every block's patientID range
+        for (int i = 0; i < OLD_RECORDS; i++) {
+            int patient = (i % 11 == 0) ? 299 : 101 + i % 10;
+            VitalRecord r(patient, createTimestamp(0, 0) + i * 60, 75, 120, 80, 97, 36.9);
+            tree.insert(r.timestamp, r);
+        }
+        // Patient 200 admitted for the last block only
+        for (int i = 0; i < ZONE_CHUNK_RECORDS; i++) {
+            VitalRecord r(200, createTimestamp(0, 0) + (OLD_RECORDS + i) * 60, 90, 130, 85, 95, 37.2);
+            tree.insert(r.timestamp, r);
+        }
+        
+        assert(tree.getZoneMap().getBlockCount() == 6);
+        for (int b = 0; b < 5; b++) {
+            assert(tree.getZoneMap().getZone(b).mayContainPatient(105));
+        }
+        assert(tree.getZoneMap().getZone(5).mayContainPatient(200));
+        cout << "✓ Every block's filter contains its own patients" << endl;
+        
+        vector<VitalPredicate> predicates;
+        assert(VitalPredicate::parseList("patientID=200", predicates));
+        ZoneScanStats stats;
+        auto results = tree.scanWhere(0, createTimestamp(23, 0), predicates, &stats);
+        assert(static_cast<int>(results.size()) == ZONE_CHUNK_RECORDS);
+        assert(stats.blocksScanned == 1);
+        cout << "✓ Long lookback for patient 200 read " << stats.blocksScanned
+             << "/" << stats.blocksTotal << " blocks" << endl;
+        
+        VitalQuery query;
+        query.predicates = predicates;
+        results = tree.rangeQuery(0, createTimestamp(23, 0), query);
+        assert(static_cast<int>(results.size()) == ZONE_CHUNK_RECORDS);
+        auto latest = tree.latestRecords(0, createTimestamp(23, 0), 3, query);
+        assert(latest.size() == 3 && latest.back().patientID == 200);
+        cout << "✓ Pushdown and latest-N queries agree with the filtered scan" << endl;
+    }
+    
+    {
+        // Filters are persisted with the zone file
+        DiskBTree tree(3, testPath);
+        assert(tree.getZoneMap().getBlockCount() == 6);
+        assert(tree.getZoneMap().getZone(5).mayContainPatient(200));
+        cout << "✓ Patient filters reloaded from disk" << endl;
+    }
+    
+    cout << "\n✅ TEST 13 PASSED: Blocks without the patient are skipped!" << endl;
+}
+
+void test14_PatientIndex() {
+    cout << "\n╔════════════════════════════════════════════════╗" << endl;
+    cout << "║  TEST 14: Secondary Patient Index             ║" << endl;
+    cout << "╚════════════════════════════════════════════════╝" << endl;
+    
+    string testPath = "test14_pidx";
+    cleanupFiles(testPath);
+    
+    {
+        DiskBTree tree(3, testPath);
+        
+        // Four patients, readings arriving slightly out of order
+        for (int i = 0; i < 200; i++) {
+            int minute = (i % 2 == 0) ? i : i - 2;
+            VitalRecord r(101 + i % 4, createTimestamp(6, 0) + minute * 60 + i % 4, 60 + i % 40, 120, 80, 97, 37.0);
+            tree.insert(r.timestamp, r);
+        }
+        
+        assert(tree.getPatientIndex().getPatientCount() == 4);
+        assert(tree.getPatientIndex().getEntryCount() == 200);
+        cout << "✓ 200 readings indexed under 4 patients" << endl;
+        
+        // Same answer as a full time-range scan with a patient predicate
+        VitalQuery patientQuery;
+        patientQuery.predicates.push_back(VitalPredicate(FIELD_PATIENT_ID, OP_EQUAL, 103));
+        auto scanned = tree.rangeQuery(createTimestamp(6, 30), createTimestamp(8, 0), patientQuery);
+        auto indexed = tree.patientRangeQuery(103, createTimestamp(6, 30), createTimestamp(8, 0), VitalQuery());
+        assert(!indexed.empty());
+        assert(indexed.size() == scanned.size());
+        for (size_t i = 0; i < indexed.size(); i++) {
+            assert(indexed[i].patientID == 103);
+            assert(indexed[i].timestamp == scanned[i].timestamp);
+            if (i > 0) assert(indexed[i - 1].timestamp <= indexed[i].timestamp);
+        }
+        cout << "✓ Index lookup matches the filtered range scan (" << indexed.size() << " readings)" << endl;
+        
+        VitalQuery where;
+        assert(VitalPredicate::parseList("heart_rate>=90", where.predicates));
+        auto latest = tree.patientLatestRecords(102, 0, createTimestamp(23, 0), 3, where);
+        assert(latest.size() == 3);
+        for (const auto& r : latest) assert(r.patientID == 102 && r.heart_rate >= 90);
+        assert(tree.patientRangeQuery(999, 0, createTimestamp(23, 0), VitalQuery()).empty());
+        cout << "✓ Latest-N and extra predicates work through the index" << endl;
+    }
+    
+    {
+        DiskBTree tree(3, testPath);
+        assert(tree.getPatientIndex().getEntryCount() == 200);
+        cout << "✓ Index log reloaded on restart" << endl;
+    }
+    
+    // Lost index log is rebuilt from the data file
+    remove((testPath + "_pidx.dat").c_str());
+    {
+        DiskBTree tree(3, testPath);
+        assert(tree.getPatientIndex().getEntryCount() == 200);
+        assert(tree.patientRangeQuery(104, 0, createTimestamp(23, 0), VitalQuery()).size() == 50);
+        cout << "✓ Missing index rebuilt from the data file" << endl;
+    }
+    
+    // A crash after logging an entry but before committing its record
+    // leaves an entry whose data position is handed to the next insert
+    {
+        ofstream log(testPath + "_pidx.dat", ios::binary | ios::app);
+        int patientID = 999;
+        long timestamp = createTimestamp(12, 0);
+        long dataPosition = 200L * VitalRecord::getDiskSize();
+        log.write(reinterpret_cast<const char*>(&patientID), sizeof(patientID));
+        log.write(reinterpret_cast<const char*>(&timestamp), sizeof(timestamp));
+        log.write(reinterpret_cast<const char*>(&dataPosition), sizeof(dataPosition));
+    }
+    {
+        DiskBTree tree(3, testPath);
+        assert(tree.getPatientIndex().getEntryCount() == 200);
+        
+        VitalRecord r(101, createTimestamp(12, 0), 72, 120, 80, 97, 37.0);
+        tree.insert(r.timestamp, r);
+        assert(tree.patientRangeQuery(999, 0, createTimestamp(23, 0), VitalQuery()).empty());
+        VitalBatch batch;
+        tree.patientRangeQueryBatch(999, 0, createTimestamp(23, 0), batch);
+        assert(batch.size() == 0);
+        auto latest = tree.patientLatestRecords(101, 0, createTimestamp(23, 0), 1, VitalQuery());
+        assert(latest.size() == 1 && latest[0].timestamp == createTimestamp(12, 0));
+        cout << "✓ Entries past the committed records are dropped on open" << endl;
+    }
+    {
+        DiskBTree tree(3, testPath);
+        assert(tree.getPatientIndex().getEntryCount() == 201);
+        assert(tree.getPatientIndex().getPatientCount() == 4);
+    }
+    
+    cout << "\n✅ TEST 14 PASSED: Per-patient lookups use the secondary index!" << endl;
+}
+
+void test15_PackedCodec() {
+    cout << "\n╔════════════════════════════════════════════════╗" << endl;
+    cout << "║  TEST 15: Packed Record Codec                 ║" << endl;
+    cout << "╚════════════════════════════════════════════════╝" << endl;
+    
+    // Layout is pinned independent of sizeof(long)
+    assert(VitalRecord::getDiskSize() == 32);
+    assert(VitalRecord::getFieldOffset(FIELD_TIMESTAMP) == 4);
+    assert(VitalRecord::getFieldOffset(FIELD_HEART_RATE) == 12);
+    assert(VitalRecord::getFieldOffset(FIELD_TEMPERATURE) == 28);
+    cout << "✓ 32-byte packed layout with fixed field offsets" << endl;
+    
+    VitalRecord original(4242, 4102444800L, 88, 141, 92, 93, 38.4f);
+    char buffer[32];
+    original.encode(buffer);
+    VitalRecord copy;
+    copy.decode(buffer);
+    assert(copy.patientID == 4242 && copy.timestamp == 4102444800L);
+    assert(copy.heart_rate == 88 && copy.systolic_bp == 141 && copy.diastolic_bp == 92);
+    assert(copy.spo2 == 93 && copy.temperature == 38.4f);
+    assert(VitalRecord::decodeField(buffer, FIELD_TIMESTAMP) == 4102444800.0);
+    cout << "✓ Encode/decode round trip" << endl;
+    
+    // Batch decode vs one stream read per record
+    const int BATCH = 100000;
+    vector<char> raw(BATCH * 32);
+    for (int i = 0; i < BATCH; i++) {
+        VitalRecord r(i % 50, createTimestamp(0, 0) + i, 60 + i % 40, 120, 80, 95, 36.6f);
+        r.encode(raw.data() + i * 32);
+    }
+    
+    auto start = chrono::high_resolution_clock::now();
+    vector<VitalRecord> batch;
+    VitalRecord::decodeBatch(raw.data(), BATCH, batch, 0);
+    auto end = chrono::high_resolution_clock::now();
+    double batchMs = chrono::duration<double, milli>(end - start).count();
+    
+    assert(static_cast<int>(batch.size()) == BATCH);
+    assert(batch[777].timestamp == createTimestamp(0, 0) + 777);
+    assert(batch[777].heart_rate == 60 + 777 % 40);
+    assert(batch[777].diskPosition == 777 * 32);
+    cout << "✓ Decoded " << BATCH << " records in " << batchMs << " ms" << endl;
+    
+    // Range scans read adjacent leaf records in one go
+    string testPath = "test15_codec";
+    cleanupFiles(testPath);
+    {
+        DiskBTree tree(3, testPath);
+        for (int i = 0; i < 60; i++) {
+            VitalRecord r(101 + i % 3, createTimestamp(9, i), 70 + i, 120, 80, 97, 36.8f);
+            tree.insert(r.timestamp, r);
+        }
+        
+        auto results = tree.rangeQuery(createTimestamp(9, 10), createTimestamp(9, 49));
+        assert(results.size() == 40);
+        for (size_t i = 0; i < results.size(); i++) {
+            assert(results[i].timestamp == createTimestamp(9, 10 + i));
+            assert(results[i].heart_rate == 80 + static_cast<int>(i));
+            assert(results[i].diskPosition == static_cast<long>(10 + i) * 32);
+        }
+        cout << "✓ Coalesced range read returns ordered, positioned records" << endl;
+    }
+    
+    cout << "\n✅ TEST 15 PASSED: Packed codec and batch decode work!" << endl;
+}
+
+void test16_VitalBatch() {
+    cout << "\n╔════════════════════════════════════════════════╗" << endl;
+    cout << "║  TEST 16: Struct-of-Arrays VitalBatch         ║" << endl;
+    cout << "╚════════════════════════════════════════════════╝" << endl;
+    
+    vector<VitalRecord> records;
+    for (int i = 0; i < 10; i++) {
+        records.push_back(VitalRecord(101, createTimestamp(1, i), 60 + i * 5, 120, 80, 90 + i, 36.5f + i * 0.1f));
+    }
+    
+    VitalBatch batch = VitalBatch::fromRecords(records);
+    assert(batch.size() == 10);
+    assert(reinterpret_cast<uintptr_t>(batch.heart_rate.data()) % VITAL_BATCH_ALIGNMENT == 0);
+    assert(reinterpret_cast<uintptr_t>(batch.timestamp.data()) % VITAL_BATCH_ALIGNMENT == 0);
+    cout << "✓ Columns are " << VITAL_BATCH_ALIGNMENT << "-byte aligned" << endl;
+    
+    auto back = batch.toRecords();
+    assert(back.size() == 10 && back[7].heart_rate == 95 && back[7].timestamp == createTimestamp(1, 7));
+    cout << "✓ Row <-> column conversion round trip" << endl;
+    
+    VitalColumnStats hr = batch.summarize(FIELD_HEART_RATE);
+    assert(hr.count == 10 && hr.min == 60 && hr.max == 105 && hr.mean == 82.5);
+    VitalPredicate low(FIELD_SPO2, OP_LESS, 94);
+    assert(batch.countMatching(low) == 4);
+    cout << "✓ Column kernels: HR mean " << hr.mean << ", " << batch.countMatching(low) << " readings SpO2<94" << endl;
+    
+    string testPath = "test16_batch";
+    cleanupFiles(testPath);
+    {
+        DiskBTree tree(3, testPath);
+        for (int i = 0; i < 80; i++) {
+            VitalRecord r(101 + i % 2, createTimestamp(2, i), 70 + i % 30, 115, 75, 96, 36.9f);
+            tree.insert(r.timestamp, r);
+        }
+        
+        VitalBatch range;
+        tree.rangeQueryBatch(createTimestamp(2, 20), createTimestamp(2, 59), range);
+        auto rows = tree.rangeQuery(createTimestamp(2, 20), createTimestamp(2, 59));
+        assert(range.size() == rows.size() && range.size() == 40);
+        for (size_t i = 0; i < rows.size(); i++) {
+            assert(range.timestamp[i] == rows[i].timestamp);
+            assert(range.heart_rate[i] == rows[i].heart_rate);
+        }
+        
+        VitalBatch patient;
+        tree.patientRangeQueryBatch(102, 0, createTimestamp(23, 0), patient);
+        assert(patient.size() == 40);
+        assert(patient.summarize(FIELD_PATIENT_ID).min == 102);
+        cout << "✓ Range queries decode straight into columns" << endl;
+    }
+    
+    cout << "\n✅ TEST 16 PASSED: VitalBatch columns and kernels work!" << endl;
+}
+
 // ==================== MAIN ====================
 int main() {
     cout << "\n";
@@ -385,6 +950,15 @@ int main() {
         test5_LargeDataset();
         test6_NodeSplitting();
         test7_EdgeCases();
+        test8_WarmUp();
+        test9_RangePrefetch();
+        test10_ZoneMapScan();
+        test11_Pushdown();
+        test12_LatestReadings();
+        test13_PatientBloom();
+        test14_PatientIndex();
+        test15_PackedCodec();
+        test16_VitalBatch();
         
         cout << "\n\n";
         cout << "╔══════════════════════════════════════════════════════╗" << endl;
@@ -398,11 +972,20 @@ int main() {
         cout << "║  • test5_large_*.dat                                 ║" << endl;
         cout << "║  • test6_split_*.dat                                 ║" << endl;
         cout << "║  • test7_edge_*.dat                                  ║" << endl;
+        cout << "║  • test8_warmup_*.dat                                ║" << endl;
+        cout << "║  • test9_prefetch_*.dat                              ║" << endl;
+        cout << "║  • test10_zones_*.dat                                ║" << endl;
+        cout << "║  • test11_pushdown_*.dat                             ║" << endl;
+        cout << "║  • test12_latest_*.dat                               ║" << endl;
+        cout << "║  • test13_pidbloom_*.dat                             ║" << endl;
+        cout << "║  • test14_pidx_*.dat                                 ║" << endl;
+        cout << "║  • test15_codec_*.dat                                ║" << endl;
+        cout << "║  • test16_batch_*.dat                                ║" << endl;
         cout << "║                                                      ║" << endl;
         cout << "║  Your disk-based B-tree is working correctly!       ║" << endl;
         cout << "║                                                      ║" << endl;
         cout << "╚══════════════════════════════════════════════════════╝" << endl;
-        
+    
     } catch (const exception& e) {
         cout << "\n❌ TEST FAILED WITH EXCEPTION: " << e.what() << endl;
         return 1;
@@ -0,0 +1,94 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+#include "downsampler.h"
+
+using namespace std;
+
+long createTimestamp(int hour, int minute, int second = 0) {
+    long baseTime = 1733270400; // Dec 4, 2024, 00:00:00
+    return baseTime + (hour * 3600) + (minute * 60) + second;
+}
+
+// ==================== TEST 1: Basic Selection ====================
+void test1_BasicSelection() {
+    cout << "\n========== TEST 1: Basic Selection ==========" << endl;
+    
+    vector<int64_t> x;
+    vector<int> y;
+    for (int i = 0; i < 10; i++) {
+        x.push_back(createTimestamp(0, i));
+        y.push_back(i % 3);
+    }
+    
+    vector<size_t> all = Downsampler::lttb(x.data(), y.data(), x.size(), 20);
+    assert(all.size() == 10);
+    cout << "✓ Series shorter than the limit is returned whole" << endl;
+    
+    vector<size_t> picked = Downsampler::lttb(x.data(), y.data(), x.size(), 5);
+    assert(picked.size() == 5);
+    assert(picked.front() == 0 && picked.back() == 9);
+    for (size_t i = 1; i < picked.size(); i++) {
+        assert(picked[i] > picked[i - 1]);
+    }
+    cout << "✓ Exactly N points, endpoints kept, in time order" << endl;
+    
+    vector<size_t> none = Downsampler::lttb(x.data(), y.data(), 0, 5);
+    assert(none.empty());
+    cout << "✓ Empty series yields no points" << endl;
+    
+    cout << "\n✅ Test 1 Passed!" << endl;
+}
+
+// ==================== TEST 2: Spikes Survive ====================
+void test2_SpikesSurvive() {
+    cout << "\n========== TEST 2: Spikes Survive ==========" << endl;
+    
+    // A week at one reading a minute with two short events
+    VitalBatch batch;
+    const int READINGS = 7 * 24 * 60;
+    for (int i = 0; i < READINGS; i++) {
+        int hr = 75 + (i % 7) - 3;
+        int spo2 = 97;
+        if (i == 4321) hr = 165;                    // One-minute tachycardia
+        if (i >= 8000 && i < 8003) spo2 = 82;       // Brief desaturation
+        batch.append(VitalRecord(101, createTimestamp(0, i), hr, 120, 80, spo2, 37.0));
+    }
+    
+    const size_t POINTS = 800;
+    vector<size_t> heartRate = Downsampler::lttb(batch, FIELD_HEART_RATE, POINTS);
+    vector<size_t> spo2 = Downsampler::lttb(batch, FIELD_SPO2, POINTS);
+    assert(heartRate.size() == POINTS && spo2.size() == POINTS);
+    
+    bool foundSpike = false;
+    for (size_t i : heartRate) foundSpike = foundSpike || batch.heart_rate[i] == 165;
+    assert(foundSpike);
+    
+    bool foundDesat = false;
+    for (size_t i : spo2) foundDesat = foundDesat || batch.spo2[i] == 82;
+    assert(foundDesat);
+    cout << "✓ " << READINGS << " readings -> " << POINTS << " points with the HR spike and desaturation kept" << endl;
+    
+    // Each field is selected independently
+    assert(heartRate != spo2);
+    cout << "✓ Points are chosen per field" << endl;
+    
+    cout << "\n✅ Test 2 Passed!" << endl;
+}
+
+int main() {
+    cout << "╔══════════════════════════════════════════════════════╗" << endl;
+    cout << "║   LTTB DOWNSAMPLER TEST SUITE                       ║" << endl;
+    cout << "║   IntelliCare ICU - Vitals Charts                   ║" << endl;
+    cout << "╚══════════════════════════════════════════════════════╝" << endl;
+    
+    test1_BasicSelection();
+    test2_SpikesSurvive();
+    
+    cout << "\n\n╔══════════════════════════════════════════════════════╗" << endl;
+    cout << "║    ALL TESTS PASSED SUCCESSFULLY!                 ║" << endl;
+    cout << "╚══════════════════════════════════════════════════════╝" << endl;
+    
+    return 0;
+}
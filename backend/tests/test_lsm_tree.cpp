@@ -0,0 +1,215 @@
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "lsm_tree.h"
+
+using namespace std;
+
+long createTimestamp(int hour, int minute, int second = 0) {
+    long baseTime = 1733270400; // Dec 4, 2024, 00:00:00
+    return baseTime + (hour * 3600) + (minute * 60) + second;
+}
+
+// Remove manifest, WAL and every run file the test may have produced
+void cleanupFiles(const string& basePath) {
+    remove((basePath + "_lsm_manifest.dat").c_str());
+    remove((basePath + "_lsm_manifest.dat.tmp").c_str());
+    remove((basePath + "_lsm_wal.dat").c_str());
+    for (int id = 1; id < 200; id++) {
+        remove((basePath + "_lsm_run_" + to_string(id) + ".dat").c_str());
+    }
+}
+
+// ==================== TEST 1: Memtable & WAL Recovery ====================
+void test1_MemtableRecovery() {
+    cout << "\n========== TEST 1: Memtable & WAL Recovery ==========" << endl;
+    
+    string testPath = "lsm_test1";
+    cleanupFiles(testPath);
+    
+    {
+        LSMTree tree(testPath);
+        for (int i = 0; i < 100; i++) {
+            VitalRecord r(101, createTimestamp(10, 0, i), 70 + i % 20, 120, 80, 97, 37.0);
+            tree.insert(r.timestamp, r);
+        }
+        assert(tree.getRecordCount() == 100);
+        assert(tree.getRunCount() == 0);
+        cout << "✓ 100 records buffered in memtable" << endl;
+    }
+    
+    {
+        // Destructor flushed the memtable into a level-0 run
+        LSMTree tree(testPath);
+        assert(tree.getRecordCount() == 100);
+        assert(tree.getRunCount() == 1);
+        
+        VitalRecord* found = tree.search(createTimestamp(10, 0, 42));
+        assert(found != nullptr);
+        assert(found->heart_rate == 70 + 42 % 20);
+        delete found;
+        
+        assert(tree.search(createTimestamp(11, 0)) == nullptr);
+        cout << "✓ Records survive restart and are found via run files" << endl;
+    }
+    
+    cout << "\n✅ Test 1 Passed!" << endl;
+}
+
+// ==================== TEST 2: Flush, Compaction & Range Query ====================
+void test2_Compaction() {
+    cout << "\n========== TEST 2: Flush, Compaction & Range Query ==========" << endl;
+    
+    string testPath = "lsm_test2";
+    cleanupFiles(testPath);
+    
+    const int RECORD_COUNT = LSM_MEMTABLE_LIMIT * (LSM_L0_RUN_LIMIT + 1) + 500;
+    {
+        LSMTree tree(testPath);
+        
+        // Interleave two patients; timestamps increase by one second
+        for (int i = 0; i < RECORD_COUNT; i++) {
+            VitalRecord r(101 + i % 2, createTimestamp(0, 0, i), 60 + i % 50, 120, 80, 90 + i % 10, 36.8);
+            tree.insert(r.timestamp, r);
+        }
+        tree.waitForCompaction();
+        
+        assert(tree.getRecordCount() == RECORD_COUNT);
+        assert(tree.getRunCount(0) < LSM_L0_RUN_LIMIT);
+        assert(tree.getRunCount(1) == 1);
+        cout << "✓ Level 0 compacted into level 1 (" << tree.getRunCount() << " runs)" << endl;
+        
+        auto results = tree.rangeQuery(createTimestamp(0, 0, 1000), createTimestamp(0, 0, 1999));
+        assert(results.size() == 1000);
+        for (size_t i = 1; i < results.size(); i++) {
+            assert(results[i - 1].timestamp <= results[i].timestamp);
+        }
+        cout << "✓ Range query across runs returns 1000 ordered records" << endl;
+        
+        // Range covering the unflushed memtable tail
+        results = tree.rangeQuery(createTimestamp(0, 0, RECORD_COUNT - 10), createTimestamp(23, 0));
+        assert(results.size() == 10);
+        cout << "✓ Memtable records are visible to range queries" << endl;
+        
+        // Pushdown and latest-N
+        VitalQuery query;
+        query.predicates.push_back(VitalPredicate(FIELD_PATIENT_ID, OP_EQUAL, 102));
+        assert(VitalQuery::parseFields("spo2", query.fieldMask));
+        auto latest = tree.latestRecords(0, createTimestamp(23, 0), 5, query);
+        assert(latest.size() == 5);
+        assert(latest.back().timestamp == createTimestamp(0, 0, RECORD_COUNT - 1));
+        assert(latest.back().patientID == 102);
+        assert(latest.back().heart_rate == 0);
+        cout << "✓ Latest 5 readings for one patient found from the top" << endl;
+        
+        // Zone maps in run footers
+        vector<VitalPredicate> predicates;
+        assert(VitalPredicate::parseList("spo2<91", predicates));
+        ZoneScanStats stats;
+        results = tree.scanWhere(createTimestamp(0, 0), createTimestamp(0, 10), predicates, &stats);
+        assert(!results.empty());
+        for (const auto& r : results) assert(r.spo2 < 91);
+        assert(stats.blocksScanned <= stats.blocksTotal);
+        cout << "✓ scanWhere found " << results.size() << " readings in "
+             << stats.blocksScanned << "/" << stats.blocksTotal << " blocks" << endl;
+    }
+    
+    {
+        LSMTree tree(testPath);
+        assert(tree.getRecordCount() == RECORD_COUNT);
+        auto results = tree.rangeQuery(createTimestamp(0, 0), createTimestamp(23, 0));
+        assert(static_cast<int>(results.size()) == RECORD_COUNT);
+        cout << "✓ All " << RECORD_COUNT << " records present after reopening" << endl;
+    }
+    
+    cout << "\n✅ Test 2 Passed!" << endl;
+}
+
+// ==================== TEST 3: Bloom Filter ====================
+void test3_BloomFilter() {
+    cout << "\n========== TEST 3: Bloom Filter ==========" << endl;
+    
+    BloomFilter filter(1000, 0.01);
+    for (long key = 0; key < 1000; key++) {
+        filter.add(key * 7);
+    }
+    
+    for (long key = 0; key < 1000; key++) {
+        assert(filter.mightContain(key * 7));
+    }
+    
+    int falsePositives = 0;
+    for (long key = 100000; key < 110000; key++) {
+        if (filter.mightContain(key)) falsePositives++;
+    }
+    cout << "✓ No false negatives; false-positive rate "
+         << (falsePositives / 100.0) << "%" << endl;
+    assert(falsePositives < 500);
+    
+    cout << "\n✅ Test 3 Passed!" << endl;
+}
+
+// ==================== TEST 4: Patient Filters ====================
+void test4_PatientFilters() {
+    cout << "\n========== TEST 4: Patient Filters ==========" << endl;
+    
+    string testPath = "lsm_test4";
+    cleanupFiles(testPath);
+    
+    LSMTree tree(testPath);
+    
+    // Older run: patients 101-104; newer run: only patient 150
+    for (int i = 0; i < 2000; i++) {
+        VitalRecord r(101 + i % 4, createTimestamp(0, 0, i), 70, 120, 80, 97, 37.0);
+        tree.insert(r.timestamp, r);
+    }
+    tree.flush();
+    for (int i = 2000; i < 2500; i++) {
+        VitalRecord r(150, createTimestamp(0, 0, i), 95, 130, 85, 94, 37.5);
+        tree.insert(r.timestamp, r);
+    }
+    tree.flush();
+    assert(tree.getRunCount() == 2);
+    
+    vector<VitalPredicate> predicates;
+    assert(VitalPredicate::parseList("patientID=150", predicates));
+    ZoneScanStats stats;
+    auto results = tree.scanWhere(0, createTimestamp(23, 0), predicates, &stats);
+    assert(results.size() == 500);
+    assert(stats.blocksScanned == (500 + LSM_BLOCK_RECORDS - 1) / LSM_BLOCK_RECORDS);
+    cout << "✓ Run without patient 150 skipped: " << stats.blocksScanned << "/"
+         << stats.blocksTotal << " blocks read" << endl;
+    
+    VitalQuery query;
+    query.predicates = predicates;
+    results = tree.rangeQuery(0, createTimestamp(23, 0), query);
+    assert(results.size() == 500);
+    
+    query.predicates[0].value = 103;
+    auto latest = tree.latestRecords(0, createTimestamp(23, 0), 2, query);
+    assert(latest.size() == 2);
+    assert(latest.back().timestamp == createTimestamp(0, 0, 1998));
+    cout << "✓ Range and latest-N queries skip runs by patient" << endl;
+    
+    cout << "\n✅ Test 4 Passed!" << endl;
+}
+
+int main() {
+    cout << "╔══════════════════════════════════════════════════════╗" << endl;
+    cout << "║   LSM-TREE STORAGE ENGINE TEST SUITE                ║" << endl;
+    cout << "║   IntelliCare ICU - Vital Signs Storage             ║" << endl;
+    cout << "╚══════════════════════════════════════════════════════╝" << endl;
+    
+    test1_MemtableRecovery();
+    test2_Compaction();
+    test3_BloomFilter();
+    test4_PatientFilters();
+    
+    cout << "\n\n╔══════════════════════════════════════════════════════╗" << endl;
+    cout << "║    ALL TESTS PASSED SUCCESSFULLY!                 ║" << endl;
+    cout << "╚══════════════════════════════════════════════════════╝" << endl;
+    
+    return 0;
+}
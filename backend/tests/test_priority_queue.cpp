@@ -1,6 +1,14 @@
 #include <iostream>
+#include <cassert>
 #include <thread>
 #include <chrono>
+#include <vector>
+#include <fstream>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <algorithm>
 #include "../src/data_structures/priority_queue.h"
 
 using namespace std;
@@ -232,6 +240,753 @@ void test6_HeapProperty() {
     cout << "\n Test 6 Passed!" << endl;
 }
 
+// Test 7: Sorted Snapshot
+void test7_SortedSnapshot() {
+    cout << "\n========== TEST 7: Sorted Snapshot ==========" << endl;
+    
+    PriorityQueue pq;
+    pq.insert(Alert(1, 101, MEDIUM, CUSTOM, "Alert 1"));
+    pq.insert(Alert(2, 102, CRITICAL, CUSTOM, "Alert 2"));
+    pq.insert(Alert(3, 103, LOW, CUSTOM, "Alert 3"));
+    pq.insert(Alert(4, 104, CRITICAL, CUSTOM, "Alert 4"));
+    
+    auto snapshot = pq.getSortedSnapshot();
+    assert(snapshot->size() == 4 && pq.size() == 4);
+    assert((*snapshot)[0].alertID == 2 && (*snapshot)[1].alertID == 4);
+    assert((*snapshot)[2].alertID == 1 && (*snapshot)[3].alertID == 3);
+    assert(pq.peekMin().alertID == 2);
+    cout << "✓ Snapshot lists alerts in priority order without extracting" << endl;
+    
+    // Repeated polls share the cached copy
+    assert(pq.getSortedSnapshot() == snapshot);
+    cout << "✓ Unchanged queue returns the cached snapshot" << endl;
+    
+    // Mutation publishes a new snapshot; the old one stays valid
+    pq.insert(Alert(5, 105, HIGH, CUSTOM, "Alert 5"));
+    auto updated = pq.getSortedSnapshot();
+    assert(updated != snapshot && updated->size() == 5 && snapshot->size() == 4);
+    assert((*updated)[2].alertID == 5);
+    cout << "✓ Insert invalidates the cache; earlier readers keep their copy" << endl;
+    
+    // Concurrent polls and inserts (inserts log every alert)
+    cout.setstate(ios::failbit);
+    vector<thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.push_back(thread([&pq, t] {
+            for (int i = 0; i < 200; i++) {
+                if (t == 0) {
+                    pq.insert(Alert(100 + i, 200, LOW, CUSTOM, "Concurrent"));
+                } else {
+                    auto view = pq.getSortedSnapshot();
+                    for (size_t j = 1; j < view->size(); j++) {
+                        assert(!((*view)[j] < (*view)[j - 1]));
+                    }
+                }
+            }
+        }));
+    }
+    for (auto& th : threads) th.join();
+    cout.clear();
+    assert(pq.size() == 205 && pq.getSortedSnapshot()->size() == 205);
+    cout << "✓ Snapshots stay ordered under concurrent inserts" << endl;
+    
+    cout << "\n✅ Test 7 Passed!" << endl;
+}
+
+// Test 8: Indexed Updates by Alert ID
+void test8_IndexedUpdates() {
+    cout << "\n========== TEST 8: Indexed Updates by Alert ID ==========" << endl;
+    
+    PriorityQueue pq;
+    cout.setstate(ios::failbit);
+    for (int i = 1; i <= 500; i++) {
+        pq.insert(Alert(i, 100 + i % 10, static_cast<AlertPriority>((i % 5) + 1), CUSTOM, "Alert"));
+    }
+    cout.clear();
+    
+    Alert found;
+    assert(pq.contains(250) && pq.getAlert(250, found) && found.alertID == 250);
+    assert(!pq.contains(9999) && !pq.getAlert(9999, found));
+    cout << "✓ Alerts found by ID without scanning" << endl;
+    
+    assert(pq.acknowledge(250, "Nurse Kim", 1733270400));
+    assert(pq.getAlert(250, found) && found.acknowledged && found.acknowledgedBy == "Nurse Kim");
+    assert(!pq.acknowledge(9999, "Nurse Kim", 1733270400));
+    cout << "✓ Acknowledge updates the alert in place" << endl;
+    
+    // Escalate an INFO alert to the top, then de-escalate it
+    assert(pq.getAlert(4, found) && found.priority == INFO);
+    assert(pq.updatePriority(4, CRITICAL));
+    assert(pq.peekMin().priority == CRITICAL);
+    assert(pq.updatePriority(4, INFO));
+    assert(pq.getAlert(4, found) && found.priority == INFO);
+    cout << "✓ Priority changes re-sift the heap" << endl;
+    
+    // Remove every third alert, then drain in order
+    int removed = 0;
+    for (int i = 3; i <= 500; i += 3) {
+        assert(pq.remove(i));
+        removed++;
+    }
+    assert(!pq.remove(3));
+    assert(pq.size() == 500 - removed);
+    
+    cout.setstate(ios::failbit);
+    Alert previous = pq.extractMin();
+    bool ordered = previous.alertID % 3 != 0;
+    while (!pq.isEmpty()) {
+        Alert next = pq.extractMin();
+        ordered = ordered && !(next < previous) && next.alertID % 3 != 0;
+        previous = next;
+    }
+    cout.clear();
+    assert(ordered);
+    cout << "✓ Removed " << removed << " alerts by ID; remaining drain in priority order" << endl;
+    
+    // Re-inserting an existing ID replaces it
+    pq.insert(Alert(7, 101, LOW, CUSTOM, "Original"));
+    pq.insert(Alert(7, 101, HIGH, CUSTOM, "Replaced"));
+    assert(pq.size() == 1 && pq.peekMin().message == "Replaced");
+    cout << "✓ Duplicate alert ID replaces the queued alert" << endl;
+    
+    cout << "\n✅ Test 8 Passed!" << endl;
+}
+
+// Test 9: Append-only Journal and Crash Recovery
+void test9_Journal() {
+    cout << "\n========== TEST 9: Journal and Crash Recovery ==========" << endl;
+    
+    const string path = "test_pq_journal.bin";
+    remove(path.c_str());
+    remove((path + ".journal").c_str());
+    
+    // Leak the queue so its destructor never runs, as if the process was killed
+    PriorityQueue* crashed = new PriorityQueue(path);
+    cout.setstate(ios::failbit);
+    for (int i = 1; i <= 50; i++) {
+        crashed->insert(Alert(i, 200 + i, static_cast<AlertPriority>((i % 5) + 1), CUSTOM, "Journaled"));
+    }
+    crashed->extractMin();
+    crashed->remove(10);
+    crashed->acknowledge(20, "Dr. Patel", 1733270400);
+    crashed->updatePriority(30, CRITICAL);
+    cout.clear();
+    assert(crashed->getJournalEntryCount() == 54);
+    int expectedSize = crashed->size();
+    Alert expectedTop = crashed->peekMin();
+    cout << "✓ 54 mutations journaled without a snapshot" << endl;
+    
+    // A torn write at the tail must be ignored on replay
+    {
+        ofstream journalFile(path + ".journal", ios::binary | ios::app);
+        const char garbage[] = {0x40, 0x00, 0x00, 0x00, 0x12, 0x34};
+        journalFile.write(garbage, sizeof(garbage));
+    }
+    
+    {
+        cout.setstate(ios::failbit);
+        PriorityQueue recovered(path);
+        cout.clear();
+        
+        Alert found;
+        assert(recovered.size() == expectedSize);
+        assert(recovered.peekMin().alertID == expectedTop.alertID);
+        assert(!recovered.contains(10));
+        assert(recovered.getAlert(20, found) && found.acknowledged && found.acknowledgedBy == "Dr. Patel");
+        assert(recovered.getAlert(30, found) && found.priority == CRITICAL);
+        assert(recovered.getJournalEntryCount() == 0);
+        cout << "✓ State recovered from snapshot + journal; torn tail dropped" << endl;
+        
+        // Appends after recovery land in a clean journal
+        cout.setstate(ios::failbit);
+        recovered.remove(30);
+        cout.clear();
+    }
+    
+    {
+        cout.setstate(ios::failbit);
+        PriorityQueue reopened(path);
+        cout.clear();
+        assert(reopened.size() == expectedSize - 1 && !reopened.contains(30));
+        cout << "✓ Entries appended after recovery replay on the next start" << endl;
+        
+        // The journal is folded into a snapshot before it grows unbounded
+        cout.setstate(ios::failbit);
+        for (int i = 0; i < 3 * PQ_JOURNAL_COMPACT_MIN; i++) {
+            reopened.acknowledge(40, "Nurse Kim", 1733270400 + i);
+        }
+        cout.clear();
+        assert(reopened.getJournalEntryCount() < PQ_JOURNAL_COMPACT_MIN);
+        cout << "✓ Journal compacted (" << reopened.getJournalEntryCount() << " entries pending)" << endl;
+    }
+    
+    delete crashed;
+    remove(path.c_str());
+    remove((path + ".journal").c_str());
+    
+    cout << "\n✅ Test 9 Passed!" << endl;
+}
+
+// Test 10: Alert Storm through the Bucket Queue
+void test10_AlertStorm() {
+    cout << "\n========== TEST 10: Alert Storm (Bucket Queue) ==========" << endl;
+    
+    PriorityQueue pq;
+    const int storm = 50000;
+    
+    // Alerts arrive in timestamp order, as they do from the monitors
+    cout.setstate(ios::failbit);
+    auto start = chrono::high_resolution_clock::now();
+    for (int i = 1; i <= storm; i++) {
+        Alert alert(i, 100 + i % 40, static_cast<AlertPriority>((i * 7 % 5) + 1), VITAL_ABNORMAL, "Storm");
+        alert.timestamp = 1733270400 + i / 10;
+        pq.insert(alert);
+    }
+    auto insertTime = chrono::duration_cast<chrono::milliseconds>(chrono::high_resolution_clock::now() - start);
+    cout.clear();
+    assert(pq.size() == storm);
+    cout << "✓ Absorbed " << storm << " alerts in " << insertTime.count() << " ms" << endl;
+    
+    // A late arrival and an escalation still land in (priority, age) order
+    Alert late(storm + 1, 150, LOW, CUSTOM, "Late arrival");
+    late.timestamp = 1733270400;
+    cout.setstate(ios::failbit);
+    pq.insert(late);
+    pq.updatePriority(storm, CRITICAL);
+    cout.clear();
+    auto snapshot = pq.getSortedSnapshot();
+    for (size_t j = 1; j < snapshot->size(); j++) {
+        assert(!((*snapshot)[j] < (*snapshot)[j - 1]));
+    }
+    cout << "✓ Late arrivals and escalations keep each level ordered" << endl;
+    
+    // Replayed alerts arriving newest-first all take the late-arrival path
+    PriorityQueue replay;
+    cout.setstate(ios::failbit);
+    for (int i = 300; i >= 1; i--) {
+        Alert alert(i, 300, MEDIUM, CUSTOM, "Replayed");
+        alert.timestamp = 1733270400 + i;
+        replay.insert(alert);
+    }
+    bool oldestFirst = true;
+    for (int i = 1; i <= 300; i++) {
+        oldestFirst = oldestFirst && replay.extractMin().alertID == i;
+    }
+    cout.clear();
+    assert(oldestFirst);
+    cout << "✓ Out-of-order arrivals drain oldest first" << endl;
+    
+    // Remove a stripe from the middle of every level, then drain
+    cout.setstate(ios::failbit);
+    for (int i = 1000; i < 20000; i += 2) {
+        assert(pq.remove(i));
+    }
+    start = chrono::high_resolution_clock::now();
+    Alert previous = pq.extractMin();
+    bool ordered = true;
+    int drained = 1;
+    while (!pq.isEmpty()) {
+        Alert next = pq.extractMin();
+        ordered = ordered && !(next < previous);
+        previous = next;
+        drained++;
+    }
+    auto extractTime = chrono::duration_cast<chrono::milliseconds>(chrono::high_resolution_clock::now() - start);
+    cout.clear();
+    assert(ordered && drained == storm + 1 - 9500);
+    cout << "✓ Drained " << drained << " alerts in priority order in " << extractTime.count() << " ms" << endl;
+    
+    cout << "\n✅ Test 10 Passed!" << endl;
+}
+
+// Test 11: Coalescing Repeated Alerts
+void test11_Coalescing() {
+    cout << "\n========== TEST 11: Coalescing Repeated Alerts ==========" << endl;
+    
+    const long t0 = 1733270400;
+    auto spo2Alert = [t0](int id, int patientID, int second, AlertPriority priority) {
+        Alert alert(id, patientID, priority, VITAL_ABNORMAL, "SpO2 below 90%");
+        alert.timestamp = t0 + second;
+        return alert;
+    };
+    
+    PriorityQueue pq;
+    cout.setstate(ios::failbit);
+    pq.insert(spo2Alert(1, 301, 0, HIGH));
+    pq.insert(spo2Alert(2, 301, 1, HIGH));
+    cout.clear();
+    assert(pq.getCoalesceWindow() == 0 && pq.size() == 2);
+    cout << "✓ Coalescing is off by default" << endl;
+    
+    // A flapping probe: one alert per second for 100 seconds
+    pq.clear();
+    pq.setCoalesceWindow(60);
+    cout.setstate(ios::failbit);
+    for (int i = 0; i < 100; i++) {
+        pq.insert(spo2Alert(10 + i, 301, i, HIGH));
+    }
+    pq.insert(spo2Alert(200, 302, 5, HIGH));
+    pq.insert(Alert(201, 301, HIGH, DRUG_INTERACTION, "Different problem"));
+    cout.clear();
+    
+    Alert merged;
+    assert(pq.size() == 3);
+    assert(pq.getAlert(10, merged) && merged.occurrenceCount == 100);
+    assert(merged.getLastSeenTime() == t0 + 99 && merged.timestamp == t0);
+    cout << "✓ 100 repeats merged into one alert (count " << merged.occurrenceCount << ")" << endl;
+    
+    // A repeat outside the window, or after acknowledgement, starts a new alert
+    cout.setstate(ios::failbit);
+    pq.insert(spo2Alert(300, 301, 99 + 61, HIGH));
+    pq.acknowledge(200, "Nurse Kim", t0 + 10);
+    pq.insert(spo2Alert(301, 302, 11, HIGH));
+    cout.clear();
+    assert(pq.size() == 5 && pq.contains(300) && pq.contains(301));
+    cout << "✓ Gaps longer than the window and acknowledged alerts are not merged into" << endl;
+    
+    // A more urgent repeat escalates the merged alert; insert reports the
+    // ID the repeat now lives under, never its own unqueued one
+    cout.setstate(ios::failbit);
+    int survivor = pq.insert(spo2Alert(400, 301, 99 + 70, CRITICAL));
+    int fresh = pq.insert(spo2Alert(401, 303, 0, LOW));
+    cout.clear();
+    assert(survivor == 300 && pq.resolveAlertID(400) == 300);
+    assert(fresh == 401 && pq.contains(401));
+    assert(pq.acknowledge(401, "Nurse Kim", t0 + 12) && pq.remove(401));
+    cout << "✓ insert() returns the surviving alert's ID" << endl;
+    assert(pq.getAlert(300, merged) && merged.priority == CRITICAL && merged.occurrenceCount == 2);
+    assert(pq.peekMin().alertID == 300);
+    cout << "✓ Urgent repeat escalates the existing alert" << endl;
+    
+    // Manual alerts are always distinct
+    cout.setstate(ios::failbit);
+    pq.insert(Alert(500, 301, LOW, CUSTOM, "Call family"));
+    pq.insert(Alert(501, 301, LOW, CUSTOM, "Call pharmacy"));
+    cout.clear();
+    assert(pq.contains(500) && pq.contains(501));
+    cout << "✓ CUSTOM alerts never coalesce" << endl;
+    
+    // Producers learn only the ID they submitted; it keeps addressing the
+    // merged alert until that alert leaves the queue
+    cout.setstate(ios::failbit);
+    assert(pq.acknowledge(55, "Nurse Kim", t0 + 200));
+    cout.clear();
+    assert(pq.getAlert(10, merged) && merged.acknowledged && merged.acknowledgedBy == "Nurse Kim");
+    assert(pq.getAlert(55, merged) && merged.alertID == 10);
+    cout.setstate(ios::failbit);
+    assert(pq.updatePriority(400, LOW) && pq.getAlert(300, merged) && merged.priority == LOW);
+    assert(pq.remove(99) && !pq.contains(10));
+    cout.clear();
+    assert(!pq.contains(55) && pq.resolveAlertID(55) == 55 && !pq.remove(99));
+    cout << "✓ A coalesced repeat is acked, updated and removed by its own ID" << endl;
+    
+    cout << "\n✅ Test 11 Passed!" << endl;
+}
+
+// Test 12: Coalesced State on Disk
+void test12_CoalescedPersistence() {
+    cout << "\n========== TEST 12: Coalesced State on Disk ==========" << endl;
+    
+    const string path = "test_pq_coalesce.bin";
+    remove(path.c_str());
+    remove((path + ".journal").c_str());
+    
+    // Merges are journaled, so they survive a crash
+    PriorityQueue* crashed = new PriorityQueue(path);
+    crashed->setCoalesceWindow(30);
+    cout.setstate(ios::failbit);
+    for (int i = 0; i < 20; i++) {
+        Alert alert(1 + i, 401, MEDIUM, EQUIPMENT_FAILURE, "ECG lead off");
+        alert.timestamp = 1733270400 + i * 5;
+        crashed->insert(alert);
+    }
+    cout.clear();
+    assert(crashed->size() == 1);
+    
+    Alert found;
+    {
+        cout.setstate(ios::failbit);
+        PriorityQueue recovered(path);
+        cout.clear();
+        assert(recovered.size() == 1 && recovered.getAlert(1, found));
+        assert(found.occurrenceCount == 20 && found.getLastSeenTime() == 1733270400 + 95);
+        assert(recovered.getAlert(20, found) && found.alertID == 1);
+        cout << "✓ Occurrence count and last-seen time replayed from the journal" << endl;
+    }
+    {
+        cout.setstate(ios::failbit);
+        PriorityQueue reloaded(path);
+        cout.clear();
+        assert(reloaded.getAlert(1, found) && found.occurrenceCount == 20);
+        assert(reloaded.resolveAlertID(12) == 1);
+        cout << "✓ Versioned snapshot keeps the merged counts" << endl;
+    }
+    delete crashed;
+    
+    // Snapshots written before the coalescing fields still load
+    {
+        Alert legacy(7, 402, HIGH, LAB_CRITICAL, "Potassium 6.8");
+        ostringstream encoded;
+        legacy.writeToDisk(encoded);
+        string bytes = encoded.str();
+        bytes.resize(bytes.size() - sizeof(legacy.occurrenceCount) - sizeof(legacy.lastSeenTime));
+        
+        ofstream file(path, ios::binary | ios::trunc);
+        int numAlerts = 1;
+        file.write(reinterpret_cast<const char*>(&numAlerts), sizeof(numAlerts));
+        file.write(bytes.data(), bytes.size());
+    }
+    remove((path + ".journal").c_str());
+    {
+        cout.setstate(ios::failbit);
+        PriorityQueue upgraded(path);
+        cout.clear();
+        assert(upgraded.size() == 1 && upgraded.getAlert(7, found));
+        assert(found.message == "Potassium 6.8" && found.occurrenceCount == 1);
+        cout << "✓ Version 1 snapshot loads with one occurrence per alert" << endl;
+    }
+    
+    remove(path.c_str());
+    remove((path + ".journal").c_str());
+    
+    cout << "\n✅ Test 12 Passed!" << endl;
+}
+
+// ==================== TEST 13: Paginated Queries ====================
+void test13_PaginatedQuery() {
+    cout << "\n========== TEST 13: Top-k and Paginated Queries ==========" << endl;
+    
+    PriorityQueue pq;
+    cout.setstate(ios::failbit);
+    for (int i = 1; i <= 3000; i++) {
+        Alert alert(i, 100 + i % 25, static_cast<AlertPriority>((i * 3 % 5) + 1), VITAL_ABNORMAL, "Page");
+        // Every fourth alert arrives late, so each level has a heap part too
+        alert.timestamp = 1733270400 + (i % 4 == 0 ? i / 3 : i);
+        pq.insert(alert);
+    }
+    for (int i = 1; i <= 3000; i += 11) pq.acknowledge(i, "Nurse Joy", 1733280000);
+    for (int i = 5; i <= 3000; i += 13) pq.remove(i);
+    cout.clear();
+    
+    // Reference answer: filter the full snapshot
+    vector<int> expected;
+    for (const auto& alert : *pq.getSortedSnapshot()) {
+        if (alert.priority <= HIGH && !alert.acknowledged) expected.push_back(alert.alertID);
+    }
+    
+    AlertQuery query;
+    query.limit = 7;
+    query.minPriority = HIGH;
+    query.unacknowledgedOnly = true;
+    
+    vector<int> paged;
+    int pages = 0;
+    while (true) {
+        AlertPage page = pq.query(query);
+        for (const auto& alert : page.alerts) paged.push_back(alert.alertID);
+        pages++;
+        if (!page.hasMore) break;
+        
+        AlertCursor parsed;
+        assert(AlertCursor::parse(page.next.toString(), parsed));
+        query.after = parsed;
+    }
+    assert(paged == expected);
+    cout << "✓ " << pages << " cursor pages of 7 reproduce the filtered snapshot ("
+         << expected.size() << " alerts)" << endl;
+    
+    AlertQuery window;
+    window.limit = 10;
+    window.offset = 15;
+    window.minPriority = HIGH;
+    window.unacknowledgedOnly = true;
+    AlertPage page = pq.query(window);
+    assert(page.alerts.size() == 10 && page.hasMore);
+    for (int j = 0; j < 10; j++) assert(page.alerts[j].alertID == expected[15 + j]);
+    cout << "✓ limit/offset returns the matching slice" << endl;
+    
+    // The cursor holds a position, not an alert: removing the last alert
+    // of a page does not disturb the next one
+    AlertQuery first;
+    first.limit = 5;
+    first.minPriority = HIGH;
+    first.unacknowledgedOnly = true;
+    AlertPage firstPage = pq.query(first);
+    cout.setstate(ios::failbit);
+    pq.remove(firstPage.alerts.back().alertID);
+    cout.clear();
+    first.after = firstPage.next;
+    AlertPage secondPage = pq.query(first);
+    for (int j = 0; j < 5; j++) assert(secondPage.alerts[j].alertID == expected[5 + j]);
+    cout << "✓ Next page is unaffected by removing the cursor's alert" << endl;
+    
+    AlertCursor bad;
+    assert(!AlertCursor::parse("", bad) && !AlertCursor::parse("9.1.1", bad) && !AlertCursor::parse("1.2.3x", bad));
+    cout << "✓ Malformed cursors are rejected" << endl;
+    
+    // Top 20 costs the same with a 1,000 or a 200,000 alert backlog
+    auto topTwentyMicros = [](int backlog) {
+        PriorityQueue queue;
+        vector<Alert> batch;
+        for (int i = 1; i <= backlog; i++) {
+            Alert alert(i, 100 + i % 40, static_cast<AlertPriority>((i % 5) + 1), VITAL_ABNORMAL, "Backlog");
+            alert.timestamp = 1733270400 + i;
+            batch.push_back(alert);
+        }
+        cout.setstate(ios::failbit);
+        queue.insertBatch(batch);
+        cout.clear();
+        
+        AlertQuery top;
+        top.limit = 20;
+        const int rounds = 2000;
+        auto start = chrono::high_resolution_clock::now();
+        for (int r = 0; r < rounds; r++) {
+            assert(queue.query(top).alerts.size() == 20);
+        }
+        return chrono::duration<double, micro>(chrono::high_resolution_clock::now() - start).count() / rounds;
+    };
+    double small = topTwentyMicros(1000);
+    double large = topTwentyMicros(200000);
+    cout << "✓ Top 20: " << small << " µs with 1k alerts, " << large << " µs with 200k" << endl;
+    assert(large < small * 5 + 5);
+    
+    // Unacknowledged top 20 over an acknowledged backlog: same cost with
+    // 1,000 or 200,000 acknowledged alerts ahead of the open ones
+    auto openTwentyMicros = [](int backlog) {
+        PriorityQueue queue;
+        vector<Alert> batch;
+        for (int i = 1; i <= backlog + 40; i++) {
+            Alert alert(i, 100 + i % 40, static_cast<AlertPriority>((i % 5) + 1), VITAL_ABNORMAL, "Backlog");
+            alert.timestamp = 1733270400 + i;
+            batch.push_back(alert);
+        }
+        cout.setstate(ios::failbit);
+        queue.insertBatch(batch);
+        for (int i = 1; i <= backlog; i++) queue.acknowledge(i, "Nurse Joy", 1733280000);
+        cout.clear();
+        
+        vector<int> expected;
+        for (const auto& alert : *queue.getSortedSnapshot()) {
+            if (!alert.acknowledged) expected.push_back(alert.alertID);
+        }
+        AlertQuery open;
+        open.limit = 20;
+        open.unacknowledgedOnly = true;
+        vector<int> paged;
+        while (true) {
+            AlertPage page = queue.query(open);
+            for (const auto& alert : page.alerts) paged.push_back(alert.alertID);
+            if (!page.hasMore) break;
+            open.after = page.next;
+        }
+        assert(paged == expected && paged.size() == 40);
+        
+        open.after = AlertCursor();
+        const int rounds = 2000;
+        auto start = chrono::high_resolution_clock::now();
+        for (int r = 0; r < rounds; r++) {
+            assert(queue.query(open).alerts.size() == 20);
+        }
+        return chrono::duration<double, micro>(chrono::high_resolution_clock::now() - start).count() / rounds;
+    };
+    small = openTwentyMicros(1000);
+    large = openTwentyMicros(200000);
+    cout << "✓ Unacknowledged top 20: " << small << " µs behind 1k acknowledged, "
+         << large << " µs behind 200k" << endl;
+    assert(large < small * 5 + 5);
+    
+    cout << "\n✅ Test 13 Passed!" << endl;
+}
+
+// ==================== TEST 14: Secondary Indexes ====================
+void test14_SecondaryIndexes() {
+    cout << "\n========== TEST 14: Patient / Ward / Type Indexes ==========" << endl;
+    
+    const char* wards[] = {"ICU-A", "ICU-B", "CCU", "NICU"};
+    unordered_map<int, string> wardOf;
+    for (int p = 100; p < 300; p++) wardOf[p] = wards[p % 4];
+    
+    PriorityQueue pq;
+    pq.setWardResolver([&wardOf](int patientID) { return wardOf[patientID]; });
+    
+    cout.setstate(ios::failbit);
+    for (int i = 1; i <= 20000; i++) {
+        Alert alert(i, 100 + i % 200, static_cast<AlertPriority>((i * 7 % 5) + 1),
+                    static_cast<AlertType>(i % 7), "Indexed");
+        alert.timestamp = 1733270400 + (i % 9 == 0 ? i / 2 : i);
+        pq.insert(alert);
+    }
+    for (int i = 1; i <= 20000; i += 3) pq.acknowledge(i, "Nurse Joy", 1733290000);
+    for (int i = 2; i <= 20000; i += 17) pq.remove(i);
+    for (int i = 0; i < 500; i++) pq.extractMin();
+    Alert moved(40, 101, HIGH, LAB_CRITICAL, "Replaced");    // Same ID, new patient
+    moved.timestamp = 1733270400;
+    pq.insert(moved);
+    cout.clear();
+    
+    // Reference: filter the full snapshot
+    auto expect = [&](int patientID, const string& ward, int type, bool unackOnly, AlertPriority minPriority) {
+        vector<int> ids;
+        for (const auto& alert : *pq.getSortedSnapshot()) {
+            if (patientID >= 0 && alert.patientID != patientID) continue;
+            if (!ward.empty() && wardOf[alert.patientID] != ward) continue;
+            if (type >= 0 && alert.type != type) continue;
+            if (unackOnly && alert.acknowledged) continue;
+            if (alert.priority > minPriority) continue;
+            ids.push_back(alert.alertID);
+        }
+        return ids;
+    };
+    auto run = [&](const AlertQuery& query) {
+        vector<int> ids;
+        for (const auto& alert : pq.query(query).alerts) ids.push_back(alert.alertID);
+        return ids;
+    };
+    
+    AlertQuery byPatient;
+    byPatient.patientID = 101;
+    vector<int> patientAlerts = run(byPatient);
+    assert(patientAlerts == expect(101, "", -1, false, INFO));
+    assert(find(patientAlerts.begin(), patientAlerts.end(), 40) != patientAlerts.end());
+    cout << "✓ Patient 101: " << patientAlerts.size() << " alerts, including a replaced one" << endl;
+    
+    AlertQuery byWard;
+    byWard.ward = "ICU-B";
+    byWard.unacknowledgedOnly = true;
+    byWard.minPriority = HIGH;
+    assert(run(byWard) == expect(-1, "ICU-B", -1, true, HIGH));
+    
+    AlertQuery byType;
+    byType.type = DRUG_INTERACTION;
+    byType.ward = "CCU";
+    assert(run(byType) == expect(-1, "CCU", DRUG_INTERACTION, false, INFO));
+    
+    AlertQuery nobody;
+    nobody.patientID = 999;
+    assert(pq.query(nobody).alerts.empty());
+    cout << "✓ Ward, type, ack and priority filters combine" << endl;
+    
+    // Indexed pages chain through the cursor like unfiltered ones
+    vector<int> paged;
+    AlertQuery page;
+    page.ward = "NICU";
+    page.limit = 50;
+    while (true) {
+        AlertPage result = pq.query(page);
+        for (const auto& alert : result.alerts) paged.push_back(alert.alertID);
+        if (!result.hasMore) break;
+        page.after = result.next;
+    }
+    assert(paged == expect(-1, "NICU", -1, false, INFO));
+    cout << "✓ " << paged.size() << " NICU alerts paged in extraction order" << endl;
+    
+    vector<int> unacked;
+    for (const auto& alert : pq.getUnacknowledgedAlerts()) unacked.push_back(alert.alertID);
+    assert(unacked == expect(-1, "", -1, true, INFO));
+    cout << "✓ getUnacknowledgedAlerts served from the ack-state index" << endl;
+    
+    // A transfer moves the patient's alerts to the new ward's index
+    wardOf[101] = "CCU";
+    pq.reindexPatient(101);
+    AlertQuery ccu;
+    ccu.ward = "CCU";
+    ccu.patientID = 101;
+    assert(run(ccu) == patientAlerts);
+    byWard.ward = "ICU-B";
+    byWard.unacknowledgedOnly = false;
+    byWard.minPriority = INFO;
+    byWard.patientID = 101;
+    assert(run(byWard).empty());
+    cout << "✓ reindexPatient follows a ward transfer" << endl;
+    
+    // A bed panel costs the same whatever the backlog elsewhere
+    auto bedPanelMicros = [](int backlog) {
+        PriorityQueue queue;
+        vector<Alert> batch;
+        for (int i = 1; i <= backlog; i++) {
+            Alert alert(i, i <= 10 ? 7 : 1000 + i % 500, static_cast<AlertPriority>((i % 5) + 1),
+                        VITAL_ABNORMAL, "Backlog");
+            alert.timestamp = 1733270400 + i;
+            batch.push_back(alert);
+        }
+        cout.setstate(ios::failbit);
+        queue.insertBatch(batch);
+        cout.clear();
+        
+        AlertQuery bed;
+        bed.patientID = 7;
+        const int rounds = 2000;
+        auto start = chrono::high_resolution_clock::now();
+        for (int r = 0; r < rounds; r++) {
+            assert(queue.query(bed).alerts.size() == 10);
+        }
+        return chrono::duration<double, micro>(chrono::high_resolution_clock::now() - start).count() / rounds;
+    };
+    double small = bedPanelMicros(1000);
+    double large = bedPanelMicros(200000);
+    cout << "✓ 10-alert bed panel: " << small << " µs with 1k alerts, " << large << " µs with 200k" << endl;
+    assert(large < small * 5 + 5);
+    
+    cout << "\n✅ Test 14 Passed!" << endl;
+}
+
+// ==================== TEST 15: Alert ID High-Water Mark ====================
+void test15_AlertIDHighWater() {
+    cout << "\n========== TEST 15: Alert ID High-Water Mark ==========" << endl;
+    
+    const string path = "test_pq_highwater.bin";
+    remove(path.c_str());
+    remove((path + ".journal").c_str());
+    
+    {
+        cout.setstate(ios::failbit);
+        PriorityQueue pq(path);
+        pq.setCoalesceWindow(60);
+        for (int id = 1; id <= 5; id++) {
+            Alert alert(id, 500 + id, HIGH, LAB_CRITICAL, "Troponin rising");
+            alert.timestamp = 1733270400 + id;
+            pq.insert(alert);
+        }
+        Alert repeat(9, 501, HIGH, LAB_CRITICAL, "Troponin rising");
+        repeat.timestamp = 1733270410;
+        assert(pq.insert(repeat) == 1);
+        pq.remove(5);
+        pq.extractMin();
+        cout.clear();
+        assert(pq.getMaxAlertID() == 9);
+        cout << "✓ Merged, removed and extracted IDs all count toward the high-water mark" << endl;
+    }
+    {
+        cout.setstate(ios::failbit);
+        PriorityQueue recovered(path);
+        cout.clear();
+        assert(recovered.size() == 3);
+        assert(recovered.getMaxAlertID() == 9);
+        cout << "✓ High-water mark replayed from the journal" << endl;
+    }
+    {
+        cout.setstate(ios::failbit);
+        PriorityQueue reloaded(path);
+        reloaded.clear();
+        reloaded.saveToDisk();
+        cout.clear();
+        assert(reloaded.size() == 0 && reloaded.getMaxAlertID() == 9);
+    }
+    {
+        cout.setstate(ios::failbit);
+        PriorityQueue emptied(path);
+        cout.clear();
+        assert(emptied.size() == 0 && emptied.getMaxAlertID() == 9);
+        cout << "✓ An empty queue's snapshot still keeps the high-water mark" << endl;
+    }
+    
+    remove(path.c_str());
+    remove((path + ".journal").c_str());
+    
+    cout << "\n✅ Test 15 Passed!" << endl;
+}
+
 int main() {
     cout << "╔══════════════════════════════════════════════════════╗" << endl;
     cout << "║   PRIORITY QUEUE (MIN-HEAP) TEST SUITE             ║" << endl;
@@ -244,17 +999,30 @@ int main() {
     test4_FilterQuery();
     test5_Performance();
     test6_HeapProperty();
+    test7_SortedSnapshot();
+    test8_IndexedUpdates();
+    test9_Journal();
+    test10_AlertStorm();
+    test11_Coalescing();
+    test12_CoalescedPersistence();
+    test13_PaginatedQuery();
+    test14_SecondaryIndexes();
+    test15_AlertIDHighWater();
     
     cout << "\n\n╔══════════════════════════════════════════════════════╗" << endl;
     cout << "║    ALL TESTS PASSED SUCCESSFULLY!                 ║" << endl;
     cout << "║                                                      ║" << endl;
     cout << "║   Priority Queue Features:                          ║" << endl;
-    cout << "║   ✓ O(log n) insertion                              ║" << endl;
-    cout << "║   ✓ O(log n) extraction                             ║" << endl;
+    cout << "║   ✓ O(1) insertion (bucket per priority level)      ║" << endl;
+    cout << "║   ✓ O(1) extraction via non-empty level bitmask     ║" << endl;
     cout << "║   ✓ O(1) peek minimum                               ║" << endl;
     cout << "║   ✓ Disk persistence                                ║" << endl;
     cout << "║   ✓ Priority-based ordering                         ║" << endl;
     cout << "║   ✓ Min-heap property maintained                    ║" << endl;
+    cout << "║   ✓ Cached read-only sorted snapshot                ║" << endl;
+    cout << "║   ✓ O(1) ack/update/remove by alert ID              ║" << endl;
+    cout << "║   ✓ Append-only journal with crash recovery         ║" << endl;
+    cout << "║   ✓ Coalescing of repeated alerts                   ║" << endl;
     cout << "╚══════════════════════════════════════════════════════╝" << endl;
     
     return 0;
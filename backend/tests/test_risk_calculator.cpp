@@ -0,0 +1,287 @@
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <thread>
+#include <algorithm>
+#include "risk_calculator.h"
+
+using namespace std;
+
+long createTimestamp(int hour, int minute, int second = 0) {
+    long baseTime = 1733270400; // Dec 4, 2024, 00:00:00
+    return baseTime + (hour * 3600) + (minute * 60) + second;
+}
+
+// ==================== TEST 1: Circular Buffer ====================
+void test1_CircularBuffer() {
+    cout << "\n========== TEST 1: Circular Buffer ==========" << endl;
+    
+    CircularBuffer<int> ring(4);
+    assert(ring.empty());
+    for (int i = 1; i <= 3; i++) ring.push(i);
+    assert(ring.size() == 3 && ring.front() == 1 && ring.back() == 3);
+    cout << "✓ Push below capacity keeps insertion order" << endl;
+    
+    for (int i = 4; i <= 6; i++) ring.push(i);
+    assert(ring.full() && ring.size() == 4);
+    assert(ring[0] == 3 && ring[3] == 6);
+    
+    vector<int> lastTwo = ring.toVector(2);
+    assert(lastTwo.size() == 2 && lastTwo[0] == 5 && lastTwo[1] == 6);
+    cout << "✓ Full buffer overwrites the oldest elements" << endl;
+    
+    ring.clear();
+    assert(ring.empty() && ring.toVector().empty());
+    cout << "✓ Clear empties the buffer" << endl;
+    
+    cout << "\n✅ Test 1 Passed!" << endl;
+}
+
+// ==================== TEST 2: NEWS2 Scoring ====================
+void test2_Scoring() {
+    cout << "\n========== TEST 2: NEWS2 Scoring ==========" << endl;
+    
+    assert(RiskCalculator::scoreHeartRate(40) == 3);
+    assert(RiskCalculator::scoreHeartRate(75) == 0);
+    assert(RiskCalculator::scoreHeartRate(111) == 2);
+    assert(RiskCalculator::scoreSystolic(95) == 2);
+    assert(RiskCalculator::scoreSystolic(220) == 3);
+    assert(RiskCalculator::scoreSpO2(94) == 1);
+    assert(RiskCalculator::scoreSpO2(91) == 3);
+    assert(RiskCalculator::scoreTemperature(36.5f) == 0);
+    assert(RiskCalculator::scoreTemperature(39.2f) == 2);
+    cout << "✓ Parameter bands match NEWS2" << endl;
+    
+    VitalRecord stable(101, createTimestamp(9, 0), 75, 125, 80, 97, 37.0);
+    EarlyWarningScore s = RiskCalculator::score(stable);
+    assert(s.total == 0 && s.level == RISK_LOW);
+    
+    VitalRecord hypoxic(101, createTimestamp(9, 1), 75, 125, 80, 90, 37.0);
+    s = RiskCalculator::score(hypoxic);
+    assert(s.total == 3 && s.level == RISK_LOW_MEDIUM);
+    
+    VitalRecord septic(101, createTimestamp(9, 2), 125, 98, 60, 93, 39.3);
+    s = RiskCalculator::score(septic);
+    assert(s.total == 8 && s.level == RISK_HIGH);
+    cout << "✓ Aggregate scores map to risk bands (0 LOW, 3 LOW-MEDIUM, 8 HIGH)" << endl;
+    
+    cout << "\n✅ Test 2 Passed!" << endl;
+}
+
+// ==================== TEST 3: Streaming Escalation ====================
+void test3_Escalation() {
+    cout << "\n========== TEST 3: Streaming Escalation ==========" << endl;
+    
+    string testFile = "test_news2_scores.bin";
+    remove(testFile.c_str());
+    
+    {
+        RiskCalculator calculator(testFile);
+        
+        assert(!calculator.update(VitalRecord(101, createTimestamp(10, 0), 75, 125, 80, 97, 37.0)).escalated);
+        
+        // Worsening: MEDIUM (5) then HIGH (8) each escalate once
+        ScoreUpdate medium = calculator.update(VitalRecord(101, createTimestamp(10, 5), 115, 98, 70, 95, 37.0));
+        assert(medium.escalated && medium.score.total == 5 && medium.score.level == RISK_MEDIUM);
+        assert(medium.previousLevel == RISK_LOW);
+        ScoreUpdate worse = calculator.update(VitalRecord(101, createTimestamp(10, 10), 125, 98, 60, 93, 39.3));
+        assert(worse.escalated && worse.score.level == RISK_HIGH);
+        assert(RiskCalculator::alertPriority(worse.score.level) == CRITICAL);
+        
+        // Holding at HIGH does not re-alert
+        ScoreUpdate steady = calculator.update(VitalRecord(101, createTimestamp(10, 15), 128, 95, 60, 92, 39.4));
+        assert(!steady.escalated && steady.score.level == RISK_HIGH);
+        cout << "✓ Alerts fire only when the risk band rises" << endl;
+        
+        // Back-filled reading is scored but does not change state
+        ScoreUpdate late = calculator.update(VitalRecord(101, createTimestamp(9, 0), 75, 125, 80, 97, 37.0));
+        assert(!late.escalated);
+        EarlyWarningScore latest;
+        assert(calculator.getLatest(101, latest) && latest.level == RISK_HIGH);
+        assert(calculator.getHistory(101).size() == 4);
+        cout << "✓ Late readings leave the current score untouched" << endl;
+        
+        // Recovery re-arms the alert
+        calculator.update(VitalRecord(101, createTimestamp(10, 20), 80, 120, 80, 97, 37.0));
+        assert(calculator.update(VitalRecord(101, createTimestamp(10, 25), 125, 98, 60, 93, 39.3)).escalated);
+        cout << "✓ Recovery re-arms the deterioration alert" << endl;
+    }
+    
+    {
+        RiskCalculator calculator(testFile);
+        EarlyWarningScore latest;
+        assert(calculator.getLatest(101, latest));
+        assert(latest.total == 8 && latest.timestamp == createTimestamp(10, 25));
+        assert(calculator.getHistory(101, 3).size() == 3);
+        cout << "✓ Score history persists across restart" << endl;
+    }
+    
+    remove(testFile.c_str());
+    remove((testFile + ".log").c_str());
+    cout << "\n✅ Test 3 Passed!" << endl;
+}
+
+// ==================== TEST 4: Ingest Cost ====================
+void test4_IngestCost() {
+    cout << "\n========== TEST 4: Ingest Cost ==========" << endl;
+    
+    RiskCalculator calculator;
+    const int READINGS = 200000;
+    
+    auto start = chrono::high_resolution_clock::now();
+    for (int i = 0; i < READINGS; i++) {
+        VitalRecord r(100 + i % 50, createTimestamp(0, 0, i), 60 + i % 80, 90 + i % 60, 70, 88 + i % 12, 36.0f + (i % 30) * 0.1f);
+        calculator.update(r);
+    }
+    auto end = chrono::high_resolution_clock::now();
+    double microsPerUpdate = chrono::duration<double, micro>(end - start).count() / READINGS;
+    
+    assert(calculator.getPatientCount() == 50);
+    assert(calculator.getHistory(100).size() == RISK_HISTORY_CAPACITY);
+    assert(microsPerUpdate < 50.0);
+    cout << "✓ " << READINGS << " updates at " << microsPerUpdate << " µs each" << endl;
+    cout << "✓ History bounded at " << RISK_HISTORY_CAPACITY << " scores per patient" << endl;
+    
+    cout << "\n✅ Test 4 Passed!" << endl;
+}
+
+// ==================== TEST 5: Crash Recovery ====================
+void test5_CrashRecovery() {
+    cout << "\n========== TEST 5: Crash Recovery ==========" << endl;
+    
+    string testFile = "test_news2_crash.bin";
+    string crashFile = "test_news2_crash_copy.bin";
+    for (const string& base : {testFile, crashFile}) {
+        for (const char* suffix : {"", ".log", ".log.old"}) {
+            remove((base + suffix).c_str());
+        }
+    }
+    
+    auto copyFile = [](const string& from, const string& to) {
+        ifstream in(from, ios::binary);
+        ofstream out(to, ios::binary);
+        out << in.rdbuf();
+    };
+    
+    {
+        RiskCalculator calculator(testFile);
+        calculator.update(VitalRecord(201, createTimestamp(8, 0), 75, 125, 80, 97, 37.0));
+        assert(calculator.update(VitalRecord(201, createTimestamp(8, 5), 125, 98, 60, 93, 39.3)).escalated);
+        calculator.update(VitalRecord(202, createTimestamp(8, 5), 115, 98, 70, 95, 37.0));
+        
+        // Copy the files while the calculator is still running, as a
+        // killed server would leave them
+        copyFile(testFile, crashFile);
+        copyFile(testFile + ".log", crashFile + ".log");
+    }
+    
+    {
+        RiskCalculator recovered(crashFile);
+        EarlyWarningScore latest;
+        assert(recovered.getLatest(201, latest) && latest.level == RISK_HIGH);
+        assert(recovered.getHistory(201).size() == 2);
+        assert(recovered.getLatest(202, latest) && latest.level == RISK_MEDIUM);
+        assert(!recovered.update(VitalRecord(201, createTimestamp(8, 10), 128, 95, 60, 92, 39.4)).escalated);
+        cout << "✓ Risk levels survive without a clean shutdown; no duplicate alert" << endl;
+    }
+    
+    // A compaction that renamed the snapshot but never truncated the log
+    // replays scores the snapshot already holds
+    {
+        RiskCalculator calculator(testFile);
+        calculator.saveToDisk();
+        ofstream log(testFile + ".log", ios::binary | ios::app);
+        int patientID = 201;
+        EarlyWarningScore latest;
+        assert(calculator.getLatest(201, latest));
+        log.write(reinterpret_cast<const char*>(&patientID), sizeof(patientID));
+        latest.writeToDisk(log);
+        log.close();
+        
+        RiskCalculator reopened(testFile);
+        assert(reopened.getHistory(201).size() == 2);
+        cout << "✓ Scores already in the snapshot are not replayed twice" << endl;
+    }
+    
+    {
+        RiskCalculator calculator(testFile);
+        for (int i = 0; i < RISK_LOG_COMPACT_MIN + 10; i++) {
+            calculator.update(VitalRecord(300 + i % 4, createTimestamp(9, 0, i), 80, 120, 80, 97, 37.0));
+        }
+        const long entrySize = sizeof(int) + sizeof(long) + 6 * sizeof(int);
+        ifstream log(testFile + ".log", ios::binary | ios::ate);
+        assert(log.tellg() < static_cast<streamoff>(100 * entrySize));
+        cout << "✓ A full log is rotated aside on the update path" << endl;
+        
+        // A crash at any point of the background merge: the rotated log is
+        // copied before the snapshot it is being merged into
+        copyFile(testFile + ".log.old", crashFile + ".log.old");
+        copyFile(testFile, crashFile);
+        copyFile(testFile + ".log", crashFile + ".log");
+        {
+            RiskCalculator recovered(crashFile);
+            assert(recovered.getHistory(303).size() == RISK_HISTORY_CAPACITY);
+            assert(!ifstream(crashFile + ".log.old").good());
+        }
+        cout << "✓ Snapshot, rotated log and live log recover together" << endl;
+        
+        auto deadline = chrono::steady_clock::now() + chrono::seconds(5);
+        while (ifstream(testFile + ".log.old").good() && chrono::steady_clock::now() < deadline) {
+            this_thread::sleep_for(chrono::milliseconds(5));
+        }
+        assert(!ifstream(testFile + ".log.old").good());
+        copyFile(testFile, crashFile);
+        remove((crashFile + ".log").c_str());
+        RiskCalculator merged(crashFile);
+        assert(merged.getHistory(303).size() == RISK_HISTORY_CAPACITY);
+        cout << "✓ The compactor merges the rotated log into the snapshot" << endl;
+    }
+    
+    // Ingest cost with the log and compactions running
+    {
+        RiskCalculator calculator(testFile);
+        const int READINGS = 40000;
+        double worstMicros = 0;
+        auto start = chrono::high_resolution_clock::now();
+        for (int i = 0; i < READINGS; i++) {
+            VitalRecord r(400 + i % 50, createTimestamp(12, 0, i), 60 + i % 80, 90 + i % 60, 70, 88 + i % 12, 37.0);
+            auto before = chrono::high_resolution_clock::now();
+            calculator.update(r);
+            double micros = chrono::duration<double, micro>(chrono::high_resolution_clock::now() - before).count();
+            worstMicros = max(worstMicros, micros);
+        }
+        double microsPerUpdate = chrono::duration<double, micro>(chrono::high_resolution_clock::now() - start).count() / READINGS;
+        assert(microsPerUpdate < 50.0);
+        cout << "✓ Logged updates at " << microsPerUpdate << " µs each (worst " << worstMicros << " µs)" << endl;
+    }
+    
+    for (const string& base : {testFile, crashFile}) {
+        for (const char* suffix : {"", ".log", ".log.old"}) {
+            remove((base + suffix).c_str());
+        }
+    }
+    cout << "\n✅ Test 5 Passed!" << endl;
+}
+
+int main() {
+    cout << "╔══════════════════════════════════════════════════════╗" << endl;
+    cout << "║   NEWS2 RISK CALCULATOR TEST SUITE                  ║" << endl;
+    cout << "║   IntelliCare ICU - Early Warning Scores            ║" << endl;
+    cout << "╚══════════════════════════════════════════════════════╝" << endl;
+    
+    test1_CircularBuffer();
+    test2_Scoring();
+    test3_Escalation();
+    test4_IngestCost();
+    test5_CrashRecovery();
+    
+    cout << "\n\n╔══════════════════════════════════════════════════════╗" << endl;
+    cout << "║    ALL TESTS PASSED SUCCESSFULLY!                 ║" << endl;
+    cout << "╚══════════════════════════════════════════════════════╝" << endl;
+    
+    return 0;
+}
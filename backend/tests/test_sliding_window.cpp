@@ -0,0 +1,209 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include <thread>
+#include "sliding_window_stats.h"
+
+using namespace std;
+
+long createTimestamp(int hour, int minute, int second = 0) {
+    long baseTime = 1733270400; // Dec 4, 2024, 00:00:00
+    return baseTime + (hour * 3600) + (minute * 60) + second;
+}
+
+bool near(double a, double b, double tolerance = 1e-6) {
+    return fabs(a - b) <= tolerance;
+}
+
+// Reference statistics computed by re-reading the window
+WindowFieldStats bruteForce(const vector<VitalRecord>& records, long now, long windowSeconds, VitalField field) {
+    vector<pair<double, double>> points;
+    for (const auto& r : records) {
+        if (r.timestamp > now - windowSeconds && r.timestamp <= now) {
+            points.push_back(make_pair(static_cast<double>(r.timestamp), r.getField(field)));
+        }
+    }
+    
+    WindowFieldStats stats;
+    if (points.empty()) return stats;
+    
+    double n = points.size(), sumX = 0, sumT = 0;
+    stats.min = stats.max = points[0].second;
+    for (const auto& p : points) {
+        sumX += p.second;
+        sumT += p.first;
+        stats.min = min(stats.min, p.second);
+        stats.max = max(stats.max, p.second);
+    }
+    stats.mean = sumX / n;
+    
+    double ssx = 0, stt = 0, stx = 0, meanT = sumT / n;
+    for (const auto& p : points) {
+        ssx += (p.second - stats.mean) * (p.second - stats.mean);
+        stt += (p.first - meanT) * (p.first - meanT);
+        stx += (p.first - meanT) * (p.second - stats.mean);
+    }
+    stats.variance = n > 1 ? ssx / (n - 1) : 0;
+    stats.slopePerMinute = stt > 0 ? 60.0 * stx / stt : 0;
+    return stats;
+}
+
+// ==================== TEST 1: Window Statistics ====================
+void test1_WindowStatistics() {
+    cout << "\n========== TEST 1: Window Statistics ==========" << endl;
+    
+    SlidingWindowStats windows;
+    vector<VitalRecord> history;
+    
+    // 90 minutes of readings every 20 s with a slow upward HR drift
+    for (int i = 0; i < 270; i++) {
+        VitalRecord r(101, createTimestamp(8, 0, i * 20), 70 + i / 10 + (i * 7) % 5,
+                      120 + (i * 3) % 11, 80, 95 + i % 4, 36.8f + (i % 6) * 0.1f);
+        history.push_back(r);
+        assert(windows.add(r));
+    }
+    
+    vector<WindowStats> stats;
+    assert(windows.getStats(101, stats));
+    assert(stats.size() == SLIDING_WINDOW_COUNT);
+    
+    long now = history.back().timestamp;
+    for (const auto& window : stats) {
+        for (int f = 0; f < WINDOW_FIELD_COUNT; f++) {
+            WindowFieldStats expected = bruteForce(history, now, window.windowSeconds, WINDOW_FIELDS[f]);
+            assert(near(window.fields[f].mean, expected.mean));
+            assert(near(window.fields[f].variance, expected.variance, 1e-4));
+            assert(window.fields[f].min == expected.min);
+            assert(window.fields[f].max == expected.max);
+            assert(near(window.fields[f].slopePerMinute, expected.slopePerMinute, 1e-4));
+        }
+    }
+    assert(stats[0].count == 15 && stats[1].count == 45 && stats[2].count == 180);
+    assert(stats[2].fields[0].slopePerMinute > 0);
+    cout << "✓ 5/15/60 min mean, variance, min, max and slope match a full re-read" << endl;
+    
+    // Only the longest window's readings are retained
+    assert(windows.getRetainedCount(101) == 180);
+    cout << "✓ Memory bounded to the 60 min window (" << windows.getRetainedCount(101) << " readings)" << endl;
+    
+    // Late reading rejected
+    assert(!windows.add(VitalRecord(101, createTimestamp(8, 0), 200, 120, 80, 95, 37.0)));
+    cout << "✓ Out-of-order reading ignored" << endl;
+    
+    cout << "\n✅ Test 1 Passed!" << endl;
+}
+
+// ==================== TEST 2: Expiry Without New Readings ====================
+void test2_Expiry() {
+    cout << "\n========== TEST 2: Expiry Without New Readings ==========" << endl;
+    
+    SlidingWindowStats windows;
+    for (int i = 0; i < 60; i++) {
+        windows.add(VitalRecord(202, createTimestamp(12, i), 80 + i, 120, 80, 97, 37.0));
+    }
+    
+    // Ten minutes after the last reading the 5 min window is empty
+    vector<WindowStats> stats;
+    assert(windows.getStats(202, stats, createTimestamp(13, 9)));
+    assert(stats[0].count == 0 && stats[0].fields[0].mean == 0);
+    assert(stats[1].count == 5);
+    assert(stats[1].fields[0].min == 135 && stats[1].fields[0].max == 139);
+    cout << "✓ Windows slide forward at query time" << endl;
+    
+    // All windows drain, then restart cleanly
+    assert(windows.getStats(202, stats, createTimestamp(15, 0)));
+    assert(stats[2].count == 0 && windows.getRetainedCount(202) == 0);
+    windows.add(VitalRecord(202, createTimestamp(15, 1), 90, 120, 80, 97, 37.0));
+    assert(windows.getStats(202, stats));
+    assert(stats[2].count == 1 && stats[2].fields[0].mean == 90 && stats[2].fields[0].variance == 0);
+    cout << "✓ Drained windows restart from the next reading" << endl;
+    
+    assert(!windows.getStats(999, stats));
+    cout << "✓ Unknown patient reports no stats" << endl;
+    
+    cout << "\n✅ Test 2 Passed!" << endl;
+}
+
+// ==================== TEST 3: Constant Cost Per Reading ====================
+void test3_ConstantCost() {
+    cout << "\n========== TEST 3: Constant Cost Per Reading ==========" << endl;
+    
+    SlidingWindowStats windows;
+    const int READINGS = 100000;
+    
+    auto start = chrono::high_resolution_clock::now();
+    for (int i = 0; i < READINGS; i++) {
+        windows.add(VitalRecord(100 + i % 20, createTimestamp(0, 0, i), 60 + i % 50, 110 + i % 30,
+                                70, 92 + i % 8, 36.5f));
+    }
+    auto end = chrono::high_resolution_clock::now();
+    double microsPerAdd = chrono::duration<double, micro>(end - start).count() / READINGS;
+    
+    // Each patient reads every 20 s, so the 60 min window holds 180
+    assert(windows.getPatientCount() == 20);
+    assert(windows.getRetainedCount(100) == 180);
+    cout << "✓ " << READINGS << " readings at " << microsPerAdd << " µs each" << endl;
+    
+    cout << "\n✅ Test 3 Passed!" << endl;
+}
+
+// ==================== TEST 4: Seeding From History ====================
+void test4_SeedFromHistory() {
+    cout << "\n========== TEST 4: Seeding From History ==========" << endl;
+    
+    // Last hour on disk, two readings sharing the latest timestamp
+    vector<VitalRecord> history;
+    for (int i = 0; i < 30; i++) {
+        history.push_back(VitalRecord(303, createTimestamp(9, i * 2), 80 + i, 120, 80, 97, 37.0));
+    }
+    history.push_back(VitalRecord(303, createTimestamp(9, 58), 110, 120, 80, 97, 37.0));
+    
+    SlidingWindowStats windows;
+    vector<WindowStats> stats;
+    assert(windows.seedIfEmpty(303, history) == 31);
+    assert(windows.seedIfEmpty(303, history) == 0);
+    assert(windows.getStats(303, stats) && stats[2].count == 31);
+    cout << "✓ A second seed of the same history adds nothing" << endl;
+    
+    // A live reading lands before the seed: history still goes in before
+    // it, less the 9:00 reading that has left the 60 min window
+    SlidingWindowStats raced;
+    assert(raced.add(VitalRecord(303, createTimestamp(10, 0), 120, 120, 80, 97, 37.0)));
+    assert(raced.seedIfEmpty(303, history) == 30);
+    assert(raced.seedIfEmpty(303, history) == 0);
+    assert(raced.getStats(303, stats) && stats[2].count == 31);
+    assert(stats[2].fields[0].max == 120 && stats[2].fields[0].min == 81);
+    cout << "✓ History is kept behind a reading ingested first" << endl;
+    
+    // Concurrent seeds count every reading once
+    SlidingWindowStats shared;
+    vector<thread> seeders;
+    for (int t = 0; t < 4; t++) {
+        seeders.push_back(thread([&shared, &history]() { shared.seedIfEmpty(303, history); }));
+    }
+    for (auto& seeder : seeders) seeder.join();
+    assert(shared.getStats(303, stats) && stats[2].count == 31);
+    cout << "✓ Concurrent seeds never double count" << endl;
+    
+    cout << "\n✅ Test 4 Passed!" << endl;
+}
+
+int main() {
+    cout << "╔══════════════════════════════════════════════════════╗" << endl;
+    cout << "║   SLIDING WINDOW STATISTICS TEST SUITE              ║" << endl;
+    cout << "║   IntelliCare ICU - Bedside Trends                  ║" << endl;
+    cout << "╚══════════════════════════════════════════════════════╝" << endl;
+    
+    test1_WindowStatistics();
+    test2_Expiry();
+    test3_ConstantCost();
+    test4_SeedFromHistory();
+    
+    cout << "\n\n╔══════════════════════════════════════════════════════╗" << endl;
+    cout << "║    ALL TESTS PASSED SUCCESSFULLY!                 ║" << endl;
+    cout << "╚══════════════════════════════════════════════════════╝" << endl;
+    
+    return 0;
+}
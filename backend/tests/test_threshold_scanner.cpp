@@ -0,0 +1,146 @@
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "threshold_scanner.h"
+
+using namespace std;
+
+long createTimestamp(int hour, int minute, int second = 0) {
+    long baseTime = 1733270400; // Dec 4, 2024, 00:00:00
+    return baseTime + (hour * 3600) + (minute * 60) + second;
+}
+
+// ==================== TEST 1: Single Reading Checks ====================
+void test1_CheckReading() {
+    cout << "\n========== TEST 1: Single Reading Checks ==========" << endl;
+    
+    VitalThresholds defaults;
+    
+    VitalRecord normal(101, createTimestamp(10, 0), 80, 120, 80, 97, 37.0);
+    assert(ThresholdScanner::checkReading(normal, defaults) == 0);
+    cout << "✓ Normal reading raises no flags" << endl;
+    
+    VitalRecord tachy(101, createTimestamp(10, 1), 135, 120, 80, 97, 37.0);
+    assert(ThresholdScanner::checkReading(tachy, defaults) == FLAG_HR_HIGH);
+    assert(ThresholdScanner::priorityFor(FLAG_HR_HIGH) == HIGH);
+    cout << "✓ Tachycardia flagged as HIGH priority" << endl;
+    
+    VitalRecord shock(101, createTimestamp(10, 2), 130, 80, 50, 89, 38.9);
+    uint8_t flags = ThresholdScanner::checkReading(shock, defaults);
+    assert(flags == (FLAG_HR_HIGH | FLAG_SBP_LOW | FLAG_SPO2_LOW | FLAG_TEMP_HIGH));
+    assert(ThresholdScanner::priorityFor(flags) == CRITICAL);
+    
+    string message = ThresholdScanner::describe(shock, flags);
+    assert(message.find("HR high (130 bpm)") != string::npos);
+    assert(message.find("SpO2 low (89%)") != string::npos);
+    cout << "✓ Multiple abnormalities are CRITICAL: " << message << endl;
+    
+    cout << "\n✅ Test 1 Passed!" << endl;
+}
+
+// ==================== TEST 2: SIMD Kernel Matches Scalar ====================
+void test2_SIMDMatchesScalar() {
+    cout << "\n========== TEST 2: SIMD Kernel Matches Scalar ==========" << endl;
+    
+    // Odd size so the vector loop leaves a tail
+    VitalBatch batch;
+    for (int i = 0; i < 1003; i++) {
+        VitalRecord r(100 + i % 7, createTimestamp(0, 0, i), 40 + (i * 7) % 100, 80 + (i * 11) % 120,
+                      70, 85 + i % 15, 35.0f + (i % 40) * 0.1f);
+        batch.append(r);
+    }
+    
+    VitalThresholds thresholds;
+    vector<uint8_t> scalarFlags(batch.size());
+    vector<uint8_t> simdFlags(batch.size());
+    size_t scalarCount = ThresholdScanner::scanScalar(batch, thresholds, scalarFlags.data());
+    size_t simdCount = ThresholdScanner::scanSIMD(batch, thresholds, simdFlags.data());
+    
+    assert(scalarCount == simdCount);
+    assert(scalarFlags == simdFlags);
+    for (size_t i = 0; i < batch.size(); i++) {
+        assert(scalarFlags[i] == ThresholdScanner::checkReading(batch.getRecord(i), thresholds));
+    }
+    cout << "✓ " << simdCount << " of " << batch.size() << " readings flagged identically"
+         << (ThresholdScanner::hasSIMD() ? " (SSE2)" : " (scalar fallback)") << endl;
+    
+    auto abnormal = ThresholdScanner::findAbnormal(batch, thresholds);
+    assert(abnormal.size() == simdCount);
+    for (const auto& reading : abnormal) {
+        assert(reading.flags == scalarFlags[reading.index]);
+    }
+    cout << "✓ findAbnormal returns the flagged positions" << endl;
+    
+    VitalBatch empty;
+    assert(ThresholdScanner::findAbnormal(empty, thresholds).empty());
+    cout << "✓ Empty batch scans cleanly" << endl;
+    
+    cout << "\n✅ Test 2 Passed!" << endl;
+}
+
+// ==================== TEST 3: Patient & Ward Thresholds ====================
+void test3_ThresholdResolution() {
+    cout << "\n========== TEST 3: Patient & Ward Thresholds ==========" << endl;
+    
+    string testFile = "test_thresholds.bin";
+    remove(testFile.c_str());
+    
+    {
+        ThresholdScanner scanner(testFile);
+        
+        // Cardiac ward tolerates lower heart rates (beta blockers)
+        VitalThresholds cardiac;
+        cardiac.heartRateLow = 40;
+        scanner.setWardThresholds("Cardiac", cardiac);
+        
+        // COPD patient runs at lower saturation
+        VitalThresholds copd;
+        copd.spo2Low = 88;
+        scanner.setPatientThresholds(202, copd);
+        
+        VitalRecord slowHeart(101, createTimestamp(8, 0), 45, 120, 80, 97, 37.0);
+        assert(scanner.resolve(101, "ICU").heartRateLow == 50);
+        assert(ThresholdScanner::checkReading(slowHeart, scanner.resolve(101, "ICU")) == FLAG_HR_LOW);
+        assert(ThresholdScanner::checkReading(slowHeart, scanner.resolve(101, "Cardiac")) == 0);
+        cout << "✓ Ward thresholds override defaults" << endl;
+        
+        VitalRecord lowSat(202, createTimestamp(8, 0), 80, 120, 80, 89, 37.0);
+        assert(ThresholdScanner::checkReading(lowSat, scanner.resolve(202, "Cardiac")) == 0);
+        assert(scanner.resolve(202, "Cardiac").heartRateLow == 50);
+        cout << "✓ Patient thresholds override ward thresholds" << endl;
+        
+        scanner.saveToDisk();
+    }
+    
+    {
+        ThresholdScanner scanner(testFile);
+        assert(scanner.resolve(1, "Cardiac").heartRateLow == 40);
+        assert(scanner.resolve(202, "ICU").spo2Low == 88);
+        
+        scanner.clearPatientThresholds(202);
+        assert(scanner.resolve(202, "ICU").spo2Low == 92);
+        cout << "✓ Thresholds persist across restart" << endl;
+    }
+    
+    remove(testFile.c_str());
+    cout << "\n✅ Test 3 Passed!" << endl;
+}
+
+int main() {
+    cout << "╔══════════════════════════════════════════════════════╗" << endl;
+    cout << "║   THRESHOLD SCANNER TEST SUITE                      ║" << endl;
+    cout << "║   IntelliCare ICU - Abnormal Vitals Detection       ║" << endl;
+    cout << "╚══════════════════════════════════════════════════════╝" << endl;
+    
+    test1_CheckReading();
+    test2_SIMDMatchesScalar();
+    test3_ThresholdResolution();
+    
+    cout << "\n\n╔══════════════════════════════════════════════════════╗" << endl;
+    cout << "║    ALL TESTS PASSED SUCCESSFULLY!                 ║" << endl;
+    cout << "╚══════════════════════════════════════════════════════╝" << endl;
+    
+    return 0;
+}
@@ -0,0 +1,315 @@
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <random>
+#include "timer_wheel.h"
+#include "alert_escalator.h"
+
+using namespace std;
+
+// ==================== TEST 1: Deadlines Across Levels ====================
+void test1_DeadlinesAcrossLevels() {
+    cout << "\n========== TEST 1: Deadlines Across Levels ==========" << endl;
+    
+    TimerWheel wheel(1000, false);
+    
+    // Each delay sits on or next to a level boundary (64, 64^2, 64^3)
+    vector<uint64_t> delays = {1, 2, 63, 64, 65, 127, 128, 4095, 4096, 4097, 262143, 262144, 300000};
+    vector<uint64_t> firedAt(delays.size(), 0);
+    
+    for (size_t i = 0; i < delays.size(); i++) {
+        wheel.schedule(delays[i] * 1000, [&wheel, &firedAt, i]() {
+            firedAt[i] = wheel.getCurrentTick();
+        });
+    }
+    assert(wheel.getPendingCount() == delays.size());
+    
+    int fired = wheel.advance(300000);
+    assert(fired == (int)delays.size());
+    for (size_t i = 0; i < delays.size(); i++) {
+        assert(firedAt[i] == delays[i]);
+    }
+    assert(wheel.getPendingCount() == 0);
+    cout << "✓ Every timer fired on exactly its deadline tick" << endl;
+    
+    // Sub-tick delays round up and never fire on the current tick
+    bool ran = false;
+    wheel.schedule(0, [&ran]() { ran = true; });
+    wheel.schedule(1, [&ran]() { ran = true; });
+    assert(wheel.advance(1) == 2 && ran);
+    cout << "✓ Sub-tick delays fire on the next tick" << endl;
+    
+    cout << "\n✅ Test 1 Passed!" << endl;
+}
+
+// ==================== TEST 2: Cancel ====================
+void test2_Cancel() {
+    cout << "\n========== TEST 2: Cancel ==========" << endl;
+    
+    TimerWheel wheel(1000, false);
+    int fired = 0;
+    
+    TimerID nearTimer = wheel.schedule(5000, [&fired]() { fired++; });
+    TimerID farTimer = wheel.schedule(5000000, [&fired]() { fired++; });
+    TimerID kept = wheel.schedule(10000, [&fired]() { fired += 100; });
+    
+    assert(wheel.cancel(nearTimer));
+    assert(wheel.cancel(farTimer));
+    assert(!wheel.cancel(nearTimer));
+    assert(wheel.getPendingCount() == 1);
+    cout << "✓ Cancelled timers leave the wheel; a second cancel is a no-op" << endl;
+    
+    wheel.advance(20);
+    assert(fired == 100);
+    assert(!wheel.cancel(kept));
+    cout << "✓ Only the remaining timer fired; fired timers cannot be cancelled" << endl;
+    
+    // Callbacks may re-arm themselves
+    int repeats = 0;
+    function<void()> repeat = [&]() {
+        if (++repeats < 5) wheel.schedule(3000, repeat);
+    };
+    wheel.schedule(3000, repeat);
+    wheel.advance(15);
+    assert(repeats == 5);
+    cout << "✓ A callback can schedule its successor" << endl;
+    
+    cout << "\n✅ Test 2 Passed!" << endl;
+}
+
+// ==================== TEST 3: 500k Pending Timers ====================
+void test3_ManyPendingTimers() {
+    cout << "\n========== TEST 3: 500k Pending Timers ==========" << endl;
+    
+    const int TIMERS = 500000;
+    const uint64_t SPAN = 7200;    // Two hours of 1 s ticks
+    
+    TimerWheel wheel(1000, false);
+    mt19937 rng(48);
+    uniform_int_distribution<uint64_t> delayDist(1, SPAN);
+    
+    vector<uint64_t> deadlines(TIMERS);
+    vector<TimerID> ids(TIMERS);
+    long late = 0;
+    int fired = 0;
+    
+    auto start = chrono::high_resolution_clock::now();
+    for (int i = 0; i < TIMERS; i++) {
+        deadlines[i] = delayDist(rng);
+        ids[i] = wheel.schedule(deadlines[i] * 1000, [&wheel, &deadlines, &late, &fired, i]() {
+            if (wheel.getCurrentTick() != deadlines[i]) late++;
+            fired++;
+        });
+    }
+    auto scheduled = chrono::high_resolution_clock::now();
+    
+    // Cancel every other timer, as acknowledgements would
+    for (int i = 0; i < TIMERS; i += 2) {
+        assert(wheel.cancel(ids[i]));
+    }
+    auto cancelled = chrono::high_resolution_clock::now();
+    assert(wheel.getPendingCount() == (size_t)TIMERS / 2);
+    
+    wheel.advance(SPAN);
+    auto drained = chrono::high_resolution_clock::now();
+    
+    assert(fired == TIMERS / 2);
+    assert(late == 0);
+    assert(wheel.getPendingCount() == 0);
+    
+    double scheduleNs = chrono::duration<double, nano>(scheduled - start).count() / TIMERS;
+    double cancelNs = chrono::duration<double, nano>(cancelled - scheduled).count() / (TIMERS / 2);
+    double tickUs = chrono::duration<double, micro>(drained - cancelled).count() / SPAN;
+    cout << "✓ " << TIMERS << " timers scheduled at " << scheduleNs << " ns each" << endl;
+    cout << "✓ " << TIMERS / 2 << " cancelled at " << cancelNs << " ns each" << endl;
+    cout << "✓ " << SPAN << " ticks advanced at " << tickUs << " µs per tick, all on deadline" << endl;
+    
+    // An idle tick with a large pending set touches one slot only
+    for (int i = 0; i < TIMERS; i++) {
+        wheel.schedule((SPAN + i % 1000) * 1000 + 1000000, []() {});
+    }
+    auto idleStart = chrono::high_resolution_clock::now();
+    wheel.advance(60);
+    auto idleEnd = chrono::high_resolution_clock::now();
+    double idleUs = chrono::duration<double, micro>(idleEnd - idleStart).count() / 60;
+    assert(wheel.getPendingCount() == (size_t)TIMERS);
+    cout << "✓ Idle tick with " << TIMERS << " pending timers: " << idleUs << " µs" << endl;
+    
+    cout << "\n✅ Test 3 Passed!" << endl;
+}
+
+// ==================== TEST 4: Background Ticking ====================
+void test4_BackgroundTicking() {
+    cout << "\n========== TEST 4: Background Ticking ==========" << endl;
+    
+    atomic<int> fired(0);
+    {
+        TimerWheel wheel(5, true);
+        for (int i = 1; i <= 10; i++) {
+            wheel.schedule(i * 5, [&fired]() { fired++; });
+        }
+        wheel.schedule(60000, [&fired]() { fired += 1000; });
+        
+        auto deadline = chrono::steady_clock::now() + chrono::seconds(5);
+        while (fired.load() < 10 && chrono::steady_clock::now() < deadline) {
+            this_thread::sleep_for(chrono::milliseconds(5));
+        }
+        assert(fired.load() == 10);
+        assert(wheel.getPendingCount() == 1);
+    }
+    assert(fired.load() == 10);
+    cout << "✓ Background thread fires due timers; pending ones die with the wheel" << endl;
+    
+    cout << "\n✅ Test 4 Passed!" << endl;
+}
+
+// ==================== TEST 5: Alert Escalation ====================
+void test5_AlertEscalation() {
+    cout << "\n========== TEST 5: Alert Escalation ==========" << endl;
+    
+    PriorityQueue pq;
+    EscalationPolicy policy;
+    policy.mediumEscalateAfter = 300;
+    policy.highEscalateAfter = 120;
+    policy.criticalReminderEvery = 60;
+    policy.infoExpireAfter = 3600;
+    AlertEscalator escalator(pq, policy, 1000, false);
+    
+    vector<int> reminded;
+    escalator.setReminderHandler([&reminded](const Alert& alert) {
+        reminded.push_back(alert.alertID);
+    });
+    
+    Alert medium(1, 101, MEDIUM, VITAL_ABNORMAL, "HR 118");
+    Alert high(2, 102, HIGH, DRUG_INTERACTION, "Warfarin + Aspirin");
+    Alert acked(3, 103, HIGH, LAB_CRITICAL, "K+ 6.1");
+    Alert info(4, 104, INFO, CUSTOM, "Shift handover");
+    Alert low(5, 105, LOW, MEDICATION_DUE, "Vitamin D due");
+    for (const Alert& alert : {medium, high, acked, info, low}) {
+        pq.insert(alert);
+    }
+    assert(escalator.getPendingCount() == 4);
+    cout << "✓ Inserted alerts are tracked; LOW alerts need no timer" << endl;
+    
+    pq.acknowledge(3, "Nurse Joy", time(nullptr));
+    escalator.untrack(3);
+    
+    escalator.advance(119);
+    assert(escalator.getEscalatedCount() == 0);
+    escalator.advance(1);
+    Alert alert;
+    assert(pq.getAlert(2, alert) && alert.priority == CRITICAL);
+    assert(pq.getAlert(3, alert) && alert.priority == HIGH);
+    assert(escalator.getEscalatedCount() == 1);
+    cout << "✓ Unacknowledged HIGH escalated to CRITICAL at 120 s; the acknowledged one did not" << endl;
+    
+    escalator.advance(60);
+    assert(reminded.size() == 1 && reminded[0] == 2);
+    escalator.advance(120);
+    assert(reminded.size() == 3);
+    assert(pq.getAlert(1, alert) && alert.priority == HIGH);
+    cout << "✓ CRITICAL reminders every 60 s; MEDIUM escalated to HIGH at 300 s" << endl;
+    
+    pq.acknowledge(2, "Dr. Grey", time(nullptr));
+    escalator.advance(120);
+    assert(reminded.size() == 3);
+    assert(pq.getAlert(1, alert) && alert.priority == CRITICAL);
+    cout << "✓ Reminders stop once acknowledged, even without untrack()" << endl;
+    
+    escalator.advance(3600 - 420);
+    assert(!pq.contains(4));
+    assert(escalator.getExpiredCount() == 1);
+    assert(pq.contains(5));
+    cout << "✓ INFO alert expired after an hour" << endl;
+    
+    escalator.untrack(1);
+    assert(escalator.getPendingCount() == 0);
+    
+    // A restarted server counts the time alerts have already been open
+    Alert overdue(6, 106, HIGH, DETERIORATION, "NEWS2 7");
+    overdue.timestamp = time(nullptr) - 600;
+    pq.insert(overdue);
+    AlertEscalator restarted(pq, policy, 1000, false);
+    assert(restarted.trackQueued() == 2);    // Alerts 1 and 6; the rest are acknowledged or LOW
+    restarted.advance(1);
+    assert(pq.getAlert(6, alert) && alert.priority == CRITICAL);
+    cout << "✓ Overdue alerts act on the first tick after trackQueued()" << endl;
+    
+    cout << "\n✅ Test 5 Passed!" << endl;
+}
+
+// ==================== TEST 6: Coalesced Repeats and Racing Acks ====================
+void test6_CoalescedRepeats() {
+    cout << "\n========== TEST 6: Coalesced Repeats and Racing Acks ==========" << endl;
+    
+    PriorityQueue pq;
+    pq.setCoalesceWindow(3600);
+    AlertEscalator escalator(pq, EscalationPolicy(), 1000, false);
+    
+    vector<int> reminded;
+    escalator.setReminderHandler([&reminded](const Alert& alert) {
+        reminded.push_back(alert.alertID);
+    });
+    
+    long now = time(nullptr);
+    cout.setstate(ios::failbit);
+    for (int i = 0; i < 600; i++) {
+        Alert probe(100 + i, 201, MEDIUM, VITAL_ABNORMAL, "SpO2 89%");
+        probe.timestamp = now + i;
+        pq.insert(probe);
+    }
+    cout.clear();
+    assert(pq.size() == 1);
+    assert(escalator.getPendingCount() == 1);
+    cout << "✓ 600 repeats of a flapping probe leave one alert and one timer" << endl;
+    
+    Alert worse(700, 201, CRITICAL, VITAL_ABNORMAL, "SpO2 82%");
+    worse.timestamp = now + 600;
+    assert(pq.insert(worse) == 100);
+    assert(escalator.getPendingCount() == 1);
+    escalator.advance(60);
+    assert(reminded.size() == 1 && reminded[0] == 100);
+    cout << "✓ A repeat that escalates to CRITICAL re-arms the survivor's clock" << endl;
+    
+    // An ack that lands between the timer reading the alert and raising it
+    Alert medium(800, 202, MEDIUM, LAB_CRITICAL, "Lactate 2.4");
+    pq.insert(medium);
+    pq.acknowledge(800, "Nurse Joy", now);
+    Alert current;
+    bool escalated = true;
+    assert(pq.escalateIfUnacknowledged(800, current, escalated));
+    assert(!escalated && current.acknowledged && current.priority == MEDIUM);
+    assert(!pq.escalateIfUnacknowledged(999, current, escalated));
+    
+    escalator.advance(600);
+    assert(pq.getAlert(800, current) && current.priority == MEDIUM);
+    assert(escalator.getEscalatedCount() == 0);
+    escalator.untrack(100);
+    assert(escalator.getPendingCount() == 0);
+    cout << "✓ Acknowledged alerts are never escalated and not re-armed" << endl;
+    
+    cout << "\n✅ Test 6 Passed!" << endl;
+}
+
+int main() {
+    cout << "╔══════════════════════════════════════════════════════╗" << endl;
+    cout << "║   TIMER WHEEL & ESCALATION TEST SUITE               ║" << endl;
+    cout << "║   IntelliCare ICU - Alert Management                ║" << endl;
+    cout << "╚══════════════════════════════════════════════════════╝" << endl;
+    
+    test1_DeadlinesAcrossLevels();
+    test2_Cancel();
+    test3_ManyPendingTimers();
+    test4_BackgroundTicking();
+    test5_AlertEscalation();
+    test6_CoalescedRepeats();
+    
+    cout << "\n\n╔══════════════════════════════════════════════════════╗" << endl;
+    cout << "║    ALL TESTS PASSED SUCCESSFULLY!                 ║" << endl;
+    cout << "╚══════════════════════════════════════════════════════╝" << endl;
+    
+    return 0;
+}
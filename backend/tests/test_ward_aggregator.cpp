@@ -0,0 +1,153 @@
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <atomic>
+#include "lsm_tree.h"
+#include "ward_aggregator.h"
+#include "rw_lock.h"
+
+using namespace std;
+
+long createTimestamp(int hour, int minute, int second = 0) {
+    long baseTime = 1733270400; // Dec 4, 2024, 00:00:00
+    return baseTime + (hour * 3600) + (minute * 60) + second;
+}
+
+void cleanupFiles(const string& basePath) {
+    remove((basePath + "_lsm_manifest.dat").c_str());
+    remove((basePath + "_lsm_manifest.dat.tmp").c_str());
+    remove((basePath + "_lsm_wal.dat").c_str());
+    for (int id = 1; id < 200; id++) {
+        remove((basePath + "_lsm_run_" + to_string(id) + ".dat").c_str());
+    }
+}
+
+// ==================== TEST 1: Thread Pool & RW Lock ====================
+void test1_ThreadPool() {
+    cout << "\n========== TEST 1: Thread Pool & RW Lock ==========" << endl;
+    
+    ThreadPool pool(4);
+    assert(pool.getThreadCount() == 4);
+    
+    vector<future<int>> results;
+    for (int i = 0; i < 100; i++) {
+        results.push_back(pool.submit([i] { return i * i; }));
+    }
+    for (int i = 0; i < 100; i++) {
+        assert(results[i].get() == i * i);
+    }
+    cout << "✓ 100 tasks return their results through futures" << endl;
+    
+    // Readers overlap; a writer excludes them
+    RWLock lock;
+    atomic<int> concurrentReaders(0);
+    atomic<int> maxReaders(0);
+    vector<future<void>> readers;
+    for (int i = 0; i < 4; i++) {
+        readers.push_back(pool.submit([&] {
+            ReadGuard guard(lock);
+            int now = ++concurrentReaders;
+            int seen = maxReaders.load();
+            while (now > seen && !maxReaders.compare_exchange_weak(seen, now)) {}
+            this_thread::sleep_for(chrono::milliseconds(50));
+            --concurrentReaders;
+        }));
+    }
+    for (auto& r : readers) r.get();
+    assert(maxReaders.load() > 1);
+    
+    {
+        WriteGuard guard(lock);
+        assert(concurrentReaders.load() == 0);
+    }
+    cout << "✓ Read guards share the lock (" << maxReaders.load() << " concurrent readers)" << endl;
+    
+    cout << "\n✅ Test 1 Passed!" << endl;
+}
+
+// ==================== TEST 2: Ward Summary ====================
+void test2_WardSummary() {
+    cout << "\n========== TEST 2: Ward Summary ==========" << endl;
+    
+    string testPath = "ward_test2";
+    cleanupFiles(testPath);
+    
+    {
+        LSMTree tree(testPath);
+        
+        // 8 beds, one reading a minute for two hours; bed 105 turns hypoxic
+        for (int minute = 0; minute < 120; minute++) {
+            for (int bed = 0; bed < 8; bed++) {
+                int spo2 = (bed == 5 && minute >= 100) ? 88 : 97;
+                VitalRecord r(100 + bed, createTimestamp(6, minute, bed), 70 + bed + minute % 5,
+                              120, 80, spo2, 37.0);
+                tree.insert(r.timestamp, r);
+            }
+        }
+        
+        ThresholdScanner scanner;
+        WardAggregator aggregator(tree, scanner, 4);
+        
+        vector<int> patientIDs;
+        for (int bed = 0; bed < 8; bed++) patientIDs.push_back(100 + bed);
+        
+        // Last hour only
+        long endTime = createTimestamp(8, 0);
+        vector<BedSummary> beds = aggregator.summarizeWard("ICU-A", patientIDs, endTime - 3600, endTime);
+        assert(beds.size() == 8);
+        
+        for (int bed = 0; bed < 8; bed++) {
+            const BedSummary& summary = beds[bed];
+            assert(summary.patientID == 100 + bed);
+            assert(summary.readingCount == 60);
+            assert(summary.hasLatest && summary.latest.timestamp == createTimestamp(7, 59, bed));
+            assert(summary.getStats(FIELD_HEART_RATE).min == 70 + bed);
+            assert(summary.getStats(FIELD_HEART_RATE).max == 74 + bed);
+            
+            // Must equal the single-threaded path
+            BedSummary serial = aggregator.summarizeBed(100 + bed, "ICU-A", endTime - 3600, endTime);
+            assert(serial.readingCount == summary.readingCount);
+            assert(serial.abnormalCount == summary.abnormalCount);
+        }
+        cout << "✓ 8 beds summarized in one call, in request order" << endl;
+        
+        assert(beds[5].abnormalCount == 20);
+        assert(beds[5].abnormalFlags == FLAG_SPO2_LOW && beds[5].latestFlags == FLAG_SPO2_LOW);
+        assert(beds[5].getStats(FIELD_SPO2).min == 88);
+        assert(beds[0].abnormalCount == 0);
+        cout << "✓ Hypoxic bed reports 20 abnormal readings" << endl;
+        
+        // Ward thresholds apply per bed
+        VitalThresholds copdWard;
+        copdWard.spo2Low = 88;
+        scanner.setWardThresholds("Respiratory", copdWard);
+        assert(aggregator.summarizeBed(105, "Respiratory", endTime - 3600, endTime).abnormalCount == 0);
+        cout << "✓ Abnormal counts follow ward thresholds" << endl;
+        
+        BedSummary empty = aggregator.summarizeBed(999, "ICU-A", endTime - 3600, endTime);
+        assert(empty.readingCount == 0 && !empty.hasLatest);
+        cout << "✓ Bed with no readings summarized as empty" << endl;
+    }
+    
+    cleanupFiles(testPath);
+    cout << "\n✅ Test 2 Passed!" << endl;
+}
+
+int main() {
+    cout << "╔══════════════════════════════════════════════════════╗" << endl;
+    cout << "║   WARD AGGREGATION TEST SUITE                       ║" << endl;
+    cout << "║   IntelliCare ICU - Ward Overview                   ║" << endl;
+    cout << "╚══════════════════════════════════════════════════════╝" << endl;
+    
+    test1_ThreadPool();
+    test2_WardSummary();
+    
+    cout << "\n\n╔══════════════════════════════════════════════════════╗" << endl;
+    cout << "║    ALL TESTS PASSED SUCCESSFULLY!                 ║" << endl;
+    cout << "╚══════════════════════════════════════════════════════╝" << endl;
+    
+    return 0;
+}
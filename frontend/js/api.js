@@ -42,6 +42,11 @@ class ICU_API {
         return await this.request(`/api/patient/${patientId}`);
     }
 
+    // NEWS2 early warning score with the most recent history
+    async getPatientScore(patientId, history = 20) {
+        return await this.request(`/api/patient/${patientId}/score?history=${history}`);
+    }
+
     async addPatient(patientData) {
         return await this.request('/api/patient', {
             method: 'POST',
@@ -50,14 +55,49 @@ class ICU_API {
     }
 
     // Vital signs operations
-    async getVitals(patientId, startTime, endTime) {
+    // options.fields: e.g. 'heart_rate,spo2'; options.where: e.g. 'spo2<92';
+    // options.last: only the N most recent readings;
+    // options.points: chart series of at most N points per vital
+    async getVitals(patientId, startTime, endTime, options = {}) {
+        const params = [];
+        if (startTime && endTime) {
+            params.push(`start=${startTime}`, `end=${endTime}`);
+        }
+        if (options.fields) params.push(`fields=${encodeURIComponent(options.fields)}`);
+        if (options.where) params.push(`where=${encodeURIComponent(options.where)}`);
+        if (options.last) params.push(`last=${options.last}`);
+        if (options.points) params.push(`points=${options.points}`);
+
         let endpoint = `/api/vitals/${patientId}`;
+        if (params.length > 0) {
+            endpoint += `?${params.join('&')}`;
+        }
+        return await this.request(endpoint);
+    }
+
+    // Ward-wide search, e.g. queryVitals('spo2<90', start, end)
+    async queryVitals(where, startTime, endTime) {
+        let endpoint = `/api/vitals/query?where=${encodeURIComponent(where)}`;
+        if (startTime && endTime) {
+            endpoint += `&start=${startTime}&end=${endTime}`;
+        }
+        return await this.request(endpoint);
+    }
+
+    // Min/max/mean of each vital over the window
+    async getVitalsSummary(patientId, startTime, endTime) {
+        let endpoint = `/api/vitals/${patientId}/summary`;
         if (startTime && endTime) {
             endpoint += `?start=${startTime}&end=${endTime}`;
         }
         return await this.request(endpoint);
     }
 
+    // Rolling 5/15/60 minute statistics maintained on ingest
+    async getVitalsTrends(patientId) {
+        return await this.request(`/api/vitals/${patientId}/trends`);
+    }
+
     async addVitals(vitalData) {
         return await this.request('/api/vitals', {
             method: 'POST',
@@ -65,17 +105,81 @@ class ICU_API {
         });
     }
 
+    // Re-check stored readings against current thresholds
+    async scanVitals(patientId, startTime, endTime) {
+        let endpoint = `/api/vitals/${patientId}/scan`;
+        if (startTime && endTime) {
+            endpoint += `?start=${startTime}&end=${endTime}`;
+        }
+        return await this.request(endpoint, { method: 'POST' });
+    }
+
+    // Alert thresholds: scope is 'patient' or 'ward'
+    async getThresholds(scope, id) {
+        return await this.request(`/api/thresholds/${scope}/${encodeURIComponent(id)}`);
+    }
+
+    async setThresholds(scope, id, thresholds) {
+        return await this.request(`/api/thresholds/${scope}/${encodeURIComponent(id)}`, {
+            method: 'PUT',
+            body: JSON.stringify(thresholds)
+        });
+    }
+
+    // Every bed in a ward in one round trip (default window: last hour)
+    async getWardSummary(ward, startTime, endTime) {
+        let endpoint = `/api/ward/${encodeURIComponent(ward)}/summary`;
+        if (startTime && endTime) {
+            endpoint += `?start=${startTime}&end=${endTime}`;
+        }
+        return await this.request(endpoint);
+    }
+
     // Alert operations
     async getAllAlerts() {
         return await this.request('/api/alerts');
     }
 
+    // One page in priority order; options: limit, offset, minPriority,
+    // unacknowledged, patientID, ward, type, cursor (nextCursor from the
+    // previous page)
+    async getAlerts(options = {}) {
+        const params = new URLSearchParams();
+        for (const [key, value] of Object.entries(options)) {
+            if (value !== undefined && value !== null) params.append(key, value);
+        }
+        const query = params.toString();
+        return await this.request(query ? `/api/alerts?${query}` : '/api/alerts');
+    }
+
+    async getTopAlert() {
+        return await this.request('/api/alerts/top');
+    }
+
     async createAlert(alertData) {
         return await this.request('/api/alert', {
             method: 'POST',
             body: JSON.stringify(alertData)
         });
     }
+
+    async acknowledgeAlert(alertId, acknowledgedBy) {
+        return await this.request(`/api/alert/${alertId}/ack`, {
+            method: 'PUT',
+            body: JSON.stringify({ acknowledgedBy })
+        });
+    }
+
+    async updateAlertPriority(alertId, priority) {
+        return await this.request(`/api/alert/${alertId}/priority`, {
+            method: 'PUT',
+            body: JSON.stringify({ priority })
+        });
+    }
+
+    async deleteAlert(alertId) {
+        return await this.request(`/api/alert/${alertId}`, { method: 'DELETE' });
+    }
 }
 
 // Initialize API instance
@@ -95,7 +95,8 @@ async function loadAlerts() {
     const alertsList = document.getElementById('alertsList');
     
     try {
-        const response = await api.getAllAlerts();
+        // Only the top 5 are shown, so only they are fetched
+        const response = await api.getAlerts({ limit: 5 });
         
         if (response.status === 'success' && response.alerts) {
             currentAlerts = response.alerts;
@@ -105,10 +106,7 @@ async function loadAlerts() {
                 return;
             }
             
-            // Show only top 5 most critical
-            const topAlerts = currentAlerts.slice(0, 5);
-            
-            alertsList.innerHTML = topAlerts.map(alert => {
+            alertsList.innerHTML = currentAlerts.map(alert => {
                 const priority = ALERT_PRIORITY[alert.priority] || ALERT_PRIORITY[5];
                 const date = new Date(alert.timestamp * 1000).toLocaleString();
                 
@@ -123,14 +121,16 @@ async function loadAlerts() {
                                 <strong>Patient ${alert.patientID}:</strong> ${alert.message}
                             </div>
                             <div class="alert-meta">
-                                ${date}
+                                ${date}${alert.occurrenceCount > 1
+                                    ? ` · repeated ${alert.occurrenceCount}×, last ${new Date(alert.lastSeenTime * 1000).toLocaleTimeString()}`
+                                    : ''}
                             </div>
                         </div>
                     </div>
                 `;
             }).join('');
             
-            console.log(`✅ Loaded ${currentAlerts.length} alerts`);
+            console.log(`✅ Loaded ${currentAlerts.length} of ${response.total} alerts`);
         }
     } catch (error) {
         console.error('❌ Error loading alerts:', error);